@@ -20,6 +20,8 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/BJetEfficiencyCorrector.h"
+#include "xAODAnaHelpers/ScaleFactorCache.h"
+#include "xAODAnaHelpers/ScaleFactorTable.h"
 
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
@@ -36,7 +38,10 @@ ClassImp(BJetEfficiencyCorrector)
 BJetEfficiencyCorrector :: BJetEfficiencyCorrector (std::string className) :
     Algorithm(className),
     m_BJetSelectTool(nullptr),
-    m_BJetEffSFTool(nullptr)
+    m_BJetEffSFTool(nullptr),
+    m_SFCache(nullptr),
+    m_nSFCacheHits(0),
+    m_nSFCacheMismatches(0)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -73,6 +78,16 @@ BJetEfficiencyCorrector :: BJetEfficiencyCorrector (std::string className) :
   m_decor                   = "BTag";
   m_decorSF                 = ""; // gets set below after configure is called
 
+  // SF tables
+  m_writeSFTable            = false;
+
+  // SF memoization
+  m_useSFCache              = false;
+  m_SFCacheSize             = 10000;
+  m_SFCacheVerify           = 0;
+  m_SFCachePtBins           = "";
+  m_SFCacheEtaBins          = "";
+
 }
 
 
@@ -109,6 +124,20 @@ EL::StatusCode  BJetEfficiencyCorrector :: configure ()
 
     m_decor                   = config->GetValue("DecorationName", m_decor.c_str());
 
+    //
+    // SF tables
+    //
+    m_writeSFTable            = config->GetValue("WriteSFTable"   , m_writeSFTable);
+
+    //
+    // SF memoization
+    //
+    m_useSFCache              = config->GetValue("UseSFCache"     , m_useSFCache);
+    m_SFCacheSize             = config->GetValue("SFCacheSize"    , m_SFCacheSize);
+    m_SFCacheVerify           = config->GetValue("SFCacheVerify"  , m_SFCacheVerify);
+    m_SFCachePtBins           = config->GetValue("SFCachePtBins"  , m_SFCachePtBins.c_str());
+    m_SFCacheEtaBins          = config->GetValue("SFCacheEtaBins" , m_SFCacheEtaBins.c_str());
+
     config->Print();
     Info("configure()", "BJetEfficiencyCorrector Interface succesfully configured! ");
 
@@ -346,6 +375,14 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
     Info("initialize()"," Running w/ All systematics");
   }
 
+  if ( m_useSFCache && m_getScaleFactors ) {
+    if ( m_SFCachePtBins.empty() || m_SFCacheEtaBins.empty() ) {
+      Error("initialize()", "UseSFCache requires the pT and eta bin edges of the CDI calibration (SFCachePtBins, SFCacheEtaBins). Exiting" );
+      return EL::StatusCode::FAILURE;
+    }
+    m_SFCache = new ScaleFactorCache( m_name, m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins );
+  }
+
   Info("initialize()", "BJetEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -366,10 +403,13 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
 
   if ( m_debug ) Info("execute()", "\n\n eventNumber: %lld\n", eventInfo->eventNumber() );
 
-  //Create Scale Factor aux for all jets
+  //Create Scale Factor aux for all jets - or store all the SFs in a single table (see ScaleFactorTable)
   SG::AuxElement::Decorator< std::vector<float> > sfVec( m_decorSF );
-  for( auto jet_itr : *(correctedJets)) {
-      sfVec(*jet_itr) = std::vector<float>();
+  ScaleFactorTable* sfTable = ( m_writeSFTable ) ? new ScaleFactorTable( correctedJets, m_runAllSyst ? m_systList.size() : 1 ) : nullptr;
+  if ( !sfTable ) {
+    for( auto jet_itr : *(correctedJets)) {
+        sfVec(*jet_itr) = std::vector<float>();
+    }
   }
 
   // Define also an *event* weight, which is the product of all the BTag eff. SFs for each object in the event
@@ -378,6 +418,12 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
   SG::AuxElement::Decorator< std::vector<float> > sfVec_GLOBAL ( SF_NAME_GLOBAL );
 
   std::vector< std::string >* sysVariationNames = new std::vector< std::string >;
+
+  // truth flavour labels, to build the key of the SF cache
+  static SG::AuxElement::ConstAccessor<int> hadConeExclTruthLabel("HadronConeExclTruthLabelID");
+  static SG::AuxElement::ConstAccessor<int> coneTruthLabel("ConeTruthLabelID");
+  static SG::AuxElement::ConstAccessor<int> truthLabel("TruthLabelID");
+
   // loop over available systematics
   for(const auto& syst_it : m_systList){
 
@@ -402,6 +448,7 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
     //
     if ( m_debug ) Info("execute()", "systematic variation name is: %s", syst_it.name().c_str());
     sysVariationNames->push_back(syst_it.name());
+    const unsigned int systIdx = sysVariationNames->size() - 1;
 
     //
     // configure tool with syst variation
@@ -440,13 +487,44 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
       // if only decorator with decision because OP is not calibrated, set SF to 1
       if ( m_getScaleFactors && fabs(jet_itr->eta()) < 2.5 ) {
 
+        // the efficiency SF of a tagged jet depends on its bin and truth flavour only. The inefficiency SF of the other jets
+        // also depends on the MC efficiency, which is not binned like the SFs: they are never cached
+        ScaleFactorCache::Key sfKey;
+        const bool useCache = ( m_SFCache && tagged );
+        if ( useCache ) {
+          int flavour = -1;
+          if ( m_coneFlavourLabel ) {
+            if      ( hadConeExclTruthLabel.isAvailable( *jet_itr ) ) { flavour = hadConeExclTruthLabel( *jet_itr ); }
+            else if ( coneTruthLabel.isAvailable( *jet_itr ) )        { flavour = coneTruthLabel( *jet_itr ); }
+          } else if ( truthLabel.isAvailable( *jet_itr ) )            { flavour = truthLabel( *jet_itr ); }
+          sfKey = m_SFCache->makeKey( syst_it.hash(), jet_itr->pt(), jet_itr->eta(), 0.0, flavour );
+        }
+
         CP::CorrectionCode BJetEffCode;
-        // if passes cut take the efficiency scale factor
-        // if failed cut take the inefficiency scale factor
-        if( tagged ) {
-          BJetEffCode = m_BJetEffSFTool->getScaleFactor( *jet_itr, SF );
+        if ( useCache && m_SFCache->get( sfKey, SF ) ) {
+          BJetEffCode = CP::CorrectionCode::Ok;
+          // check a sample of the hits against the tool: a mismatch means that the SFs are not constant within the cache bins
+          if ( m_SFCacheVerify > 0 && ( ++m_nSFCacheHits % m_SFCacheVerify ) == 0 ) {
+            float toolSF(1.0);
+            BJetEffCode = m_BJetEffSFTool->getScaleFactor( *jet_itr, toolSF );
+            if ( BJetEffCode == CP::CorrectionCode::Ok && fabs( toolSF - SF ) > 1e-6 * fabs( toolSF ) ) {
+              if ( m_nSFCacheMismatches++ == 0 ) {
+                Warning("execute()", "Cached SF %f differs from the SF of the tool %f (jet pT %f GeV, eta %f, systematic %s): the SFCachePtBins/SFCacheEtaBins do not match the CDI calibration, or the CDI is smoothed. Using the SFs of the tool",
+                        SF, toolSF, jet_itr->pt() * 1e-3, jet_itr->eta(), syst_it.name().c_str());
+              }
+              m_SFCache->put( sfKey, toolSF );
+            }
+            SF = toolSF;
+          }
         } else {
-          BJetEffCode = m_BJetEffSFTool->getInefficiencyScaleFactor( *jet_itr, SF );
+          // if passes cut take the efficiency scale factor
+          // if failed cut take the inefficiency scale factor
+          if( tagged ) {
+            BJetEffCode = m_BJetEffSFTool->getScaleFactor( *jet_itr, SF );
+          } else {
+            BJetEffCode = m_BJetEffSFTool->getInefficiencyScaleFactor( *jet_itr, SF );
+          }
+          if ( useCache && BJetEffCode == CP::CorrectionCode::Ok ) { m_SFCache->put( sfKey, SF ); }
         }
         if (BJetEffCode == CP::CorrectionCode::Error){
           Warning( "execute()", "Error in getEfficiencyScaleFactor");
@@ -458,7 +536,7 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
       }//m_getScaleFacots && eta < 2.5
 
       // Add it to vector
-      sfVec(*jet_itr).push_back(SF);
+      if ( sfTable ) { sfTable->set( *jet_itr, systIdx, SF ); } else { sfVec(*jet_itr).push_back(SF); }
 
       SF_GLOBAL *= SF;
 
@@ -487,7 +565,7 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
          Info( "execute()", "Systematic: %s", syst_it.name().c_str() );
          Info( "execute()", " ");
          Info( "execute()", "BTag SF:");
-         Info( "execute()", "\t from tool = %f, from object = %f", SF, sfVec(*jet_itr).back());
+         Info( "execute()", "\t from tool = %f, from object = %f", SF, ( sfTable ) ? sfTable->get( *jet_itr, systIdx ) : sfVec(*jet_itr).back());
          Info( "execute()", "--------------------------------------");
        }
 
@@ -503,6 +581,7 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
        Info( "execute()", "--------------------------------------");
     }
     sfVec_GLOBAL( *eventInfo ).push_back( SF_GLOBAL );
+    if ( sfTable ) { sfTable->setGlobal( systIdx, SF_GLOBAL ); }
 
   } // close loop on systematics
 
@@ -511,6 +590,13 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
   //
   RETURN_CHECK( "BJetEfficiencyCorrector::execute()", m_store->record( sysVariationNames, m_outputSystName), "Failed to record vector of systematic names.");
 
+  //
+  // add the SF table to TStore
+  //
+  if ( sfTable ) {
+    RETURN_CHECK( "BJetEfficiencyCorrector::execute()", m_store->record( sfTable, m_decorSF + "_Table" ), "Failed to record SF table.");
+  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -529,6 +615,13 @@ EL::StatusCode BJetEfficiencyCorrector :: finalize ()
   if(m_BJetEffSFTool){
     delete m_BJetEffSFTool; m_BJetEffSFTool = nullptr;
   }
+  if ( m_SFCache ) {
+    m_SFCache->printStats();
+    if ( m_SFCacheVerify > 0 ) {
+      Info("finalize()", "%u cached SFs checked against the tool, %u differed", m_nSFCacheHits / m_SFCacheVerify, m_nSFCacheMismatches);
+    }
+    delete m_SFCache; m_SFCache = nullptr;
+  }
   return EL::StatusCode::SUCCESS;
 }
 
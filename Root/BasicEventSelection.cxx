@@ -39,6 +39,10 @@
 #include "TTreeFormula.h"
 #include "TSystem.h"
 
+// c++ include(s):
+#include <algorithm>
+#include <sstream>
+
 
 // this is needed to distribute the algorithm to the workers
 ClassImp(BasicEventSelection)
@@ -50,6 +54,10 @@ BasicEventSelection :: BasicEventSelection (std::string className) :
     m_pileuptool(nullptr),
     m_trigConfTool(nullptr),
     m_trigDecTool(nullptr),
+    m_branchFilter(nullptr),
+    m_prefetcher(nullptr),
+    m_preFilterList(nullptr),
+    m_preFilterReady(false),
     m_histEventCount(nullptr),
     m_cutflowHist(nullptr),
     m_cutflowHistW(nullptr),
@@ -81,6 +89,17 @@ BasicEventSelection :: BasicEventSelection (std::string className) :
   // Metadata
   m_useMetaData = true;
 
+  // Input I/O
+  m_readLearnEntries      = 0;
+  m_readBranchesFile      = "";
+  m_readBranchesOutput    = "";
+  m_disableUnreadBranches = false;
+  m_readCacheSizeMB       = 0;
+  m_preFilter             = false;
+  m_prefetchNextFile      = false;
+  m_prefetchHeadMB        = 64;
+  m_prefetchTailMB        = 16;
+
   // Check for duplicated events in Data and MC
   m_checkDuplicatesData = false;
   m_checkDuplicatesMC	= false;
@@ -144,6 +163,17 @@ EL::StatusCode BasicEventSelection :: configure ()
     // temp flag for derivations with broken meta data
     m_useMetaData       = config->GetValue("UseMetaData", m_useMetaData);
 
+    // Input I/O
+    m_readLearnEntries      = config->GetValue("ReadLearnEntries",      m_readLearnEntries);
+    m_readBranchesFile      = config->GetValue("ReadBranchesFile",      m_readBranchesFile.c_str());
+    m_readBranchesOutput    = config->GetValue("ReadBranchesOutput",    m_readBranchesOutput.c_str());
+    m_disableUnreadBranches = config->GetValue("DisableUnreadBranches", m_disableUnreadBranches);
+    m_readCacheSizeMB       = config->GetValue("ReadCacheSizeMB",       m_readCacheSizeMB);
+    m_preFilter             = config->GetValue("PreFilter",             m_preFilter);
+    m_prefetchNextFile      = config->GetValue("PrefetchNextFile",      m_prefetchNextFile);
+    m_prefetchHeadMB        = config->GetValue("PrefetchHeadMB",        m_prefetchHeadMB);
+    m_prefetchTailMB        = config->GetValue("PrefetchTailMB",        m_prefetchTailMB);
+
     // Check for duplicated events in Data and MC
     m_checkDuplicatesData = config->GetValue("CheckDuplicatesData", m_checkDuplicatesData);
     m_checkDuplicatesMC   = config->GetValue("CheckDuplicatesMC", m_checkDuplicatesMC);
@@ -290,6 +320,21 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
+  // warm the next input file while this one is processed. The list of files is set by xAH_run.py
+  //
+  if ( m_prefetchNextFile ) {
+    if ( !m_prefetcher ) {
+      std::vector<std::string> files;
+      std::istringstream inputFiles( wk()->metaData()->castString("xAH_inputFiles", "") );
+      for ( std::string file; std::getline( inputFiles, file ); ) {
+        if ( !file.empty() ) { files.push_back( file ); }
+      }
+      if ( files.empty() ) { Warning("fileExecute()", "PrefetchNextFile: the list of input files (xAH_inputFiles) is not set, nothing to prefetch"); }
+      m_prefetcher = new InputPrefetcher( files, static_cast<Long64_t>(m_prefetchHeadMB) * 1024 * 1024, static_cast<Long64_t>(m_prefetchTailMB) * 1024 * 1024 );
+    }
+    m_prefetcher->prefetchNext( wk()->inputFile()->GetName() );
+  }
+
   //---------------------------
   // Meta data - CutBookkepers
   //---------------------------
@@ -393,6 +438,22 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
     }
   }
 
+  // When the input files are split into event ranges (see the local driver of xAH_run.py), several jobs read this file:
+  // the driver sets xAH_eventRanges in all of them but one, which counts its meta data
+  //
+  if ( wk()->metaData()->castBool("xAH_eventRanges", false) ) {
+    Info("fileExecute()", "Meta data of %s counted by another job reading it", wk()->inputFile()->GetName());
+    return EL::StatusCode::SUCCESS;
+  }
+
+  this->countMetaData();
+
+  return EL::StatusCode::SUCCESS;
+
+}
+
+void BasicEventSelection :: countMetaData ()
+{
   // Write metadata event bookkeepers to histogram
   //
   Info("histInitialize()", "Meta data from this file:");
@@ -409,9 +470,6 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
   m_histEventCount -> Fill(4, m_MD_finalSumW);
   m_histEventCount -> Fill(5, m_MD_initialSumWSquared);
   m_histEventCount -> Fill(6, m_MD_finalSumWSquared);
-
-  return EL::StatusCode::SUCCESS;
-
 }
 
 EL::StatusCode BasicEventSelection :: changeInput (bool /*firstFile*/)
@@ -419,6 +477,14 @@ EL::StatusCode BasicEventSelection :: changeInput (bool /*firstFile*/)
   // Here you do everything you need to do when we change input files,
   // e.g. resetting branch addresses on trees.  If you are using
   // D3PDReader or a similar service this method is not needed.
+
+  // the branch status and the cache belong to the tree of each file
+  // (for the first file, this is done in initialize())
+  if ( m_branchFilter ) { m_branchFilter->apply( wk()->tree() ); }
+
+  // the new file is scanned at its first event, once the tools are initialized
+  m_preFilterReady = false;
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -623,6 +689,16 @@ EL::StatusCode BasicEventSelection :: initialize ()
   // count number of events
   m_eventCounter   = 0;
 
+  // restrict the input reads to the branches actually used
+  //
+  if ( m_readLearnEntries > 0 || !m_readBranchesFile.empty() ) {
+    m_branchFilter = new InputBranchFilter( m_readLearnEntries, m_disableUnreadBranches, static_cast<Long64_t>(m_readCacheSizeMB) * 1024 * 1024 );
+    if ( !m_readBranchesFile.empty() ) {
+      RETURN_CHECK("BasicEventSelection::initialize()", m_branchFilter->readList( m_readBranchesFile ), "");
+      m_branchFilter->apply( wk()->tree() );
+    }
+  }
+
   Info("initialize()", "BasicEventSelection succesfully initialized!");
 
   return EL::StatusCode::SUCCESS;
@@ -639,6 +715,21 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   if( m_debug ) { Info("execute()", "Basic Event Selection"); }
 
+  // the reads of all the algorithms in the previous events are visible here
+  if ( m_branchFilter && m_branchFilter->isLearning() && m_branchFilter->learn( wk()->tree() ) ) {
+    m_branchFilter->print();
+    if ( !m_readBranchesOutput.empty() ) {
+      RETURN_CHECK("BasicEventSelection::execute()", m_branchFilter->writeList( m_readBranchesOutput ), "");
+    }
+  }
+  if ( m_branchFilter ) {
+    RETURN_CHECK("BasicEventSelection::execute()", m_branchFilter->check( wk()->tree() ), "");
+  }
+
+  if ( m_preFilter && !m_preFilterReady ) {
+    RETURN_CHECK("BasicEventSelection::execute()", this->preFilterFile(), "");
+  }
+
   //------------------
   // Event information
   //------------------
@@ -874,12 +965,94 @@ EL::StatusCode BasicEventSelection :: execute ()
   return EL::StatusCode::SUCCESS;
 }
 
+bool BasicEventSelection :: passPreFilter ( const xAOD::EventInfo* eventInfo )
+{
+  // a looser version of the cuts of execute(): an entry failing here would fail there too
+
+  if ( !m_isMC ) {
+    if ( m_applyGRLCut && !m_grl->passRunLB( *eventInfo ) ) { return false; }
+    if ( m_applyEventCleaningCut && ( eventInfo->errorState(xAOD::EventInfo::LAr)  == xAOD::EventInfo::Error ||
+                                      eventInfo->errorState(xAOD::EventInfo::Tile) == xAOD::EventInfo::Error ||
+                                      eventInfo->errorState(xAOD::EventInfo::SCT)  == xAOD::EventInfo::Error ) ) { return false; }
+    if ( m_applyCoreFlagsCut && eventInfo->isEventFlagBitSet(xAOD::EventInfo::Core, 18) ) { return false; }
+  }
+
+  if ( !m_truthLevelOnly && m_applyPrimaryVertexCut ) {
+    const xAOD::VertexContainer* vertices(nullptr);
+    // if missing, keep the entry and let execute() report it
+    if ( !HelperFunctions::retrieve(vertices, m_vertexContainerName, m_event, m_store).isSuccess() ) { return true; }
+    if ( !HelperFunctions::passPrimaryVertexSelection( vertices, m_PVNTrack ) ) { return false; }
+  }
+
+  if ( !m_triggerSelection.empty() && m_applyTriggerCut && !m_trigDecTool->getChainGroup(m_triggerSelection)->isPassed() ) { return false; }
+
+  return true;
+}
+
+EL::StatusCode BasicEventSelection :: preFilterFile ()
+{
+  // The events failing the cuts are rejected by execute() before any other algorithm runs, so their heavy containers are never retrieved.
+  // But the TTreeCache would still prefetch (and ROOT decompress) the baskets of all the entries: with the passing entries as the entry list
+  // of the tree, the cache skips the baskets without any of them.
+
+  TTree* tree = wk()->tree();
+  const Long64_t currentEntry = wk()->treeEntry();
+
+  // otherwise the scan would train the TTreeCache on the light branches only
+  const Long64_t cacheSize = tree->GetCacheSize();
+  tree->SetCacheSize( 0 );
+
+  if ( m_preFilterList ) { delete m_preFilterList; }
+  m_preFilterList = new TEntryList( "preFilter", "entries passing the pre-filter", tree );
+  m_preFilterList->SetDirectory( nullptr );
+
+  // only the entries this job will process: from the current one (the first of the file after the skipped ones) to the last one allowed by the
+  // maximum number of events of the job, which is set per event range by the local driver. The entries not scanned are not processed anyway
+  const Long64_t firstEntry = currentEntry;
+  Long64_t lastEntry = tree->GetEntries();
+  const double maxEvents = wk()->metaData()->castDouble( EL::Job::optMaxEvents, -1 );
+  if ( maxEvents >= 0 ) {
+    lastEntry = std::min( lastEntry, firstEntry + std::max<Long64_t>( static_cast<Long64_t>( maxEvents ) - m_eventCounter, 1 ) );
+  }
+
+  for ( Long64_t entry = firstEntry; entry < lastEntry; ++entry ) {
+    if ( m_event->getEntry( entry ) < 0 ) {
+      Error("preFilterFile()", "Failed to read entry %lli", entry);
+      return EL::StatusCode::FAILURE;
+    }
+    const xAOD::EventInfo* eventInfo(nullptr);
+    RETURN_CHECK("BasicEventSelection::preFilterFile()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
+    if ( this->passPreFilter( eventInfo ) ) { m_preFilterList->Enter( entry ); }
+  }
+
+  // back to the event being processed
+  if ( m_event->getEntry( currentEntry ) < 0 ) {
+    Error("preFilterFile()", "Failed to read entry %lli", currentEntry);
+    return EL::StatusCode::FAILURE;
+  }
+
+  tree->SetCacheSize( cacheSize );
+  tree->SetEntryList( m_preFilterList );
+  if ( m_branchFilter ) { m_branchFilter->apply( tree ); }
+
+  Info("preFilterFile()", "%lli / %lli entries of %s (%lli to %lli) pass the pre-filter", m_preFilterList->GetN(), lastEntry - firstEntry, wk()->inputFile()->GetName(), firstEntry, lastEntry - 1);
+
+  m_preFilterReady = true;
+
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode BasicEventSelection :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
 
+  // the tree changes after the last entry, so record what was read in it now
+  if ( m_branchFilter && m_branchFilter->isLearning() && wk()->treeEntry() + 1 == wk()->tree()->GetEntries() ) {
+    m_branchFilter->learn( wk()->tree(), false );
+  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -901,10 +1074,24 @@ EL::StatusCode BasicEventSelection :: finalize ()
 
   m_RunNr_VS_EvtNr.clear();
 
-  if ( m_grl )          {  m_grl = nullptr;	     delete m_grl; }
-  if ( m_pileuptool )   {  m_pileuptool = nullptr;   delete m_pileuptool; }
-  if ( m_trigDecTool )  {  m_trigDecTool = nullptr;  delete m_trigDecTool; }
-  if ( m_trigConfTool ) {  m_trigConfTool = nullptr; delete m_trigConfTool; }
+  // the job was shorter than the learning phase
+  if ( m_branchFilter && m_branchFilter->isLearning() ) {
+    m_branchFilter->learn( wk()->tree(), false );
+    m_branchFilter->print();
+    if ( !m_readBranchesOutput.empty() ) {
+      RETURN_CHECK("BasicEventSelection::finalize()", m_branchFilter->writeList( m_readBranchesOutput ), "");
+    }
+  }
+  if ( m_branchFilter ) { delete m_branchFilter; m_branchFilter = nullptr; }
+  if ( m_preFilterList ) {
+    if ( wk()->tree() && wk()->tree()->GetEntryList() == m_preFilterList ) { wk()->tree()->SetEntryList( nullptr ); }
+    delete m_preFilterList; m_preFilterList = nullptr;
+  }
+
+  if ( m_grl )          { delete m_grl;          m_grl = nullptr;          }
+  if ( m_pileuptool )   { delete m_pileuptool;   m_pileuptool = nullptr;   }
+  if ( m_trigDecTool )  { delete m_trigDecTool;  m_trigDecTool = nullptr;  }
+  if ( m_trigConfTool ) { delete m_trigConfTool; m_trigConfTool = nullptr; }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -923,6 +1110,8 @@ EL::StatusCode BasicEventSelection :: histFinalize ()
   // outputs have been merged.  This is different from finalize() in
   // that it gets called on all worker nodes regardless of whether
   // they processed input events.
+  if ( m_prefetcher ) { delete m_prefetcher; m_prefetcher = nullptr; }
+
   RETURN_CHECK("xAH::Algorithm::algFinalize()", xAH::Algorithm::algFinalize(), "");
   return EL::StatusCode::SUCCESS;
 }
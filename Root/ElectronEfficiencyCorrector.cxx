@@ -8,6 +8,7 @@
 
 // c++ include(s):
 #include <iostream>
+#include <cmath>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -28,6 +29,8 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/ElectronEfficiencyCorrector.h"
+#include "xAODAnaHelpers/ScaleFactorCache.h"
+#include "xAODAnaHelpers/ScaleFactorTable.h"
 
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
@@ -45,7 +48,10 @@ ElectronEfficiencyCorrector :: ElectronEfficiencyCorrector (std::string classNam
     Algorithm(className),
     m_asgElEffCorrTool_elSF_PID(nullptr),
     m_asgElEffCorrTool_elSF_Reco(nullptr),
-    m_asgElEffCorrTool_elSF_Trig(nullptr)
+    m_asgElEffCorrTool_elSF_Trig(nullptr),
+    m_SFCachePID(nullptr),
+    m_SFCacheReco(nullptr),
+    m_SFCacheTrig(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -80,6 +86,17 @@ ElectronEfficiencyCorrector :: ElectronEfficiencyCorrector (std::string classNam
   m_corrFileNamePID         = "";
   m_corrFileNameReco        = "";
   m_corrFileNameTrig        = "";
+
+  // SF tables
+  //
+  m_writeSFTable            = false;
+
+  // SF memoization
+  //
+  m_useSFCache              = false;
+  m_SFCacheSize             = 10000;
+  m_SFCachePtBins           = "";
+  m_SFCacheEtaBins          = "";
 }
 
 
@@ -116,6 +133,14 @@ EL::StatusCode  ElectronEfficiencyCorrector :: configure ()
     m_corrFileNamePID         = config->GetValue("CorrectionFileNamePID" , m_corrFileNamePID.c_str());
     m_corrFileNameReco        = config->GetValue("CorrectionFileNameReco" , m_corrFileNameReco.c_str());
     m_corrFileNameTrig        = config->GetValue("CorrectionFileNameTrig" , m_corrFileNameTrig.c_str());
+    // SF tables
+    m_writeSFTable            = config->GetValue("WriteSFTable"   , m_writeSFTable);
+
+    // SF memoization
+    m_useSFCache              = config->GetValue("UseSFCache"     , m_useSFCache);
+    m_SFCacheSize             = config->GetValue("SFCacheSize"    , m_SFCacheSize);
+    m_SFCachePtBins           = config->GetValue("SFCachePtBins"  , m_SFCachePtBins.c_str());
+    m_SFCacheEtaBins          = config->GetValue("SFCacheEtaBins" , m_SFCacheEtaBins.c_str());
 
     config->Print();
 
@@ -366,6 +391,20 @@ EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
 
   // *********************************************************************************
 
+  // Initialise SF caches, one per tool
+  //
+  if ( m_useSFCache ) {
+    if ( m_SFCachePtBins.empty() || m_SFCacheEtaBins.empty() ) {
+      Error("initialize()", "UseSFCache requires the Et and eta bin edges of the SF maps (SFCachePtBins, SFCacheEtaBins). Exiting" );
+      return EL::StatusCode::FAILURE;
+    }
+    m_SFCachePID  = new ScaleFactorCache( m_name + "_PID",  m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins );
+    m_SFCacheReco = new ScaleFactorCache( m_name + "_Reco", m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins );
+    m_SFCacheTrig = new ScaleFactorCache( m_name + "_Trig", m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins );
+  }
+
+  // *********************************************************************************
+
   Info("initialize()", "ElectronEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -484,6 +523,10 @@ EL::StatusCode ElectronEfficiencyCorrector :: finalize ()
   if ( m_asgElEffCorrTool_elSF_Reco ) {  m_asgElEffCorrTool_elSF_Reco = nullptr; delete m_asgElEffCorrTool_elSF_Reco; }
   if ( m_asgElEffCorrTool_elSF_Trig ) { m_asgElEffCorrTool_elSF_Trig = nullptr;  delete m_asgElEffCorrTool_elSF_Trig; }
 
+  if ( m_SFCachePID )  { m_SFCachePID->printStats();  delete m_SFCachePID;  m_SFCachePID = nullptr;  }
+  if ( m_SFCacheReco ) { m_SFCacheReco->printStats(); delete m_SFCacheReco; m_SFCacheReco = nullptr; }
+  if ( m_SFCacheTrig ) { m_SFCacheTrig->printStats(); delete m_SFCacheTrig; m_SFCacheTrig = nullptr; }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -524,6 +567,11 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
   std::vector< std::string >* sysVariationNamesReco = new std::vector< std::string >;
   std::vector< std::string >* sysVariationNamesTrig = new std::vector< std::string >;
 
+  // The SFs may depend on the data period: use the random run number assigned by the PRW tool, if any
+  //
+  static SG::AuxElement::ConstAccessor< unsigned int > randomRunNumberAcc("RandomRunNumber");
+  unsigned int runNumber = ( randomRunNumberAcc.isAvailable( *eventInfo ) ) ? randomRunNumberAcc( *eventInfo ) : eventInfo->runNumber();
+
   // 1.
   // PID efficiency SFs - this is a per-ELECTRON weight
   //
@@ -536,6 +584,10 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
   std::string PID_SF_NAME_GLOBAL = m_outputSystNamesPID + "_GLOBAL";
   SG::AuxElement::Decorator< std::vector<float> > sfVecPID_GLOBAL ( PID_SF_NAME_GLOBAL );
 
+  // Or store all the SFs in a single table (see ScaleFactorTable)
+  //
+  ScaleFactorTable* sfTablePID = ( m_writeSFTable ) ? new ScaleFactorTable( inputElectrons, m_systListPID.size() ) : nullptr;
+
   for ( const auto& syst_it : m_systListPID ) {
 
     // Initialise product of SFs for *this* systematic
@@ -553,6 +605,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
     }
     if(m_debug) Info("executeSF()", "Electron PID efficiency SF  name is: %s", sfName.c_str());
     sysVariationNamesPID->push_back(sfName);
+    const unsigned int systIdx = sysVariationNamesPID->size() - 1;
 
     // apply syst
     //
@@ -577,7 +630,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
        //
        SG::AuxElement::Decorator< std::vector<float> > sfVecPID ( m_outputSystNamesPID  );
-       if ( !sfVecPID.isAvailable( *el_itr )  ) {
+       if ( !sfTablePID && !sfVecPID.isAvailable( *el_itr )  ) {
          sfVecPID ( *el_itr ) = std::vector<float>();
        }
 
@@ -603,14 +656,14 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        // obtain efficiency SF's for PID
        //
        double pidEffSF(1.0); // tool wants a double
-       if ( !isBadElectron &&  m_asgElEffCorrTool_elSF_PID->getEfficiencyScaleFactor( *el_itr, pidEffSF ) != CP::CorrectionCode::Ok ) {
+       if ( !isBadElectron &&  this->getCachedSF( m_asgElEffCorrTool_elSF_PID, m_SFCachePID, syst_it, el_itr, runNumber, pidEffSF ) != CP::CorrectionCode::Ok ) {
          Warning( "executeSF()", "Problem in getEfficiencyScaleFactor");
 	 pidEffSF = 1.0;
        }
        //
        // Add it to decoration vector
        //
-       sfVecPID( *el_itr ).push_back( pidEffSF );
+       if ( sfTablePID ) { sfTablePID->set( *el_itr, systIdx, pidEffSF ); } else { sfVecPID( *el_itr ).push_back( pidEffSF ); }
 
        pidEffSF_GLOBAL *= pidEffSF;
 
@@ -641,6 +694,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        Info( "executeSF()", "--------------------------------------");
     }
     sfVecPID_GLOBAL( *eventInfo ).push_back( pidEffSF_GLOBAL );
+    if ( sfTablePID ) { sfTablePID->setGlobal( systIdx, pidEffSF_GLOBAL ); }
 
   }  // close loop on PID efficiency systematics
 
@@ -657,6 +711,10 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
   std::string RECO_SF_NAME_GLOBAL = m_outputSystNamesReco + "_GLOBAL";
   SG::AuxElement::Decorator< std::vector<float> > sfVecReco_GLOBAL ( RECO_SF_NAME_GLOBAL );
 
+  // Or store all the SFs in a single table (see ScaleFactorTable)
+  //
+  ScaleFactorTable* sfTableReco = ( m_writeSFTable ) ? new ScaleFactorTable( inputElectrons, m_systListReco.size() ) : nullptr;
+
   for ( const auto& syst_it : m_systListReco ) {
 
     // Initialise product of SFs for *this* systematic
@@ -674,6 +732,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
     }
     if(m_debug) Info("executeSF()", "Electron Reco efficiency SF decoration name is: %s", sfName.c_str());
     sysVariationNamesReco->push_back(sfName);
+    const unsigned int systIdx = sysVariationNamesReco->size() - 1;
 
     // apply syst
     //
@@ -698,7 +757,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
        //
        SG::AuxElement::Decorator< std::vector<float> > sfVecReco ( m_outputSystNamesReco  );
-       if ( !sfVecReco.isAvailable( *el_itr )  ) {
+       if ( !sfTableReco && !sfVecReco.isAvailable( *el_itr )  ) {
          sfVecReco ( *el_itr ) = std::vector<float>();
        }
 
@@ -724,14 +783,14 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        // obtain efficiency SF's for Reco
        //
        double recoEffSF(1.0); // tool wants a double
-       if ( !isBadElectron && m_asgElEffCorrTool_elSF_Reco->getEfficiencyScaleFactor( *el_itr, recoEffSF ) != CP::CorrectionCode::Ok ) {
+       if ( !isBadElectron && this->getCachedSF( m_asgElEffCorrTool_elSF_Reco, m_SFCacheReco, syst_it, el_itr, runNumber, recoEffSF ) != CP::CorrectionCode::Ok ) {
          Warning( "executeSF()", "Problem in getEfficiencyScaleFactor");
 	 recoEffSF = 1.0;
        }
        //
        // Add it to decoration vector
        //
-       sfVecReco( *el_itr ).push_back( recoEffSF );
+       if ( sfTableReco ) { sfTableReco->set( *el_itr, systIdx, recoEffSF ); } else { sfVecReco( *el_itr ).push_back( recoEffSF ); }
 
        recoEffSF_GLOBAL *= recoEffSF;
 
@@ -760,6 +819,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        Info( "executeSF()", "--------------------------------------");
     }
     sfVecReco_GLOBAL( *eventInfo ).push_back( recoEffSF_GLOBAL );
+    if ( sfTableReco ) { sfTableReco->setGlobal( systIdx, recoEffSF_GLOBAL ); }
 
   }  // close loop on Reco efficiency systematics
 
@@ -831,7 +891,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
        //
        // obtain efficiency SF for Trig
        //
-       if ( !isBadElectron && m_asgElEffCorrTool_elSF_Trig->getEfficiencyScaleFactor( *el_itr, trigSF ) != CP::CorrectionCode::Ok ) {
+       if ( !isBadElectron && this->getCachedSF( m_asgElEffCorrTool_elSF_Trig, m_SFCacheTrig, syst_it, el_itr, runNumber, trigSF ) != CP::CorrectionCode::Ok ) {
          Warning( "executeSF()", "Problem in getEfficiencyScaleFactor");
 	 isBadElectron = true;
 	 trigSF = 1.0;
@@ -876,5 +936,36 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
     if ( !m_store->contains<std::vector<std::string> >(m_outputSystNamesTrig) ) { RETURN_CHECK( "ElectronEfficiencyCorrector::executeSF()", m_store->record( sysVariationNamesTrig, m_outputSystNamesTrig), "Failed to record vector of systematic names Trig" ); }
   }
 
+  // Record the SF tables in TStore - one set per input container
+  //
+  if ( m_writeSFTable ) {
+    std::string tableSuffix = ( countSyst == 0 ) ? "_Table" : "_Table_" + std::to_string( countSyst );
+    if ( !m_store->contains<ScaleFactorTable>( m_outputSystNamesPID + tableSuffix ) ) { RETURN_CHECK( "ElectronEfficiencyCorrector::executeSF()", m_store->record( sfTablePID, m_outputSystNamesPID + tableSuffix ), "Failed to record PID SF table" ); } else { delete sfTablePID; }
+    if ( !m_store->contains<ScaleFactorTable>( m_outputSystNamesReco + tableSuffix ) ) { RETURN_CHECK( "ElectronEfficiencyCorrector::executeSF()", m_store->record( sfTableReco, m_outputSystNamesReco + tableSuffix ), "Failed to record Reco SF table" ); } else { delete sfTableReco; }
+  }
+
   return EL::StatusCode::SUCCESS;
 }
+
+CP::CorrectionCode ElectronEfficiencyCorrector :: getCachedSF ( AsgElectronEfficiencyCorrectionTool* tool, ScaleFactorCache* cache, const CP::SystematicSet& syst,
+                                                                const xAOD::Electron* el, unsigned int runNumber, double& sf )
+{
+  if ( !cache ) { return tool->getEfficiencyScaleFactor( *el, sf ); }
+
+  // the tool reads the SF maps at the cluster Et and eta
+  //
+  const xAOD::CaloCluster* cluster = el->caloCluster();
+  const float clusterEta = cluster->etaBE(2);
+  ScaleFactorCache::Key key = cache->makeKey( syst.hash(), cluster->e() / cosh( clusterEta ), clusterEta, 0.0, 0, runNumber );
+
+  float cachedSF(1.0);
+  if ( cache->get( key, cachedSF ) ) {
+    sf = cachedSF;
+    return CP::CorrectionCode::Ok;
+  }
+
+  CP::CorrectionCode code = tool->getEfficiencyScaleFactor( *el, sf );
+  if ( code == CP::CorrectionCode::Ok ) { cache->put( key, sf ); }
+
+  return code;
+}
@@ -32,6 +32,7 @@
 #include "ElectronPhotonSelectorTools/AsgElectronIsEMSelector.h"
 #include "TrigDecisionTool/TrigDecisionTool.h"
 #include "TrigEgammaMatchingTool/TrigEgammaMatchingTool.h"
+#include "xAODAnaHelpers/TrigMatchingEngine.h"
 #include "PATCore/TAccept.h"
 
 // ROOT include(s):
@@ -50,11 +51,15 @@ ElectronSelector :: ElectronSelector (std::string className) :
     m_cutflowHistW(nullptr),
     m_el_cutflowHist_1(nullptr),
     m_el_cutflowHist_2(nullptr),
+    m_MinIsoCutPosition(0),
     m_IsolationSelectionTool(nullptr),
     m_el_LH_PIDManager(nullptr),
     m_el_CutBased_PIDManager(nullptr),
+    m_LHPassBit(0),
+    m_CutBasedPassBit(0),
     m_trigDecTool(nullptr),
-    m_trigElMatchTool(nullptr)
+    m_trigElMatchTool(nullptr),
+    m_trigElMatchEngine(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -112,6 +117,7 @@ ElectronSelector :: ElectronSelector (std::string className) :
 
   m_readIDFlagsFromDerivation = false;
   m_confDirPID              = "mc15_20150224";
+  m_singlePassPID           = false;
 
   // likelihood-based PID
   m_doLHPIDcut              = false;
@@ -131,10 +137,13 @@ ElectronSelector :: ElectronSelector (std::string className) :
   m_TrackIsoEff             = "98";
   m_CaloBasedIsoType        = "topoetcone20";
   m_TrackBasedIsoType       = "ptvarcone20";
+  m_singlePassIso           = false;
 
   // trigger matching stuff
   //
   m_ElTrigChains            = "";
+  m_minDeltaR               = 0.07;
+  m_useTrigMatchingEngine   = false;
 
 }
 
@@ -176,6 +185,7 @@ EL::StatusCode  ElectronSelector :: configure ()
 
     m_readIDFlagsFromDerivation = config->GetValue("ReadIDFlagsFromDerivation", m_readIDFlagsFromDerivation);
     m_confDirPID              = config->GetValue("ConfDirPID", m_confDirPID.c_str());
+    m_singlePassPID           = config->GetValue("SinglePassPID", m_singlePassPID);
     m_doLHPIDcut              = config->GetValue("DoLHPIDCut", m_doLHPIDcut);
     m_LHOperatingPoint        = config->GetValue("LHOperatingPoint", m_LHOperatingPoint.c_str());
     m_LHConfigYear            = config->GetValue("LHConfigYear", m_LHConfigYear.c_str());
@@ -189,8 +199,11 @@ EL::StatusCode  ElectronSelector :: configure ()
     m_TrackIsoEff             = config->GetValue("TrackIsoEfficiency",  m_TrackIsoEff.c_str());
     m_CaloBasedIsoType        = config->GetValue("CaloBasedIsoType"  ,  m_CaloBasedIsoType.c_str());
     m_TrackBasedIsoType       = config->GetValue("TrackBasedIsoType" ,  m_TrackBasedIsoType.c_str());
+    m_singlePassIso           = config->GetValue("SinglePassIsolation", m_singlePassIso);
 
     m_ElTrigChains            = config->GetValue("ElTrigChains"      , m_ElTrigChains.c_str() );
+    m_minDeltaR               = config->GetValue("MinDeltaR"         , m_minDeltaR );
+    m_useTrigMatchingEngine   = config->GetValue("UseTrigMatchingEngine", m_useTrigMatchingEngine );
 
     config->Print();
 
@@ -441,6 +454,27 @@ EL::StatusCode ElectronSelector :: initialize ()
     RETURN_CHECK( "ElectronSelector::initialize()", m_el_LH_PIDManager->setupWPs( configTools_LH, this->m_name, confDir, m_LHConfigYear ), "Failed to properly setup ElectronLHPIDManager." );
   }
 
+  // find the selected WPs in the bitmask of the single-pass evaluation
+  //
+  if ( m_singlePassPID && !m_readIDFlagsFromDerivation ) {
+    if ( m_doLHPIDcut ) {
+      int LHIndex = m_el_LH_PIDManager->getValidWPIndex( m_LHOperatingPoint );
+      if ( LHIndex < 0 ) {
+        Error("initialize()", "Selected LH WP %s is not among the valid WPs of ElectronLHPIDManager. Exiting.", m_LHOperatingPoint.c_str() );
+        return EL::StatusCode::FAILURE;
+      }
+      m_LHPassBit = ( 1u << LHIndex );
+    }
+    if ( m_doCutBasedPIDcut ) {
+      int CutBasedIndex = m_el_CutBased_PIDManager->getValidWPIndex( m_CutBasedOperatingPoint );
+      if ( CutBasedIndex < 0 ) {
+        Error("initialize()", "Selected cut-based WP %s is not among the valid WPs of ElectronCutBasedPIDManager. Exiting.", m_CutBasedOperatingPoint.c_str() );
+        return EL::StatusCode::FAILURE;
+      }
+      m_CutBasedPassBit = ( 1u << CutBasedIndex );
+    }
+  }
+
   // *************************************
   //
   // Initialise CP::IsolationSelectionTool
@@ -566,6 +600,11 @@ EL::StatusCode ElectronSelector :: execute ()
     Info("execute()", "Input electron trigger chains that will be considered for matching:\n");
     for ( auto const &chain : m_ElTrigChainsList ) { Info("execute()", "\t %s", chain.c_str()); }
     Info("execute()", "\n");
+
+    if ( m_useTrigMatchingEngine ) {
+      Info("execute()", "Electron trigger matching will be done w/ TrigMatchingEngine - results in 'isTrigMatchedVecEl' decoration");
+      m_trigElMatchEngine = new TrigMatchingEngine( m_trigDecTool, TrigMatchingEngine::FeatureType::Electron, m_ElTrigChainsList, "isTrigMatchedVecEl", m_minDeltaR, m_debug );
+    }
   }
 
   // did any collection pass the cuts?
@@ -760,6 +799,19 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
 
       if ( m_debug ) { Info("executeSelection()", "Now doing electron trigger matching..."); }
 
+      // match all the selected electrons against all the chains in one go
+      //
+      if ( m_trigElMatchEngine ) {
+
+        const xAOD::EventInfo* eventInfo(nullptr);
+        RETURN_CHECK("ElectronSelector::executeSelection()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
+
+        RETURN_CHECK("ElectronSelector::executeSelection()", m_trigElMatchEngine->fetchFeatures( eventInfo ), "Failed to fetch HLT electron features");
+        m_trigElMatchEngine->match( selectedElectrons );
+
+        return true;
+      }
+
       for ( auto const &chain : m_ElTrigChainsList ) {
 
          if ( m_debug ) { Info("executeSelection()", "\t checking trigger chain %s", chain.c_str()); }
@@ -821,6 +873,7 @@ EL::StatusCode ElectronSelector :: finalize ()
   if ( m_el_LH_PIDManager )       { m_el_LH_PIDManager = nullptr;       delete m_el_LH_PIDManager;  }
   if ( m_IsolationSelectionTool ) { m_IsolationSelectionTool = nullptr; delete m_IsolationSelectionTool; }
   if ( m_trigElMatchTool )        { m_trigElMatchTool = nullptr;        delete m_trigElMatchTool; }
+  if ( m_trigElMatchEngine )      { delete m_trigElMatchEngine;         m_trigElMatchEngine = nullptr; }
 
   if ( m_useCutFlow ) {
     Info("finalize()", "Filling cutflow");
@@ -972,6 +1025,17 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       }
       electron->auxdecor<char>(decorWP) = static_cast<char>( electron->auxdata< int >( "DFCommonElectrons" + decorWP ) );
     }
+  } else if ( m_singlePassPID ) {
+
+    // evaluate all the valid WPs in one go, then cut electrons if not satisfying selected WP
+    //
+    unsigned int LHPassMask = m_el_LH_PIDManager->evaluateWPs( electron );
+
+    if ( m_doLHPIDcut && !( LHPassMask & m_LHPassBit ) ) {
+    	if ( m_debug ) { Info("PassCuts()", "Electron failed likelihood PID cut w/ operating point %s", m_LHOperatingPoint.c_str() ); }
+    	return 0;
+    }
+
   } else {
 
     // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
@@ -1021,6 +1085,17 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       }
       electron->auxdecor<char>(decorWP) = static_cast<char>( electron->auxdata< int >( "DFCommonElectronsIsEM" + decorWP ) );
     }
+  } else if ( m_singlePassPID ) {
+
+    // evaluate all the valid WPs in one go, then cut electrons if not satisfying selected WP
+    //
+    unsigned int CutBasedPassMask = m_el_CutBased_PIDManager->evaluateWPs( electron );
+
+    if ( m_doCutBasedPIDcut && !( CutBasedPassMask & m_CutBasedPassBit ) ) {
+    	if ( m_debug ) { Info("PassCuts()", "Electron failed cut-based PID cut." ); }
+    	return 0;
+    }
+
   } else {
 
     // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
@@ -1119,24 +1194,73 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
   //
   Root::TAccept accept_list = m_IsolationSelectionTool->accept( *electron );
 
-  // Decorate w/ decision for all input WPs
-  //
-  std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
+  if ( m_singlePassIso ) {
 
-    std::string decorWP = base_decor + "_" + WP_itr;
+    // Resolve the position of each WP in the TAccept (and its bit in the packed word) only once,
+    // so that no string lookup is needed per object
+    //
+    if ( m_IsoCutPositions.empty() ) {
+      for ( auto WP_itr : m_IsoKeys ) {
+        m_IsoCutPositions.push_back( accept_list.getCutPosition( WP_itr.c_str() ) );
+        m_IsoBits.push_back( HelperFunctions::getIsolationWPBit( WP_itr ) );
+        if ( m_IsoBits.back() < 0 ) { Warning("PassCuts()", "Isolation WP %s cannot be packed in 'isIsolatedBits': will decorate w/ 'isIsolated_%s' instead", WP_itr.c_str(), WP_itr.c_str() ); }
+      }
+      if ( !m_MinIsoWPCut.empty() ) { m_MinIsoCutPosition = accept_list.getCutPosition( m_MinIsoWPCut.c_str() ); }
+    }
 
-    if ( m_debug ) { Info("PassCuts()", "Decorate electron with %s - accept() ? %i", decorWP.c_str(), accept_list.getCutResult( WP_itr.c_str()) ); }
-    electron->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+    // Decorate w/ decision for all input WPs in one word
+    //
+    uint32_t isoBits(0);
+    for ( unsigned int idx(0); idx < m_IsoKeys.size(); ++idx ) {
 
-  }
+      bool pass = accept_list.getCutResult( m_IsoCutPositions.at(idx) );
+      int  bit  = m_IsoBits.at(idx);
+
+      if ( bit < 0 ) {
+        electron->auxdecor<char>( "isIsolated_" + m_IsoKeys.at(idx) ) = static_cast<char>( pass );
+        continue;
+      }
+
+      if ( pass ) { isoBits |= ( 1u << bit ); }
+      isoBits |= ( 1u << ( bit + 16 ) );
+
+    }
+
+    static SG::AuxElement::Decorator< uint32_t > isoBitsDecor("isIsolatedBits");
+    isoBitsDecor( *electron ) = isoBits;
+
+    if ( m_debug ) { Info("PassCuts()", "Decorate electron with isIsolatedBits = 0x%08x", isoBits ); }
+
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoCutPosition ) ) {
+      if ( m_debug ) { Info("PassCuts()", "Electron failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
+      return 0;
+    }
+
+  } else {
+
+    // Decorate w/ decision for all input WPs
+    //
+    std::string base_decor("isIsolated");
+    for ( auto WP_itr : m_IsoKeys ) {
+
+      std::string decorWP = base_decor + "_" + WP_itr;
+
+      if ( m_debug ) { Info("PassCuts()", "Decorate electron with %s - accept() ? %i", decorWP.c_str(), accept_list.getCutResult( WP_itr.c_str()) ); }
+      electron->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+
+    }
+
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+      if ( m_debug ) { Info("PassCuts()", "Electron failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
+      return 0;
+    }
 
-  // Apply the cut if needed
-  //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
-    if ( m_debug ) { Info("PassCuts()", "Electron failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
-    return 0;
   }
+
   if(m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_iso_cut, 1 );
   if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_iso_cut, 1 ); }
 
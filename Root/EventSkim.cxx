@@ -0,0 +1,222 @@
+/******************************************
+ *
+ * Event-level skim predicate (object counts,
+ * MET threshold, trigger), lazily evaluated
+ * before filling trees or histograms.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <algorithm>
+
+// EDM include(s):
+#include "xAODBase/IParticleContainer.h"
+#include "xAODMissingET/MissingETContainer.h"
+
+// package include(s):
+#include "xAODAnaHelpers/EventSkim.h"
+#include "xAODAnaHelpers/HelperFunctions.h"
+
+// ROOT include(s):
+#include "TError.h"
+
+namespace {
+
+  std::string trim( const std::string& str )
+  {
+    std::size_t first = str.find_first_not_of(" \t");
+    if ( first == std::string::npos ) { return ""; }
+    std::size_t last = str.find_last_not_of(" \t");
+    return str.substr( first, last - first + 1 );
+  }
+
+  std::vector<std::string> split( const std::string& str, const std::string& delimiter )
+  {
+    std::vector<std::string> tokens;
+    std::size_t start(0), pos(0);
+    while ( ( pos = str.find( delimiter, start ) ) != std::string::npos ) {
+      tokens.push_back( str.substr( start, pos - start ) );
+      start = pos + delimiter.size();
+    }
+    tokens.push_back( str.substr( start ) );
+    return tokens;
+  }
+
+}
+
+EventSkim::EventSkim( const std::string& predicate ) :
+  m_predicate(predicate),
+  m_valid(true),
+  m_nEvaluated(0),
+  m_nPassed(0)
+{
+
+  for ( const auto& alternative : split( predicate, "||" ) ) {
+    std::vector<Term> terms;
+    for ( const auto& termStr : split( alternative, "&&" ) ) {
+      if ( trim( termStr ).empty() ) { continue; }
+      Term term;
+      if ( !this->parseTerm( trim( termStr ), term ) ) {
+        Error("EventSkim()", "Cannot parse the term '%s' of the skim predicate '%s'", trim( termStr ).c_str(), predicate.c_str());
+        m_valid = false;
+        continue;
+      }
+      terms.push_back( term );
+    }
+    if ( !terms.empty() ) { m_alternatives.push_back( terms ); }
+  }
+
+}
+
+EventSkim::~EventSkim() {}
+
+bool EventSkim::parseTerm( const std::string& termStr, Term& term ) const
+{
+  // <function>(<argument>) [<op> <value>]
+  std::size_t open  = termStr.find('(');
+  std::size_t close = termStr.find(')', open);
+  if ( open == std::string::npos || close == std::string::npos ) { return false; }
+
+  const std::string function = trim( termStr.substr( 0, open ) );
+  const std::string argument = trim( termStr.substr( open + 1, close - open - 1 ) );
+  const std::string rest     = trim( termStr.substr( close + 1 ) );
+  if ( argument.empty() ) { return false; }
+
+  if ( function == "trigger" ) {
+    term.m_type  = TRIGGER;
+    term.m_name  = argument;
+    term.m_op    = EQ;
+    term.m_value = 1;
+    return rest.empty();
+  } else if ( function == "count" ) {
+    term.m_type = COUNT;
+    term.m_name = argument;
+  } else if ( function == "met" ) {
+    term.m_type = MET;
+    std::vector<std::string> fields = split( argument, "," );
+    term.m_name    = trim( fields.at(0) );
+    term.m_metTerm = ( fields.size() > 1 ) ? trim( fields.at(1) ) : "FinalClus";
+  } else {
+    return false;
+  }
+
+  // the two-character operators first
+  static const std::vector< std::pair<std::string, Operator> > operators = { {">=", GE}, {"<=", LE}, {"==", EQ}, {"!=", NE}, {">", GT}, {"<", LT} };
+  for ( const auto& op : operators ) {
+    if ( rest.compare( 0, op.first.size(), op.first ) != 0 ) { continue; }
+    term.m_op = op.second;
+    try {
+      term.m_value = std::stof( rest.substr( op.first.size() ) );
+    } catch ( const std::exception& ) {
+      return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool EventSkim::compare( Operator op, float lhs, float rhs ) const
+{
+  switch ( op ) {
+    case GE: return lhs >= rhs;
+    case GT: return lhs >  rhs;
+    case LE: return lhs <= rhs;
+    case LT: return lhs <  rhs;
+    case EQ: return lhs == rhs;
+    case NE: return lhs != rhs;
+  }
+  return false;
+}
+
+StatusCode EventSkim::evaluateTerm( const Term& term, const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass ) const
+{
+  switch ( term.m_type ) {
+    case TRIGGER: {
+      static SG::AuxElement::ConstAccessor< std::vector< std::string > > passTrigs("passTriggers");
+      pass = passTrigs.isAvailable( *eventInfo ) &&
+             std::find( passTrigs( *eventInfo ).begin(), passTrigs( *eventInfo ).end(), term.m_name ) != passTrigs( *eventInfo ).end();
+      break;
+    }
+    case COUNT: {
+      const xAOD::IParticleContainer* cont(nullptr);
+      if ( !HelperFunctions::retrieve( cont, term.m_name, event, store ).isSuccess() ) {
+        Error("EventSkim::evaluate()", "Could not retrieve container %s", term.m_name.c_str());
+        return StatusCode::FAILURE;
+      }
+      pass = this->compare( term.m_op, cont->size(), term.m_value );
+      break;
+    }
+    case MET: {
+      const xAOD::MissingETContainer* met(nullptr);
+      if ( !HelperFunctions::retrieve( met, term.m_name, event, store ).isSuccess() ) {
+        Error("EventSkim::evaluate()", "Could not retrieve MET container %s", term.m_name.c_str());
+        return StatusCode::FAILURE;
+      }
+      xAOD::MissingETContainer::const_iterator met_itr = met->find( term.m_metTerm );
+      if ( met_itr == met->end() ) {
+        Error("EventSkim::evaluate()", "No term %s in MET container %s", term.m_metTerm.c_str(), term.m_name.c_str());
+        return StatusCode::FAILURE;
+      }
+      pass = this->compare( term.m_op, (*met_itr)->met() * 1e-3, term.m_value );
+      break;
+    }
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode EventSkim::evaluate( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass )
+{
+  ++m_nEvaluated;
+
+  pass = m_alternatives.empty();
+  for ( const auto& terms : m_alternatives ) {
+    bool passTerms(true);
+    for ( const auto& term : terms ) {
+      if ( !this->evaluateTerm( term, eventInfo, event, store, passTerms ).isSuccess() ) { return StatusCode::FAILURE; }
+      if ( !passTerms ) { break; }
+    }
+    if ( passTerms ) {
+      pass = true;
+      break;
+    }
+  }
+
+  if ( pass ) { ++m_nPassed; }
+
+  return StatusCode::SUCCESS;
+}
+
+void EventSkim::printStats() const
+{
+  Info("EventSkim::printStats()", "'%s': %llu / %llu events passed", m_predicate.c_str(), m_nPassed, m_nEvaluated);
+}
+
+StatusCode EventSkim::create( const std::string& predicate, EventSkim*& skim )
+{
+  skim = nullptr;
+  if ( predicate.empty() ) { return StatusCode::SUCCESS; }
+
+  skim = new EventSkim( predicate );
+  if ( !skim->isValid() ) {
+    Error("EventSkim::create()", "Invalid skim predicate: %s", predicate.c_str());
+    delete skim; skim = nullptr;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode EventSkim::passes( EventSkim* skim, const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass )
+{
+  pass = true;
+  if ( !skim ) { return StatusCode::SUCCESS; }
+  return skim->evaluate( eventInfo, event, store, pass );
+}
+
+void EventSkim::release( EventSkim*& skim )
+{
+  if ( !skim ) { return; }
+  skim->printStats();
+  delete skim; skim = nullptr;
+}
@@ -0,0 +1,342 @@
+/******************************************
+ *
+ * Build the per-event weight vector, indexed
+ * by systematic, out of the MC event weight,
+ * the pileup weight and all the SFs.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/StatusCode.h>
+#include <EventLoop/Worker.h>
+
+// package include(s):
+#include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/EventWeightBuilder.h"
+#include "xAODAnaHelpers/ScaleFactorTable.h"
+
+#include <xAODAnaHelpers/tools/ReturnCheck.h>
+
+// ROOT include(s):
+#include "TEnv.h"
+#include "TSystem.h"
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(EventWeightBuilder)
+
+
+EventWeightBuilder :: EventWeightBuilder (std::string className) :
+    Algorithm(className),
+    m_layoutReady(false)
+{
+  Info("EventWeightBuilder()", "Calling constructor");
+
+  m_debug                   = false;
+
+  m_inputSFNames            = "";
+  m_usePileupWeight         = true;
+  m_useMCEventWeight        = true;
+  m_outputWeightName        = "EventWeights";
+}
+
+
+EL::StatusCode  EventWeightBuilder :: configure ()
+{
+
+  if ( !getConfig().empty() ) {
+
+    Info("configure()", "Configuing EventWeightBuilder Interface. User configuration read from : %s ", getConfig().c_str());
+
+    TEnv* config = new TEnv(getConfig(true).c_str());
+
+    m_debug                   = config->GetValue("Debug", m_debug);
+
+    m_inputSFNames            = config->GetValue("InputSFNames",     m_inputSFNames.c_str());
+    m_usePileupWeight         = config->GetValue("UsePileupWeight",  m_usePileupWeight);
+    m_useMCEventWeight        = config->GetValue("UseMCEventWeight", m_useMCEventWeight);
+    m_outputWeightName        = config->GetValue("OutputWeightName", m_outputWeightName.c_str());
+
+    config->Print();
+    Info("configure()", "EventWeightBuilder Interface succesfully configured! ");
+
+    delete config; config = nullptr;
+  }
+
+  if ( m_outputWeightName.empty() ) {
+    Error("configure()", "OutputWeightName is empty!");
+    return EL::StatusCode::FAILURE;
+  }
+
+  // Parse the list of SF sources, split by comma: each entry is "<SF name>" or "<SF name>:<syst names>"
+  //
+  m_sources.clear();
+  std::string token;
+  std::istringstream ss(m_inputSFNames);
+  while ( std::getline(ss, token, ',') ) {
+    token.erase( 0, token.find_first_not_of(" ") );
+    token.erase( token.find_last_not_of(" ") + 1 );
+    if ( token.empty() ) { continue; }
+
+    SFSource source;
+    std::size_t sep = token.find(':');
+    source.m_name         = token.substr( 0, sep );
+    source.m_systNamesKey = ( sep != std::string::npos ) ? token.substr( sep + 1 ) : source.m_name;
+    source.m_offset       = 0;
+    source.m_nSysts       = 1;
+    m_sources.push_back( source );
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode EventWeightBuilder :: setupJob (EL::Job& job)
+{
+  Info("setupJob()", "Calling setupJob");
+
+  job.useXAOD ();
+  xAOD::Init( "EventWeightBuilder" ).ignore(); // call before opening first file
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: histInitialize ()
+{
+  RETURN_CHECK("xAH::Algorithm::algInitialize()", xAH::Algorithm::algInitialize(), "");
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: fileExecute ()
+{
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: changeInput (bool /*firstFile*/)
+{
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: initialize ()
+{
+  Info("initialize()", "Initializing EventWeightBuilder Interface... ");
+
+  m_event = wk()->xaodEvent();
+  m_store = wk()->xaodStore();
+
+  if ( this->configure() == EL::StatusCode::FAILURE ) {
+    Error("initialize()", "Failed to properly configure. Exiting." );
+    return EL::StatusCode::FAILURE;
+  }
+
+  m_isMC = this->isMC();
+
+  m_accGlobal.clear();
+  m_accEvent.clear();
+  for ( const auto& source : m_sources ) {
+    m_accGlobal.push_back( SG::AuxElement::ConstAccessor< std::vector<float> >( source.m_name + "_GLOBAL" ) );
+    m_accEvent.push_back(  SG::AuxElement::ConstAccessor< std::vector<float> >( source.m_name ) );
+  }
+
+  m_nominalSFs.assign( m_sources.size(), 1.0 );
+  m_exclusive.assign(  m_sources.size(), 1.0 );
+  m_eventSFs.assign(   m_sources.size(), nullptr );
+
+  m_layoutReady = false;
+  m_numEvent    = 0;
+
+  Info("initialize()", "EventWeightBuilder Interface succesfully initialized! Combining %lu SF source(s)", m_sources.size() );
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+const std::vector<float>* EventWeightBuilder :: getEventSFs ( unsigned int iSource, const xAOD::EventInfo* eventInfo )
+{
+  // prefer the SF table, if the corrector wrote one
+  //
+  std::string tableName = m_sources.at(iSource).m_name + "_Table";
+  if ( m_store->contains<ScaleFactorTable>( tableName ) ) {
+    const ScaleFactorTable* table(nullptr);
+    if ( m_store->retrieve( table, tableName ).isSuccess() ) { return &table->getGlobal(); }
+  }
+
+  if ( m_accGlobal.at(iSource).isAvailable( *eventInfo ) ) { return &m_accGlobal.at(iSource)( *eventInfo ); }
+  if ( m_accEvent.at(iSource).isAvailable( *eventInfo ) )  { return &m_accEvent.at(iSource)( *eventInfo ); }
+
+  return nullptr;
+}
+
+
+EL::StatusCode EventWeightBuilder :: buildLayout ()
+{
+  m_weightNames.clear();
+  m_weightNames.push_back( "nominal" );
+
+  for ( auto& source : m_sources ) {
+
+    // the correctors record the names of all the systematics they process in every event, whatever the objects in it:
+    // this fixes the layout even if the first event has no SF for a source
+    //
+    const std::vector<std::string>* systNames(nullptr);
+    if ( !m_store->contains< std::vector<std::string> >( source.m_systNamesKey ) ||
+         !m_store->retrieve( systNames, source.m_systNamesKey ).isSuccess() || systNames->empty() ) {
+      Error("buildLayout()", "Cannot find the systematic names of SF source %s (%s) in TStore. Is the corrector scheduled before this algorithm?", source.m_name.c_str(), source.m_systNamesKey.c_str() );
+      return EL::StatusCode::FAILURE;
+    }
+
+    source.m_offset = m_weightNames.size();
+    source.m_nSysts = systNames->size();
+
+    for ( unsigned int iSyst(1); iSyst < source.m_nSysts; ++iSyst ) {
+      m_weightNames.push_back( systNames->at(iSyst) );
+    }
+
+    if ( m_debug ) { Info("buildLayout()", "SF source %s: %u systematic(s) starting at index %u", source.m_name.c_str(), source.m_nSysts - 1, source.m_offset ); }
+  }
+
+  Info("buildLayout()", "Event weight vector %s has %lu entries", m_outputWeightName.c_str(), m_weightNames.size() );
+
+  m_layoutReady = true;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode EventWeightBuilder :: execute ()
+{
+  if ( m_debug ) { Info("execute()", "Building event weights... "); }
+
+  ++m_numEvent;
+
+  const xAOD::EventInfo* eventInfo(nullptr);
+  RETURN_CHECK("EventWeightBuilder::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
+
+  std::vector<float>& weights = eventInfo->auxdecor< std::vector<float> >( m_outputWeightName );
+
+  if ( !m_isMC ) {
+    if ( m_numEvent == 1 ) { Info("execute()", "Sample is Data! Event weight will be set to 1"); }
+    weights.assign( 1, 1.0 );
+    if ( m_weightNames.empty() ) { m_weightNames.push_back( "nominal" ); }
+    RETURN_CHECK( "EventWeightBuilder::execute()", this->recordWeightNames(), "" );
+    return EL::StatusCode::SUCCESS;
+  }
+
+  if ( !m_layoutReady ) { RETURN_CHECK( "EventWeightBuilder::execute()", this->buildLayout(), "Failed to build the layout of the event weights" ); }
+
+  // MC event weight and pileup weight
+  //
+  float baseWeight(1.0);
+  if ( m_useMCEventWeight ) {
+    static SG::AuxElement::ConstAccessor< float > mcEvtWeightAcc("mcEventWeight");
+    baseWeight *= ( mcEvtWeightAcc.isAvailable( *eventInfo ) ) ? mcEvtWeightAcc( *eventInfo ) : eventInfo->mcEventWeight();
+  }
+  if ( m_usePileupWeight ) {
+    static SG::AuxElement::ConstAccessor< float > pileupWeightAcc("PileupWeight");
+    if ( pileupWeightAcc.isAvailable( *eventInfo ) ) { baseWeight *= pileupWeightAcc( *eventInfo ); }
+  }
+
+  // nominal SF of each source. A missing source counts as 1
+  //
+  const unsigned int nSources = m_sources.size();
+  for ( unsigned int iSource(0); iSource < nSources; ++iSource ) {
+    m_eventSFs[iSource]   = this->getEventSFs( iSource, eventInfo );
+    m_nominalSFs[iSource] = ( m_eventSFs[iSource] && !m_eventSFs[iSource]->empty() ) ? m_eventSFs[iSource]->front() : 1.0;
+  }
+
+  // product of all the nominal SFs but one, for each source (prefix and suffix products, so there is no division by a null SF)
+  //
+  float product(baseWeight);
+  for ( unsigned int iSource(0); iSource < nSources; ++iSource ) {
+    m_exclusive[iSource] = product;
+    product *= m_nominalSFs[iSource];
+  }
+  const float nominalWeight = product;
+  product = 1.0;
+  for ( unsigned int iSource = nSources; iSource-- > 0; ) {
+    m_exclusive[iSource] *= product;
+    product *= m_nominalSFs[iSource];
+  }
+
+  // fill the weight vector in one go
+  //
+  weights.resize( m_weightNames.size() );
+  weights[0] = nominalWeight;
+
+  for ( unsigned int iSource(0); iSource < nSources; ++iSource ) {
+    const SFSource& source = m_sources[iSource];
+    const std::vector<float>* sfs = m_eventSFs[iSource];
+    // the SFs of the nominal input container come first, then those of the systematically varied ones (if any), which are not used here
+    const unsigned int nAvailable = ( sfs ) ? std::min<unsigned int>( sfs->size(), source.m_nSysts ) : 0;
+
+    if ( sfs && nAvailable != source.m_nSysts && m_debug ) {
+      Warning("execute()", "Found %u SFs for %s, expected %u. The missing ones are set to the nominal", nAvailable, source.m_name.c_str(), source.m_nSysts );
+    }
+
+    float* dest = &weights[ source.m_offset - 1 ];
+    for ( unsigned int iSyst(1); iSyst < source.m_nSysts; ++iSyst ) {
+      dest[iSyst] = m_exclusive[iSource] * ( ( iSyst < nAvailable ) ? (*sfs)[iSyst] : m_nominalSFs[iSource] );
+    }
+  }
+
+  if ( m_debug ) {
+    for ( unsigned int iWeight(0); iWeight < weights.size(); ++iWeight ) {
+      Info("execute()", "\t weight %u (%s) = %f", iWeight, m_weightNames[iWeight].c_str(), weights[iWeight] );
+    }
+  }
+
+  RETURN_CHECK( "EventWeightBuilder::execute()", this->recordWeightNames(), "" );
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode EventWeightBuilder :: recordWeightNames ()
+{
+  // add the names of the weights to TStore, on data too (where there is only the nominal)
+  //
+  if ( !m_store->contains< std::vector<std::string> >( m_outputWeightName + "_Names" ) ) {
+    std::vector<std::string>* weightNames = new std::vector<std::string>( m_weightNames );
+    RETURN_CHECK( "EventWeightBuilder::recordWeightNames()", m_store->record( weightNames, m_outputWeightName + "_Names" ), "Failed to record vector of event weight names.");
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: postExecute ()
+{
+  if ( m_debug ) { Info("postExecute()", "Calling postExecute"); }
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: finalize ()
+{
+  Info("finalize()", "%s", m_name.c_str());
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode EventWeightBuilder :: histFinalize ()
+{
+  Info("histFinalize()", "Calling histFinalize");
+  RETURN_CHECK("xAH::Algorithm::algFinalize()", xAH::Algorithm::algFinalize(), "");
+  return EL::StatusCode::SUCCESS;
+}
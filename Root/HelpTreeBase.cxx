@@ -1,5 +1,10 @@
 // c++ include(s):
 #include <iostream>
+#include <set>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
 
 // EDM include(s):
 #include "xAODBTagging/BTagging.h"
@@ -18,6 +23,12 @@
 #include <xAODAnaHelpers/HelpTreeBase.h>
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
+// ROOT include(s):
+#include "RVersion.h"
+#include "TROOT.h"
+#include "TBranchElement.h"
+#include "TLeaf.h"
+
 #include "AsgTools/StatusCode.h"
 
 // needed? should it be here?
@@ -25,6 +36,11 @@
 #pragma link C++ class vector<float>+;
 #endif
 
+namespace {
+  // the files written by a background writer: TFile is not thread-safe, so there is at most one writer per file
+  std::set<TFile*> asyncWriteFiles;
+}
+
 HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const float units, bool debug, bool DC14, xAOD::TStore* store):
   m_eventInfoSwitch(nullptr),
   m_trigInfoSwitch(nullptr),
@@ -38,7 +54,10 @@ HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const
   m_metInfoSwitch(nullptr),
   m_trkSelTool(nullptr),
   m_trigConfTool(nullptr),
-  m_trigDecTool(nullptr)
+  m_trigDecTool(nullptr),
+  m_writePending(false),
+  m_stopWriter(false),
+  m_asyncWriteFile(nullptr)
 {
 
   m_units = units;
@@ -48,6 +67,8 @@ HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const
   m_tree->SetDirectory( file );
   m_event = event;
   m_store = store;
+  m_eventInfoName = "EventInfo";
+  m_eventWeightsName = "EventWeights";
   Info("HelpTreeBase()", "HelpTreeBase setup");
 
   // turn things off it this is data...since TStore is not a needed input
@@ -65,8 +86,325 @@ HelpTreeBase::HelpTreeBase(TTree* tree, TFile* file, xAOD::TEvent* event, xAOD::
 }
 
 
+HelpTreeBase::~HelpTreeBase() {
+
+  // too late for the branch variables of a derived class, which are gone already: see StopAsyncWrite()
+  this->StopAsyncWrite();
+
+}
+
 void HelpTreeBase::Fill() {
-  m_tree->Fill();
+
+  this->applyPrecision();
+
+  if ( m_writerThread.joinable() ) {
+    // the branch variables are not touched until the writer is done with them (see WaitForWrite())
+    this->WaitForWrite();
+    {
+      std::lock_guard<std::mutex> lock( m_writerMutex );
+      m_writePending = true;
+    }
+    m_writerCV.notify_all();
+  } else {
+    m_tree->Fill();
+  }
+}
+
+bool HelpTreeBase::ReducedPrecision::parse( const std::string& spec ) {
+
+  try {
+    if ( spec.compare(0, 5, "trunc") == 0 ) {
+      m_mode = TRUNCATE;
+      m_bits = std::stoi( spec.substr(5) );
+      return ( m_bits >= 0 && m_bits < 23 );
+    }
+    if ( spec.compare(0, 5, "range") == 0 ) {
+      std::vector<std::string> fields;
+      std::string field;
+      std::istringstream ss( spec.substr(5) );
+      while ( std::getline(ss, field, ':') ) { fields.push_back( field ); }
+      if ( fields.size() != 3 ) { return false; }
+      m_mode = RANGE;
+      m_min  = std::stof( fields.at(0) );
+      m_max  = std::stof( fields.at(1) );
+      m_bits = std::stoi( fields.at(2) );
+      if ( !( m_max > m_min && m_bits > 0 && m_bits <= 24 ) ) { return false; }
+      m_step = powerOfTwoStep( ( m_max - m_min ) / static_cast<float>( ( 1u << m_bits ) - 1 ) );
+      return ( m_step > 0 );
+    }
+    if ( spec.compare(0, 5, "fixed") == 0 ) {
+      m_mode = FIXED;
+      const float step = std::stof( spec.substr(5) );
+      if ( !( step > 0 ) ) { return false; }
+      m_step = powerOfTwoStep( step );
+      return ( m_step > 0 );
+    }
+  } catch ( const std::exception& ) { }
+
+  return false;
+}
+
+float HelpTreeBase::ReducedPrecision::powerOfTwoStep( float step ) {
+
+  // a multiple of 2^-k only needs the mantissa bits down to 2^-k: the bits below are zero and compress away.
+  // A multiple of an arbitrary step (0.001, (max-min)/4095) fills the whole mantissa, however coarse the step.
+  // The largest power of two not above the requested step keeps at least the requested precision
+  return std::exp2( std::floor( std::log2( step ) ) );
+
+}
+
+float HelpTreeBase::ReducedPrecision::apply( float value ) const {
+
+  // the sentinels are kept as they are: all identical, they compress to almost nothing
+  if ( value == -999. || !std::isfinite( value ) ) { return value; }
+
+  switch ( m_mode ) {
+    case TRUNCATE: {
+      // keep m_bits bits of the mantissa, rounding to nearest: the zeroed bits compress away
+      const uint32_t drop = 23 - m_bits;
+      uint32_t bits(0);
+      std::memcpy( &bits, &value, sizeof(bits) );
+      bits += ( 1u << ( drop - 1 ) );
+      bits &= ~( ( 1u << drop ) - 1 );
+      std::memcpy( &value, &bits, sizeof(bits) );
+      return value;
+    }
+    case RANGE:
+      // Float16_t-like: at least m_bits bits over [m_min, m_max]. Anything outside is kept as it is
+      if ( value < m_min || value > m_max ) { return value; }
+      return std::round( value / m_step ) * m_step;
+    case FIXED:
+      return std::round( value / m_step ) * m_step;
+  }
+
+  return value;
+}
+
+std::string HelpTreeBase::getPrecisionGroup( const std::string& branchName ) const {
+
+  if ( branchName.find("SF") != std::string::npos || branchName.find("eight") != std::string::npos ) { return "SF"; }
+
+  // the variable, without the object prefix (muon_, jet_, ...)
+  const std::string var = branchName.substr( branchName.find_last_of('_') + 1 );
+  if ( var.compare(0, 3, "eta") == 0 || var.compare(0, 3, "phi") == 0 || var.compare(0, 5, "theta") == 0 ) { return "angles"; }
+  if ( var == "pt" || var == "m" || var == "E" || var == "e" || var == "et" ||
+       var == "px" || var == "py" || var == "pz" || branchName.compare(0, 3, "met") == 0 ) { return "kinematic"; }
+
+  return "other";
+}
+
+void HelpTreeBase::setPrecision( const HelperClasses::InfoSwitch* infoSwitch, int firstBranch ) {
+
+  if ( !infoSwitch || infoSwitch->m_precision.empty() ) { return; }
+
+  TObjArray* branches = m_tree->GetListOfBranches();
+  for ( int iBranch = firstBranch; iBranch < branches->GetEntries(); ++iBranch ) {
+    TBranch* branch = static_cast<TBranch*>( branches->At(iBranch) );
+
+    auto spec_itr = infoSwitch->m_precision.find( this->getPrecisionGroup( branch->GetName() ) );
+    if ( spec_itr == infoSwitch->m_precision.end() ) { spec_itr = infoSwitch->m_precision.find( "all" ); }
+    if ( spec_itr == infoSwitch->m_precision.end() ) { continue; }
+
+    ReducedPrecision precision;
+    if ( !precision.parse( spec_itr->second ) ) {
+      Error("setPrecision()", "Cannot parse precision %s for branch %s", spec_itr->second.c_str(), branch->GetName());
+      continue;
+    }
+
+    TBranchElement* branchElement = dynamic_cast<TBranchElement*>( branch );
+    if ( branchElement ) {
+      const std::string className = branchElement->GetClassName();
+      if ( className == "vector<float>" ) {
+        m_reducedVectors.push_back( std::make_pair( reinterpret_cast< std::vector<float>* >( branchElement->GetObject() ), precision ) );
+      } else if ( className == "vector<vector<float> >" ) {
+        m_reducedVectorVectors.push_back( std::make_pair( reinterpret_cast< std::vector< std::vector<float> >* >( branchElement->GetObject() ), precision ) );
+      }
+    } else if ( branch->GetListOfLeaves()->GetEntries() == 1 ) {
+      TLeaf* leaf = static_cast<TLeaf*>( branch->GetListOfLeaves()->At(0) );
+      if ( std::string( leaf->GetTypeName() ) == "Float_t" && leaf->GetLen() == 1 ) {
+        m_reducedFloats.push_back( std::make_pair( reinterpret_cast<float*>( branch->GetAddress() ), precision ) );
+      }
+    }
+  }
+
+}
+
+void HelpTreeBase::applyPrecision() {
+
+  for ( auto& reduced : m_reducedFloats ) {
+    *reduced.first = reduced.second.apply( *reduced.first );
+  }
+  for ( auto& reduced : m_reducedVectors ) {
+    for ( auto& value : *reduced.first ) { value = reduced.second.apply( value ); }
+  }
+  for ( auto& reduced : m_reducedVectorVectors ) {
+    for ( auto& values : *reduced.first ) {
+      for ( auto& value : values ) { value = reduced.second.apply( value ); }
+    }
+  }
+
+}
+
+bool HelpTreeBase::EnableAsyncWrite() {
+
+  if ( m_writerThread.joinable() ) { return true; }
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  TFile* file = m_tree->GetCurrentFile();
+  if ( file && asyncWriteFiles.count( file ) ) {
+    Warning("EnableAsyncWrite()", "Another tree is already written in a background thread to %s. Tree %s will be written synchronously", file->GetName(), m_tree->GetName());
+    return false;
+  }
+
+  // the writer thread and the event loop both go through ROOT's global state (gDirectory, streamers, ...)
+  ROOT::EnableThreadSafety();
+
+  m_writePending = false;
+  m_stopWriter   = false;
+  m_writerThread = std::thread( &HelpTreeBase::writerLoop, this );
+  if ( file ) { asyncWriteFiles.insert( file ); m_asyncWriteFile = file; }
+
+  Info("EnableAsyncWrite()", "Tree %s will be written in a background thread", m_tree->GetName());
+  return true;
+#else
+  Warning("EnableAsyncWrite()", "ROOT::EnableThreadSafety() is not available in ROOT %s. Tree %s will be written synchronously", ROOT_RELEASE, m_tree->GetName());
+  return false;
+#endif
+
+}
+
+void HelpTreeBase::StopAsyncWrite() {
+
+  if ( !m_writerThread.joinable() ) { return; }
+
+  // write the last event and stop the writer
+  {
+    std::lock_guard<std::mutex> lock( m_writerMutex );
+    m_stopWriter = true;
+  }
+  m_writerCV.notify_all();
+  m_writerThread.join();
+
+  if ( m_asyncWriteFile ) { asyncWriteFiles.erase( m_asyncWriteFile ); m_asyncWriteFile = nullptr; }
+
+}
+
+void HelpTreeBase::WaitForWrite() {
+
+  if ( !m_writerThread.joinable() ) { return; }
+
+  std::unique_lock<std::mutex> lock( m_writerMutex );
+  m_writerCV.wait( lock, [this] { return !m_writePending; } );
+
+}
+
+HelpTreeBase::IsolationWP::IsolationWP( const std::string& WP, std::vector<int>* vec ) :
+  flag( "isIsolated_" + WP ),
+  bit( HelperFunctions::getIsolationWPBit( WP ) ),
+  branch( vec )
+{ }
+
+void HelpTreeBase::FillIsolation( const SG::AuxElement& particle, std::vector<IsolationWP>& isoWPs ) {
+
+  static SG::AuxElement::ConstAccessor<uint32_t> isIsoBitsAcc ("isIsolatedBits");
+
+  // the packed word is read once per object: pass bit N, evaluated bit N+16
+  const bool     hasBits = isIsoBitsAcc.isAvailable( particle );
+  const uint32_t isoBits = ( hasBits ) ? isIsoBitsAcc( particle ) : 0;
+
+  for ( auto& isoWP : isoWPs ) {
+    int decision(-1);
+    if ( isoWP.flag.isAvailable( particle ) ) {
+      decision = isoWP.flag( particle );
+    } else if ( hasBits && isoWP.bit >= 0 && ( isoBits >> ( isoWP.bit + 16 ) ) & 1u ) {
+      decision = ( isoBits >> isoWP.bit ) & 1u;
+    }
+    isoWP.branch->push_back( decision );
+  }
+
+}
+
+const xAOD::EventInfo* HelpTreeBase::retrieveEventInfo( const std::string& caller ) {
+
+  const xAOD::EventInfo* eventInfo(nullptr);
+  if ( !HelperFunctions::retrieve(eventInfo, m_eventInfoName, m_event, m_store, m_debug).isSuccess() ) {
+    Error(caller.c_str(), "Failed to retrieve %s. The information read from it is not filled", m_eventInfoName.c_str());
+    return nullptr;
+  }
+  return eventInfo;
+
+}
+
+void HelpTreeBase::writerLoop() {
+
+  std::unique_lock<std::mutex> lock( m_writerMutex );
+  while ( true ) {
+    m_writerCV.wait( lock, [this] { return m_writePending || m_stopWriter; } );
+
+    if ( m_writePending ) {
+      lock.unlock();
+      m_tree->Fill();
+      lock.lock();
+      m_writePending = false;
+      m_writerCV.notify_all();
+    } else {
+      break;
+    }
+  }
+
+}
+
+const std::vector<const ScaleFactorTable*>& HelpTreeBase::getSFTables( const SG::AuxElement::ConstAccessor< std::vector<float> >& accessor ) {
+
+  auto tables_itr = m_sfTables.find( accessor.auxid() );
+  if ( tables_itr != m_sfTables.end() ) { return tables_itr->second; }
+
+  // one table per input container of the corrector: the nominal one, then the systematically varied ones
+  //
+  std::vector<const ScaleFactorTable*>& tables = m_sfTables[ accessor.auxid() ];
+  if ( !m_store ) { return tables; }
+
+  std::string tableName = SG::AuxTypeRegistry::instance().getName( accessor.auxid() ) + "_Table";
+  for ( unsigned int iTable(0); m_store->contains<ScaleFactorTable>( tableName ); ++iTable ) {
+    const ScaleFactorTable* table(nullptr);
+    if ( m_store->retrieve( table, tableName ).isSuccess() ) { tables.push_back( table ); }
+    tableName = SG::AuxTypeRegistry::instance().getName( accessor.auxid() ) + "_Table_" + std::to_string( iTable + 1 );
+  }
+
+  return tables;
+}
+
+void HelpTreeBase::fillSF( const SG::AuxElement& obj, const SG::AuxElement::ConstAccessor< std::vector<float> >& accessor, std::vector< std::vector<float> >& destination ) {
+
+  // reuse a row of a previous event (see clearSF()), so that its memory is not allocated again
+  if ( !m_sfRowPool.empty() ) {
+    destination.push_back( std::move( m_sfRowPool.back() ) );
+    m_sfRowPool.pop_back();
+  } else {
+    destination.emplace_back();
+  }
+  std::vector<float>& sfs = destination.back();
+
+  for ( auto table : this->getSFTables( accessor ) ) {
+    const float* row = table->getRow( obj );
+    if ( row ) {
+      sfs.assign( row, row + table->getNSysts() );
+      return;
+    }
+  }
+
+  if ( accessor.isAvailable( obj ) ) {
+    const std::vector<float>& decoration = accessor( obj );
+    sfs.assign( decoration.begin(), decoration.end() );
+  } else {
+    sfs.assign( 1, -999 );
+  }
+}
+
+void HelpTreeBase::clearSF( std::vector< std::vector<float> >& destination ) {
+
+  for ( auto& sfs : destination ) { m_sfRowPool.push_back( std::move( sfs ) ); }
+  destination.clear();
 }
 
 /*********************
@@ -80,6 +418,7 @@ void HelpTreeBase::AddEvent( const std::string detailStr ) {
   if(m_debug)  Info("AddEvent()", "Adding event variables: %s", detailStr.c_str());
 
   m_eventInfoSwitch = new HelperClasses::EventInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // always
   m_tree->Branch("runNumber",          &m_runNumber,      "runNumber/I");
@@ -152,14 +491,25 @@ void HelpTreeBase::AddEvent( const std::string detailStr ) {
     m_tree->Branch("weight_electron_PIDEff_SF_LHTight",	    &m_weight_electron_PIDEff_SF_LHTight);
   }
 
+  if( m_eventInfoSwitch->m_eventWeights && m_isMC ) {
+    m_tree->Branch("weight_event",                          &m_eventWeights);
+  }
+
   this->AddEventUser();
+
+  this->setPrecision( m_eventInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* /*event*/ ) {
 
+  this->WaitForWrite();
+
   this->ClearEvent();
   this->ClearEventUser();
 
+  // the ScaleFactorTable(s) found for the previous event are gone from TStore
+  m_sfTables.clear();
+
   m_runNumber             = eventInfo->runNumber();
   m_eventNumber           = eventInfo->eventNumber();
   m_lumiBlock             = eventInfo->lumiBlock();
@@ -311,6 +661,14 @@ void HelpTreeBase::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* /*
 
   }
 
+  if( m_eventInfoSwitch->m_eventWeights && m_isMC ) {
+
+    SG::AuxElement::ConstAccessor< std::vector<float> > accEventWeights( m_eventWeightsName );
+
+    if( accEventWeights.isAvailable( *eventInfo ) ) { m_eventWeights = accEventWeights( *eventInfo ); } else { m_eventWeights.push_back(-999.0); }
+
+  }
+
   this->FillEventUser(eventInfo);
 }
 
@@ -324,6 +682,7 @@ void HelpTreeBase::AddTrigger( const std::string detailStr ) {
   if(m_debug) Info("AddTrigger()", "Adding trigger variables: %s", detailStr.c_str());
 
   m_trigInfoSwitch = new HelperClasses::TriggerInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // Add these basic branches
   if ( m_trigInfoSwitch->m_basic ) {
@@ -347,11 +706,15 @@ void HelpTreeBase::AddTrigger( const std::string detailStr ) {
   }
 
   //this->AddTriggerUser();
+
+  this->setPrecision( m_trigInfoSwitch, firstBranch );
 }
 
 // Fill the information in the trigger branches
 void HelpTreeBase::FillTrigger( const xAOD::EventInfo* eventInfo ) {
 
+  this->WaitForWrite();
+
   if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Filling trigger info"); }
 
   // Clear previous events
@@ -408,6 +771,8 @@ void HelpTreeBase::FillTrigger( const xAOD::EventInfo* eventInfo ) {
 // Clear Trigger
 void HelpTreeBase::ClearTrigger() {
 
+  this->WaitForWrite();
+
   m_passL1  = -999;
   m_passHLT = -999;
 
@@ -446,6 +811,7 @@ void HelpTreeBase::AddMuons(const std::string detailStr) {
   if ( m_debug )  Info("AddMuons()", "Adding muon variables: %s", detailStr.c_str());
 
   m_muInfoSwitch = new HelperClasses::MuonInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
   // always
   m_tree->Branch("nmuon",   &m_nmuon, "nmuon/I");
 
@@ -477,6 +843,22 @@ void HelpTreeBase::AddMuons(const std::string detailStr) {
     m_tree->Branch("muon_isIsolated_FixedCutTightTrackOnly", &m_muon_isIsolated_FixedCutTightTrackOnly);
     m_tree->Branch("muon_isIsolated_UserDefinedFixEfficiency",    &m_muon_isIsolated_UserDefinedFixEfficiency);
     m_tree->Branch("muon_isIsolated_UserDefinedCut",              &m_muon_isIsolated_UserDefinedCut);
+
+    m_muon_isoWPs.clear();
+    m_muon_isoWPs.push_back( IsolationWP( "LooseTrackOnly", &m_muon_isIsolated_LooseTrackOnly ) );
+    m_muon_isoWPs.push_back( IsolationWP( "Loose", &m_muon_isIsolated_Loose ) );
+    m_muon_isoWPs.push_back( IsolationWP( "Tight", &m_muon_isIsolated_Tight ) );
+    m_muon_isoWPs.push_back( IsolationWP( "Gradient", &m_muon_isIsolated_Gradient ) );
+    m_muon_isoWPs.push_back( IsolationWP( "GradientLoose", &m_muon_isIsolated_GradientLoose ) );
+    m_muon_isoWPs.push_back( IsolationWP( "GradientT1", &m_muon_isIsolated_GradientT1 ) );
+    m_muon_isoWPs.push_back( IsolationWP( "GradientT2", &m_muon_isIsolated_GradientT2 ) );
+    m_muon_isoWPs.push_back( IsolationWP( "MU0p06", &m_muon_isIsolated_MU0p06 ) );
+    m_muon_isoWPs.push_back( IsolationWP( "FixedCutLoose", &m_muon_isIsolated_FixedCutLoose ) );
+    m_muon_isoWPs.push_back( IsolationWP( "FixedCutTight", &m_muon_isIsolated_FixedCutTight ) );
+    m_muon_isoWPs.push_back( IsolationWP( "FixedCutTightTrackOnly", &m_muon_isIsolated_FixedCutTightTrackOnly ) );
+    m_muon_isoWPs.push_back( IsolationWP( "UserDefinedFixEfficiency", &m_muon_isIsolated_UserDefinedFixEfficiency ) );
+    m_muon_isoWPs.push_back( IsolationWP( "UserDefinedCut", &m_muon_isIsolated_UserDefinedCut ) );
+
     m_tree->Branch("muon_ptcone20",	  &m_muon_ptcone20);
     m_tree->Branch("muon_ptcone30",	  &m_muon_ptcone30);
     m_tree->Branch("muon_ptcone40",	  &m_muon_ptcone40);
@@ -544,14 +926,28 @@ void HelpTreeBase::AddMuons(const std::string detailStr) {
   }
 
   this->AddMuonsUser();
+
+  this->setPrecision( m_muInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vertex* primaryVertex ) {
 
+  this->WaitForWrite();
+
   this->ClearMuons();
   this->ClearMuonsUser();
 
   m_nmuon = 0;
+
+  // list of chains for the TrigMatchingEngine decoration (see below)
+  //
+  const std::vector<std::string>* trigMatchChains(nullptr);
+  if ( m_muInfoSwitch->m_trigger ) {
+    static SG::AuxElement::ConstAccessor< std::vector<std::string> > trigMatchChainsAcc("isTrigMatchedVecMuChains");
+    const xAOD::EventInfo* eventInfo = this->retrieveEventInfo("HelpTreeBase::FillMuons()");
+    if ( eventInfo && trigMatchChainsAcc.isAvailable( *eventInfo ) ) { trigMatchChains = &trigMatchChainsAcc( *eventInfo ); }
+  }
+
   for ( auto muon_itr : *(muons) ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillMuons()", "Filling muon w/ pT = %2f", muon_itr->pt() / m_units ); }
@@ -567,50 +963,38 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
       // retrieve map<string,char> w/ chain,isMatched
       //
       static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapMuAcc("isTrigMatchedMapMu");
-
-      if ( isTrigMatchedMapMuAcc.isAvailable( *muon_itr ) ) {
+      // or, if matched w/ TrigMatchingEngine, vector<char> w/ isMatched for each chain in the list decorated on EventInfo
+      //
+      static SG::AuxElement::ConstAccessor< std::vector<char> > isTrigMatchedVecMuAcc("isTrigMatchedVecMu");
+
+      bool foundTrigMatch(false);
+      // the TrigMatchingEngine vector if there is one, the map otherwise: the chains would be filled twice if both are there
+      if ( trigMatchChains && isTrigMatchedVecMuAcc.isAvailable( *muon_itr ) ) {
+	 const std::vector<char>& isTrigMatchedVec = isTrigMatchedVecMuAcc( *muon_itr );
+	 for ( unsigned int idx(0); idx < isTrigMatchedVec.size() && idx < trigMatchChains->size(); ++idx ) {
+	   m_muon_isTrigMatchedToChain.push_back( static_cast<int>(isTrigMatchedVec.at(idx)) );
+	   m_muon_listTrigChains.push_back( trigMatchChains->at(idx) );
+	 }
+	 foundTrigMatch = true;
+      } else if ( isTrigMatchedMapMuAcc.isAvailable( *muon_itr ) ) {
 	 // loop over map and fill branches
 	 //
 	 for ( auto const &it : (isTrigMatchedMapMuAcc( *muon_itr )) ) {
   	   m_muon_isTrigMatchedToChain.push_back( static_cast<int>(it.second) );
 	   m_muon_listTrigChains.push_back( it.first );
 	 }
-       } else {
+	 foundTrigMatch = true;
+      }
+      if ( !foundTrigMatch ) {
 	 m_muon_isTrigMatchedToChain.push_back( -1 );
 	 m_muon_listTrigChains.push_back("NONE");
-       }
+      }
 
     }
 
     if ( m_muInfoSwitch->m_isolation ) {
 
-      static SG::AuxElement::Accessor<char> isIsoLooseTrackOnlyAcc ("isIsolated_LooseTrackOnly");
-      static SG::AuxElement::Accessor<char> isIsoLooseAcc ("isIsolated_Loose");
-      static SG::AuxElement::Accessor<char> isIsoTightAcc ("isIsolated_Tight");
-      static SG::AuxElement::Accessor<char> isIsoGradientAcc ("isIsolated_Gradient");
-      static SG::AuxElement::Accessor<char> isIsoGradientLooseAcc ("isIsolated_GradientLoose");
-      static SG::AuxElement::Accessor<char> isIsoGradientT1Acc ("isIsolated_GradientT1");
-      static SG::AuxElement::Accessor<char> isIsoGradientT2Acc ("isIsolated_GradientT2");
-      static SG::AuxElement::Accessor<char> isIsoMU0p06Acc ("isIsolated_MU0p06");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutLooseAcc ("isIsolated_FixedCutLoose");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutTightAcc ("isIsolated_FixedCutTight");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutTightTrackOnlyAcc ("isIsolated_FixedCutTightTrackOnly");
-      static SG::AuxElement::Accessor<char> isIsoUserDefinedFixEfficiencyAcc ("isIsolated_UserDefinedFixEfficiency");
-      static SG::AuxElement::Accessor<char> isIsoUserDefinedCutAcc ("isIsolated_UserDefinedCut");
-
-      if ( isIsoLooseTrackOnlyAcc.isAvailable( *muon_itr ) ) { m_muon_isIsolated_LooseTrackOnly.push_back( isIsoLooseTrackOnlyAcc( *muon_itr ) ); } else { m_muon_isIsolated_LooseTrackOnly.push_back( -1 ); }
-      if ( isIsoLooseAcc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_Loose.push_back( isIsoLooseAcc( *muon_itr ) ); } else { m_muon_isIsolated_Loose.push_back( -1 ); }
-      if ( isIsoTightAcc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_Tight.push_back( isIsoTightAcc( *muon_itr ) ); } else { m_muon_isIsolated_Tight.push_back( -1 ); }
-      if ( isIsoGradientAcc.isAvailable( *muon_itr ) )       { m_muon_isIsolated_Gradient.push_back( isIsoGradientAcc( *muon_itr ) ); } else { m_muon_isIsolated_Gradient.push_back( -1 ); }
-      if ( isIsoGradientLooseAcc.isAvailable( *muon_itr ) )  { m_muon_isIsolated_GradientLoose.push_back( isIsoGradientLooseAcc( *muon_itr ) ); } else { m_muon_isIsolated_GradientLoose.push_back( -1 ); }
-      if ( isIsoGradientT1Acc.isAvailable( *muon_itr ) )     { m_muon_isIsolated_GradientT1.push_back( isIsoGradientT1Acc( *muon_itr ) ); } else { m_muon_isIsolated_GradientT1.push_back( -1 ); }
-      if ( isIsoGradientT2Acc.isAvailable( *muon_itr ) )     { m_muon_isIsolated_GradientT2.push_back( isIsoGradientT2Acc( *muon_itr ) ); } else { m_muon_isIsolated_GradientT2.push_back( -1 ); }
-      if ( isIsoMU0p06Acc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_MU0p06.push_back( isIsoMU0p06Acc( *muon_itr ) ); } else { m_muon_isIsolated_MU0p06.push_back( -1 ); }
-      if ( isIsoFixedCutLooseAcc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_FixedCutLoose.push_back( isIsoFixedCutLooseAcc( *muon_itr ) ); } else { m_muon_isIsolated_FixedCutLoose.push_back( -1 ); }
-      if ( isIsoFixedCutTightAcc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_FixedCutTight.push_back( isIsoFixedCutTightAcc( *muon_itr ) ); } else { m_muon_isIsolated_FixedCutTight.push_back( -1 ); }
-      if ( isIsoFixedCutTightTrackOnlyAcc.isAvailable( *muon_itr ) )          { m_muon_isIsolated_FixedCutTightTrackOnly.push_back( isIsoFixedCutTightTrackOnlyAcc( *muon_itr ) ); } else { m_muon_isIsolated_FixedCutTightTrackOnly.push_back( -1 ); }
-      if ( isIsoUserDefinedFixEfficiencyAcc.isAvailable( *muon_itr ) ) { m_muon_isIsolated_UserDefinedFixEfficiency.push_back( isIsoUserDefinedFixEfficiencyAcc( *muon_itr ) ); } else { m_muon_isIsolated_UserDefinedFixEfficiency.push_back( -1 ); }
-      if ( isIsoUserDefinedCutAcc.isAvailable( *muon_itr ) )           { m_muon_isIsolated_UserDefinedCut.push_back( isIsoUserDefinedCutAcc( *muon_itr ) ); } else { m_muon_isIsolated_UserDefinedCut.push_back( -1 ); }
+      this->FillIsolation( *muon_itr, m_muon_isoWPs );
 
       m_muon_ptcone20.push_back( muon_itr->isolation( xAOD::Iso::ptcone20 ) );
       m_muon_ptcone30.push_back( muon_itr->isolation( xAOD::Iso::ptcone30 ) );
@@ -713,16 +1097,14 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
       static SG::AuxElement::Accessor< std::vector< float > > accIsoSF_UserDefinedFixEfficiency("MuonEfficiencyCorrector_IsoSyst_UserDefinedFixEfficiency");
       static SG::AuxElement::Accessor< std::vector< float > > accIsoSF_UserDefinedCut("MuonEfficiencyCorrector_IsoSyst_UserDefinedCut");
 
-      std::vector<float> junk(1,-999);
-
-      if( accRecoSF.isAvailable( *muon_itr ) )               { m_muon_RecoEff_SF.push_back( accRecoSF( *muon_itr ) ); } else { m_muon_RecoEff_SF.push_back( junk ); }
-      if( accIsoSF_LooseTrackOnly.isAvailable( *muon_itr ) ) { m_muon_IsoEff_SF_LooseTrackOnly.push_back( accIsoSF_LooseTrackOnly( *muon_itr ) ); } else { m_muon_IsoEff_SF_LooseTrackOnly.push_back( junk ); }
-      if( accIsoSF_Loose.isAvailable( *muon_itr ) )          { m_muon_IsoEff_SF_Loose.push_back( accIsoSF_Loose( *muon_itr ) ); } else { m_muon_IsoEff_SF_Loose.push_back( junk ); }
-      if( accIsoSF_Tight.isAvailable( *muon_itr ) )          { m_muon_IsoEff_SF_Tight.push_back( accIsoSF_Tight( *muon_itr ) ); } else { m_muon_IsoEff_SF_Tight.push_back( junk ); }
-      if( accIsoSF_GradientLoose.isAvailable( *muon_itr ) )  { m_muon_IsoEff_SF_GradientLoose.push_back( accIsoSF_GradientLoose( *muon_itr ) ); } else {  m_muon_IsoEff_SF_GradientLoose.push_back( junk ); }
-      if( accIsoSF_Gradient.isAvailable( *muon_itr ) )       { m_muon_IsoEff_SF_Gradient.push_back( accIsoSF_Gradient( *muon_itr ) ); } else { m_muon_IsoEff_SF_Gradient.push_back( junk ); }
-      if( accIsoSF_UserDefinedFixEfficiency.isAvailable( *muon_itr ) )  { m_muon_IsoEff_SF_UserDefinedFixEfficiency.push_back( accIsoSF_UserDefinedFixEfficiency( *muon_itr ) ); } else { m_muon_IsoEff_SF_UserDefinedFixEfficiency.push_back( junk ); }
-      if( accIsoSF_UserDefinedCut.isAvailable( *muon_itr ) )            { m_muon_IsoEff_SF_UserDefinedCut.push_back( accIsoSF_UserDefinedCut( *muon_itr ) ); } else { m_muon_IsoEff_SF_UserDefinedCut.push_back( junk ); }
+      this->fillSF( *muon_itr, accRecoSF, m_muon_RecoEff_SF );
+      this->fillSF( *muon_itr, accIsoSF_LooseTrackOnly, m_muon_IsoEff_SF_LooseTrackOnly );
+      this->fillSF( *muon_itr, accIsoSF_Loose, m_muon_IsoEff_SF_Loose );
+      this->fillSF( *muon_itr, accIsoSF_Tight, m_muon_IsoEff_SF_Tight );
+      this->fillSF( *muon_itr, accIsoSF_GradientLoose, m_muon_IsoEff_SF_GradientLoose );
+      this->fillSF( *muon_itr, accIsoSF_Gradient, m_muon_IsoEff_SF_Gradient );
+      this->fillSF( *muon_itr, accIsoSF_UserDefinedFixEfficiency, m_muon_IsoEff_SF_UserDefinedFixEfficiency );
+      this->fillSF( *muon_itr, accIsoSF_UserDefinedCut, m_muon_IsoEff_SF_UserDefinedCut );
 
     }
 
@@ -754,6 +1136,8 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
 
 void HelpTreeBase::ClearMuons() {
 
+  this->WaitForWrite();
+
   m_nmuon = 0;
 
   if ( m_muInfoSwitch->m_kinematic ) {
@@ -827,14 +1211,14 @@ void HelpTreeBase::ClearMuons() {
   }
 
   if ( m_muInfoSwitch->m_effSF && m_isMC ) {
-    m_muon_RecoEff_SF.clear();
-    m_muon_IsoEff_SF_LooseTrackOnly.clear();
-    m_muon_IsoEff_SF_Loose.clear();
-    m_muon_IsoEff_SF_Tight.clear();
-    m_muon_IsoEff_SF_Gradient.clear();
-    m_muon_IsoEff_SF_GradientLoose.clear();
-    m_muon_IsoEff_SF_UserDefinedFixEfficiency.clear();
-    m_muon_IsoEff_SF_UserDefinedCut.clear();
+    this->clearSF( m_muon_RecoEff_SF );
+    this->clearSF( m_muon_IsoEff_SF_LooseTrackOnly );
+    this->clearSF( m_muon_IsoEff_SF_Loose );
+    this->clearSF( m_muon_IsoEff_SF_Tight );
+    this->clearSF( m_muon_IsoEff_SF_Gradient );
+    this->clearSF( m_muon_IsoEff_SF_GradientLoose );
+    this->clearSF( m_muon_IsoEff_SF_UserDefinedFixEfficiency );
+    this->clearSF( m_muon_IsoEff_SF_UserDefinedCut );
   }
 
   if ( m_muInfoSwitch->m_energyLoss ) {
@@ -862,6 +1246,7 @@ void HelpTreeBase::AddElectrons(const std::string detailStr) {
   if(m_debug)  Info("AddElectrons()", "Adding electron variables: %s", detailStr.c_str());
 
   m_elInfoSwitch = new HelperClasses::ElectronInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // always
   m_tree->Branch("nel",    &m_nel,"nel/I");
@@ -894,6 +1279,22 @@ void HelpTreeBase::AddElectrons(const std::string detailStr) {
     m_tree->Branch("el_isIsolated_FixedCutTightTrackOnly", &m_el_isIsolated_FixedCutTightTrackOnly);
     m_tree->Branch("el_isIsolated_UserDefinedFixEfficiency",    &m_el_isIsolated_UserDefinedFixEfficiency);
     m_tree->Branch("el_isIsolated_UserDefinedCut",              &m_el_isIsolated_UserDefinedCut);
+
+    m_el_isoWPs.clear();
+    m_el_isoWPs.push_back( IsolationWP( "LooseTrackOnly", &m_el_isIsolated_LooseTrackOnly ) );
+    m_el_isoWPs.push_back( IsolationWP( "Loose", &m_el_isIsolated_Loose ) );
+    m_el_isoWPs.push_back( IsolationWP( "Tight", &m_el_isIsolated_Tight ) );
+    m_el_isoWPs.push_back( IsolationWP( "Gradient", &m_el_isIsolated_Gradient ) );
+    m_el_isoWPs.push_back( IsolationWP( "GradientLoose", &m_el_isIsolated_GradientLoose ) );
+    m_el_isoWPs.push_back( IsolationWP( "GradientT1", &m_el_isIsolated_GradientT1 ) );
+    m_el_isoWPs.push_back( IsolationWP( "GradientT2", &m_el_isIsolated_GradientT2 ) );
+    m_el_isoWPs.push_back( IsolationWP( "EL0p06", &m_el_isIsolated_EL0p06 ) );
+    m_el_isoWPs.push_back( IsolationWP( "FixedCutLoose", &m_el_isIsolated_FixedCutLoose ) );
+    m_el_isoWPs.push_back( IsolationWP( "FixedCutTight", &m_el_isIsolated_FixedCutTight ) );
+    m_el_isoWPs.push_back( IsolationWP( "FixedCutTightTrackOnly", &m_el_isIsolated_FixedCutTightTrackOnly ) );
+    m_el_isoWPs.push_back( IsolationWP( "UserDefinedFixEfficiency", &m_el_isIsolated_UserDefinedFixEfficiency ) );
+    m_el_isoWPs.push_back( IsolationWP( "UserDefinedCut", &m_el_isIsolated_UserDefinedCut ) );
+
     m_tree->Branch("el_etcone20",	  &m_el_etcone20);
     m_tree->Branch("el_ptcone20",	  &m_el_ptcone20);
     m_tree->Branch("el_ptcone30",	  &m_el_ptcone30);
@@ -958,10 +1359,14 @@ void HelpTreeBase::AddElectrons(const std::string detailStr) {
   }
 
   this->AddElectronsUser();
+
+  this->setPrecision( m_elInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, const xAOD::Vertex* primaryVertex ) {
 
+  this->WaitForWrite();
+
   this->ClearElectrons();
   this->ClearElectronsUser();
 
@@ -973,6 +1378,15 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
   m_nel_IsEMMedium = 0;
   m_nel_IsEMTight = 0;
 
+  // list of chains for the TrigMatchingEngine decoration (see below)
+  //
+  const std::vector<std::string>* trigMatchChains(nullptr);
+  if ( m_elInfoSwitch->m_trigger ) {
+    static SG::AuxElement::ConstAccessor< std::vector<std::string> > trigMatchChainsAcc("isTrigMatchedVecElChains");
+    const xAOD::EventInfo* eventInfo = this->retrieveEventInfo("HelpTreeBase::FillElectrons()");
+    if ( eventInfo && trigMatchChainsAcc.isAvailable( *eventInfo ) ) { trigMatchChains = &trigMatchChainsAcc( *eventInfo ); }
+  }
+
   for ( auto el_itr : *(electrons) ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillElectrons()", "Filling electron w/ pT = %2f", el_itr->pt() / m_units ); }
@@ -991,50 +1405,38 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
       // retrieve map<string,char> w/ chain,isMatched
       //
       static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapElAcc("isTrigMatchedMapEl");
-
-      if ( isTrigMatchedMapElAcc.isAvailable( *el_itr ) ) {
+      // or, if matched w/ TrigMatchingEngine, vector<char> w/ isMatched for each chain in the list decorated on EventInfo
+      //
+      static SG::AuxElement::ConstAccessor< std::vector<char> > isTrigMatchedVecElAcc("isTrigMatchedVecEl");
+
+      bool foundTrigMatch(false);
+      // the TrigMatchingEngine vector if there is one, the map otherwise: the chains would be filled twice if both are there
+      if ( trigMatchChains && isTrigMatchedVecElAcc.isAvailable( *el_itr ) ) {
+	 const std::vector<char>& isTrigMatchedVec = isTrigMatchedVecElAcc( *el_itr );
+	 for ( unsigned int idx(0); idx < isTrigMatchedVec.size() && idx < trigMatchChains->size(); ++idx ) {
+	   m_el_isTrigMatchedToChain.push_back( static_cast<int>(isTrigMatchedVec.at(idx)) );
+	   m_el_listTrigChains.push_back( trigMatchChains->at(idx) );
+	 }
+	 foundTrigMatch = true;
+      } else if ( isTrigMatchedMapElAcc.isAvailable( *el_itr ) ) {
 	 // loop over map and fill branches
 	 //
 	 for ( auto const &it : (isTrigMatchedMapElAcc( *el_itr )) ) {
   	   m_el_isTrigMatchedToChain.push_back( static_cast<int>(it.second) );
 	   m_el_listTrigChains.push_back( it.first );
 	 }
-       } else {
+	 foundTrigMatch = true;
+      }
+      if ( !foundTrigMatch ) {
 	 m_el_isTrigMatchedToChain.push_back( -1 );
 	 m_el_listTrigChains.push_back("NONE");
-       }
+      }
 
     }
 
     if ( m_elInfoSwitch->m_isolation ) {
 
-      static SG::AuxElement::Accessor<char> isIsoLooseTrackOnlyAcc ("isIsolated_LooseTrackOnly");
-      static SG::AuxElement::Accessor<char> isIsoLooseAcc ("isIsolated_Loose");
-      static SG::AuxElement::Accessor<char> isIsoTightAcc ("isIsolated_Tight");
-      static SG::AuxElement::Accessor<char> isIsoGradientAcc ("isIsolated_Gradient");
-      static SG::AuxElement::Accessor<char> isIsoGradientLooseAcc ("isIsolated_GradientLoose");
-      static SG::AuxElement::Accessor<char> isIsoGradientT1Acc ("isIsolated_GradientT1");
-      static SG::AuxElement::Accessor<char> isIsoGradientT2Acc ("isIsolated_GradientT2");
-      static SG::AuxElement::Accessor<char> isIsoEL0p06Acc ("isIsolated_EL0p06");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutLooseAcc ("isIsolated_FixedCutLoose");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutTightAcc ("isIsolated_FixedCutTight");
-      static SG::AuxElement::Accessor<char> isIsoFixedCutTightTrackOnlyAcc ("isIsolated_FixedCutTightTrackOnly");
-      static SG::AuxElement::Accessor<char> isIsoUserDefinedFixEfficiencyAcc ("isIsolated_UserDefinedFixEfficiency");
-      static SG::AuxElement::Accessor<char> isIsoUserDefinedCutAcc ("isIsolated_UserDefinedCut");
-
-      if ( isIsoLooseTrackOnlyAcc.isAvailable( *el_itr ) ) { m_el_isIsolated_LooseTrackOnly.push_back( isIsoLooseTrackOnlyAcc( *el_itr ) ); } else { m_el_isIsolated_LooseTrackOnly.push_back( -1 ); }
-      if ( isIsoLooseAcc.isAvailable( *el_itr ) )          { m_el_isIsolated_Loose.push_back( isIsoLooseAcc( *el_itr ) ); } else { m_el_isIsolated_Loose.push_back( -1 ); }
-      if ( isIsoTightAcc.isAvailable( *el_itr ) )          { m_el_isIsolated_Tight.push_back( isIsoTightAcc( *el_itr ) ); } else { m_el_isIsolated_Tight.push_back( -1 ); }
-      if ( isIsoGradientAcc.isAvailable( *el_itr ) )       { m_el_isIsolated_Gradient.push_back( isIsoGradientAcc( *el_itr ) ); } else { m_el_isIsolated_Gradient.push_back( -1 ); }
-      if ( isIsoGradientLooseAcc.isAvailable( *el_itr ) )  { m_el_isIsolated_GradientLoose.push_back( isIsoGradientLooseAcc( *el_itr ) ); } else { m_el_isIsolated_GradientLoose.push_back( -1 ); }
-      if ( isIsoGradientT1Acc.isAvailable( *el_itr ) )     { m_el_isIsolated_GradientT1.push_back( isIsoGradientT1Acc( *el_itr ) ); } else { m_el_isIsolated_GradientT1.push_back( -1 ); }
-      if ( isIsoGradientT2Acc.isAvailable( *el_itr ) )     { m_el_isIsolated_GradientT2.push_back( isIsoGradientT2Acc( *el_itr ) ); } else { m_el_isIsolated_GradientT2.push_back( -1 ); }
-      if ( isIsoEL0p06Acc.isAvailable( *el_itr ) )          { m_el_isIsolated_EL0p06.push_back( isIsoEL0p06Acc( *el_itr ) ); } else { m_el_isIsolated_EL0p06.push_back( -1 ); }
-      if ( isIsoFixedCutLooseAcc.isAvailable( *el_itr ) )          { m_el_isIsolated_FixedCutLoose.push_back( isIsoFixedCutLooseAcc( *el_itr ) ); } else { m_el_isIsolated_FixedCutLoose.push_back( -1 ); }
-      if ( isIsoFixedCutTightAcc.isAvailable( *el_itr ) )          { m_el_isIsolated_FixedCutTight.push_back( isIsoFixedCutTightAcc( *el_itr ) ); } else { m_el_isIsolated_FixedCutTight.push_back( -1 ); }
-      if ( isIsoFixedCutTightTrackOnlyAcc.isAvailable( *el_itr ) )          { m_el_isIsolated_FixedCutTightTrackOnly.push_back( isIsoFixedCutTightTrackOnlyAcc( *el_itr ) ); } else { m_el_isIsolated_FixedCutTightTrackOnly.push_back( -1 ); }
-      if ( isIsoUserDefinedFixEfficiencyAcc.isAvailable( *el_itr ) ) { m_el_isIsolated_UserDefinedFixEfficiency.push_back( isIsoUserDefinedFixEfficiencyAcc( *el_itr ) ); } else { m_el_isIsolated_UserDefinedFixEfficiency.push_back( -1 ); }
-      if ( isIsoUserDefinedCutAcc.isAvailable( *el_itr ) )           { m_el_isIsolated_UserDefinedCut.push_back( isIsoUserDefinedCutAcc( *el_itr ) ); } else { m_el_isIsolated_UserDefinedCut.push_back( -1 ); }
+      this->FillIsolation( *el_itr, m_el_isoWPs );
 
       m_el_etcone20.push_back( el_itr->isolation( xAOD::Iso::etcone20 ) );
       m_el_ptcone20.push_back( el_itr->isolation( xAOD::Iso::ptcone20 ) );
@@ -1163,13 +1565,11 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
       static SG::AuxElement::Accessor< std::vector< float > > accPIDSF_LHMedium("ElectronEfficiencyCorrector_PIDSyst_LHMedium");
       static SG::AuxElement::Accessor< std::vector< float > > accPIDSF_LHTight("ElectronEfficiencyCorrector_PIDSyst_LHTight");
 
-      std::vector<float> junk(1,-999);
-
-      if( accRecoSF.isAvailable( *el_itr ) ) { m_el_RecoEff_SF.push_back( accRecoSF( *el_itr ) ); } else { m_el_RecoEff_SF.push_back( junk ); }
-      if( accPIDSF_LHVeryLoose.isAvailable( *el_itr ) ) { m_el_PIDEff_SF_LHVeryLoose.push_back( accPIDSF_LHVeryLoose( *el_itr ) ); } else { m_el_PIDEff_SF_LHVeryLoose.push_back( junk ); }
-      if( accPIDSF_LHLoose.isAvailable( *el_itr ) )     { m_el_PIDEff_SF_LHLoose.push_back( accPIDSF_LHLoose( *el_itr ) ); } else { m_el_PIDEff_SF_LHLoose.push_back( junk ); }
-      if( accPIDSF_LHMedium.isAvailable( *el_itr ) )    { m_el_PIDEff_SF_LHMedium.push_back( accPIDSF_LHMedium( *el_itr ) ); } else { m_el_PIDEff_SF_LHMedium.push_back( junk ); }
-      if( accPIDSF_LHTight.isAvailable( *el_itr ) )     { m_el_PIDEff_SF_LHTight.push_back( accPIDSF_LHTight( *el_itr ) ); } else { m_el_PIDEff_SF_LHTight.push_back( junk ); }
+      this->fillSF( *el_itr, accRecoSF, m_el_RecoEff_SF );
+      this->fillSF( *el_itr, accPIDSF_LHVeryLoose, m_el_PIDEff_SF_LHVeryLoose );
+      this->fillSF( *el_itr, accPIDSF_LHLoose, m_el_PIDEff_SF_LHLoose );
+      this->fillSF( *el_itr, accPIDSF_LHMedium, m_el_PIDEff_SF_LHMedium );
+      this->fillSF( *el_itr, accPIDSF_LHTight, m_el_PIDEff_SF_LHTight );
 
     }
 
@@ -1181,6 +1581,8 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
 
 void HelpTreeBase::ClearElectrons() {
 
+  this->WaitForWrite();
+
   m_nel = 0;
 
   if ( m_elInfoSwitch->m_kinematic ){
@@ -1265,11 +1667,11 @@ void HelpTreeBase::ClearElectrons() {
   }
 
   if( m_elInfoSwitch->m_effSF && m_isMC ) {
-    m_el_RecoEff_SF.clear();
-    m_el_PIDEff_SF_LHVeryLoose.clear();
-    m_el_PIDEff_SF_LHLoose.clear();
-    m_el_PIDEff_SF_LHMedium.clear();
-    m_el_PIDEff_SF_LHTight.clear();
+    this->clearSF( m_el_RecoEff_SF );
+    this->clearSF( m_el_PIDEff_SF_LHVeryLoose );
+    this->clearSF( m_el_PIDEff_SF_LHLoose );
+    this->clearSF( m_el_PIDEff_SF_LHMedium );
+    this->clearSF( m_el_PIDEff_SF_LHTight );
   }
 }
 
@@ -1284,6 +1686,7 @@ void HelpTreeBase::AddPhotons(const std::string detailStr) {
   if(m_debug)  Info("AddPhotons()", "Adding photon variables: %s", detailStr.c_str());
 
   m_phInfoSwitch = new HelperClasses::PhotonInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // always
   m_tree->Branch("nph",    &m_nph,"nph/I");
@@ -1324,10 +1727,14 @@ void HelpTreeBase::AddPhotons(const std::string detailStr) {
   }
 
   this->AddPhotonsUser();
+
+  this->setPrecision( m_phInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillPhotons( const xAOD::PhotonContainer* photons ) {
 
+  this->WaitForWrite();
+
   this->ClearPhotons();
   this->ClearPhotonsUser();
 
@@ -1412,6 +1819,8 @@ void HelpTreeBase::FillPhotons( const xAOD::PhotonContainer* photons ) {
 
 void HelpTreeBase::ClearPhotons() {
 
+  this->WaitForWrite();
+
   m_nph = 0;
 
   if ( m_phInfoSwitch->m_kinematic ){
@@ -1463,6 +1872,7 @@ void HelpTreeBase::AddJets(const std::string detailStr, const std::string jetNam
   if(m_debug) Info("AddJets()", "Adding jet %s with variables: %s", jetName.c_str(), detailStr.c_str());
 
   m_jetInfoSwitch = new HelperClasses::JetInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   m_jets[jetName] = new jetInfo();
 
@@ -1801,11 +2211,15 @@ void HelpTreeBase::AddJets(const std::string detailStr, const std::string jetNam
   }
 
   this->AddJetsUser(detailStr, jetName);
+
+  this->setPrecision( m_jetInfoSwitch, firstBranch );
 }
 
 
 void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation, const std::string jetName ) {
 
+  this->WaitForWrite();
+
   this->ClearJets(jetName);
 
   const xAOD::VertexContainer* vertices(nullptr);
@@ -1821,9 +2235,8 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation, con
 
   // Global event BTag SF weight (--> the product of each object's weight)
   //
-  if ( m_isMC ) {
-    const xAOD::EventInfo* eventInfo(nullptr);
-    HelperFunctions::retrieve(eventInfo, "EventInfo", m_event, m_store, false);
+  const xAOD::EventInfo* eventInfo = ( m_isMC ) ? this->retrieveEventInfo("HelpTreeBase::FillJets()") : nullptr;
+  if ( eventInfo ) {
 
 
     if( !m_jetInfoSwitch->m_sfFTagFix.empty() ) {
@@ -1912,6 +2325,8 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation, con
 
 void HelpTreeBase::FillJet( const xAOD::Jet* jet_itr, const xAOD::Vertex* pv, int pvLocation, const std::string jetName ) {
 
+  this->WaitForWrite();
+
   jetInfo* thisJet = m_jets[jetName];
 
   if( m_jetInfoSwitch->m_kinematic ){
@@ -2537,6 +2952,8 @@ void HelpTreeBase::FillJet( const xAOD::Jet* jet_itr, const xAOD::Vertex* pv, in
 
 void HelpTreeBase::ClearJets(const std::string jetName) {
 
+  this->WaitForWrite();
+
   jetInfo* thisJet = m_jets[jetName];
 
   thisJet->N = 0;
@@ -2689,42 +3106,42 @@ void HelpTreeBase::ClearJets(const std::string jetName) {
     thisJet->m_njet_mv2c20_Fix30 = 0;
     thisJet->m_jet_mv2c20_isFix30.clear();
     thisJet->m_weight_jet_mv2c20_sfFix30.clear();
-    thisJet->m_jet_mv2c20_sfFix30.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix30 );
 
     thisJet->m_njet_mv2c20_Fix50 = 0;
     thisJet->m_jet_mv2c20_isFix50.clear();
     thisJet->m_weight_jet_mv2c20_sfFix50.clear();
-    thisJet->m_jet_mv2c20_sfFix50.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix50 );
 
     thisJet->m_njet_mv2c20_Fix60 = 0;
     thisJet->m_jet_mv2c20_isFix60.clear();
     thisJet->m_weight_jet_mv2c20_sfFix60.clear();
-    thisJet->m_jet_mv2c20_sfFix60.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix60 );
 
     thisJet->m_njet_mv2c20_Fix70 = 0;
     thisJet->m_jet_mv2c20_isFix70.clear();
     thisJet->m_weight_jet_mv2c20_sfFix70.clear();
-    thisJet->m_jet_mv2c20_sfFix70.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix70 );
 
     thisJet->m_njet_mv2c20_Fix77 = 0;
     thisJet->m_jet_mv2c20_isFix77.clear();
     thisJet->m_weight_jet_mv2c20_sfFix77.clear();
-    thisJet->m_jet_mv2c20_sfFix77.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix77 );
 
     thisJet->m_njet_mv2c20_Fix80 = 0;
     thisJet->m_jet_mv2c20_isFix80.clear();
     thisJet->m_weight_jet_mv2c20_sfFix80.clear();
-    thisJet->m_jet_mv2c20_sfFix80.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix80 );
 
     thisJet->m_njet_mv2c20_Fix85 = 0;
     thisJet->m_jet_mv2c20_isFix85.clear();
     thisJet->m_weight_jet_mv2c20_sfFix85.clear();
-    thisJet->m_jet_mv2c20_sfFix85.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix85 );
 
     thisJet->m_njet_mv2c20_Fix90 = 0;
     thisJet->m_jet_mv2c20_isFix90.clear();
     thisJet->m_weight_jet_mv2c20_sfFix90.clear();
-    thisJet->m_jet_mv2c20_sfFix90.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFix90 );
   }
 
   if( !m_jetInfoSwitch->m_sfFTagFlt.empty() ) { // just clear them all....
@@ -2732,37 +3149,37 @@ void HelpTreeBase::ClearJets(const std::string jetName) {
     thisJet->m_njet_mv2c20_Flt30 = 0;
     thisJet->m_jet_mv2c20_isFlt30.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt30.clear();
-    thisJet->m_jet_mv2c20_sfFlt30.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt30 );
 
     thisJet->m_njet_mv2c20_Flt40 = 0;
     thisJet->m_jet_mv2c20_isFlt40.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt40.clear();
-    thisJet->m_jet_mv2c20_sfFlt40.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt40 );
 
     thisJet->m_njet_mv2c20_Flt50 = 0;
     thisJet->m_jet_mv2c20_isFlt50.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt50.clear();
-    thisJet->m_jet_mv2c20_sfFlt50.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt50 );
 
     thisJet->m_njet_mv2c20_Flt60 = 0;
     thisJet->m_jet_mv2c20_isFlt60.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt60.clear();
-    thisJet->m_jet_mv2c20_sfFlt60.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt60 );
 
     thisJet->m_njet_mv2c20_Flt70 = 0;
     thisJet->m_jet_mv2c20_isFlt70.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt70.clear();
-    thisJet->m_jet_mv2c20_sfFlt70.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt70 );
 
     thisJet->m_njet_mv2c20_Flt77 = 0;
     thisJet->m_jet_mv2c20_isFlt77.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt77.clear();
-    thisJet->m_jet_mv2c20_sfFlt77.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt77 );
 
     thisJet->m_njet_mv2c20_Flt85 = 0;
     thisJet->m_jet_mv2c20_isFlt85.clear();
     thisJet->m_weight_jet_mv2c20_sfFlt85.clear();
-    thisJet->m_jet_mv2c20_sfFlt85.clear();
+    this->clearSF( thisJet->m_jet_mv2c20_sfFlt85 );
   }
 
   if ( m_jetInfoSwitch->m_area ) {
@@ -2828,6 +3245,7 @@ void HelpTreeBase::AddTruthParts(const std::string truthName, const std::string
   if(m_debug) Info("AddTruthParts()", "Adding truth particle %s with variables: %s", truthName.c_str(), detailStr.c_str());
 
   m_truthInfoSwitch = new HelperClasses::TruthInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   m_truth[truthName] = new truthInfo();
 
@@ -2842,10 +3260,14 @@ void HelpTreeBase::AddTruthParts(const std::string truthName, const std::string
   }
 
   this->AddTruthUser(truthName);
+
+  this->setPrecision( m_truthInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillTruth( const std::string truthName, const xAOD::TruthParticleContainer* truthParts ) {
 
+  this->WaitForWrite();
+
   this->ClearTruth(truthName);
   this->ClearTruthUser(truthName);
 
@@ -2868,6 +3290,8 @@ void HelpTreeBase::FillTruth( const std::string truthName, const xAOD::TruthPart
 
 void HelpTreeBase::ClearTruth(const std::string truthName) {
 
+  this->WaitForWrite();
+
   m_truth[truthName]->N = 0;
   if( m_truthInfoSwitch->m_kinematic ){
     m_truth[truthName]->pt.clear();
@@ -2890,6 +3314,7 @@ void HelpTreeBase::AddFatJets(std::string detailStr) {
   if(m_debug) Info("AddFatJets()", "Adding fat jet variables: %s", detailStr.c_str());
 
   m_fatJetInfoSwitch = new HelperClasses::JetInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // always
   m_tree->Branch("nfatjets",    &m_nfatjet,"nfatjets/I");
@@ -2906,9 +3331,12 @@ void HelpTreeBase::AddFatJets(std::string detailStr) {
   }
 
   this->AddFatJetsUser();
+
+  this->setPrecision( m_fatJetInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillFatJets( const xAOD::JetContainer* fatJets ) {
+  this->WaitForWrite();
   this->ClearFatJets();
   this->ClearFatJetsUser();
 
@@ -2939,6 +3367,8 @@ void HelpTreeBase::FillFatJets( const xAOD::JetContainer* fatJets ) {
 
 void HelpTreeBase::ClearFatJets() {
 
+  this->WaitForWrite();
+
   m_nfatjet = 0;
   if( m_fatJetInfoSwitch->m_kinematic ){
     m_fatjet_pt.clear();
@@ -2954,6 +3384,7 @@ void HelpTreeBase::ClearFatJets() {
 }
 
 void HelpTreeBase::ClearEvent() {
+  this->WaitForWrite();
   m_runNumber = m_eventNumber = m_mcEventNumber = m_mcChannelNumber = m_bcid = m_lumiBlock;
   m_coreFlags = 0;
   m_mcEventWeight = 1.;
@@ -3001,6 +3432,10 @@ void HelpTreeBase::ClearEvent() {
     m_weight_electron_PIDEff_SF_LHTight.clear();
   }
 
+  if( m_eventInfoSwitch->m_eventWeights && m_isMC ) {
+    m_eventWeights.clear();
+  }
+
 }
 
 
@@ -3013,6 +3448,7 @@ void HelpTreeBase::ClearEvent() {
 void HelpTreeBase::AddTaus(const std::string detailStr) {
 
   m_tauInfoSwitch = new HelperClasses::TauInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   // always
   m_tree->Branch("ntau",   &m_ntau, "ntau/I");
@@ -3027,10 +3463,14 @@ void HelpTreeBase::AddTaus(const std::string detailStr) {
   }
 
   this->AddTausUser();
+
+  this->setPrecision( m_tauInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus ) {
 
+  this->WaitForWrite();
+
   this->ClearTaus();
   this->ClearTausUser();
 
@@ -3056,6 +3496,8 @@ void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus ) {
 
 void HelpTreeBase::ClearTaus() {
 
+  this->WaitForWrite();
+
   m_ntau = 0;
 
   if ( m_tauInfoSwitch->m_kinematic ){
@@ -3081,6 +3523,7 @@ void HelpTreeBase::AddMET( const std::string detailStr ) {
   if(m_debug) Info("AddMET()", "Adding MET variables: %s", detailStr.c_str());
 
   m_metInfoSwitch = new HelperClasses::METInfoSwitch( detailStr );
+  const int firstBranch = m_tree->GetListOfBranches()->GetEntries();
 
   m_tree->Branch("metFinalClus",	 &m_metFinalClus,      "metFinalClus/F");
   m_tree->Branch("metFinalClusPx",       &m_metFinalClusPx,    "metFinalClusPx/F");
@@ -3136,10 +3579,14 @@ void HelpTreeBase::AddMET( const std::string detailStr ) {
   }
 
   this->AddMETUser();
+
+  this->setPrecision( m_metInfoSwitch, firstBranch );
 }
 
 void HelpTreeBase::FillMET( const xAOD::MissingETContainer* met ) {
 
+  this->WaitForWrite();
+
   // Clear previous events
   this->ClearMET();
   this->ClearMETUser();
@@ -3214,6 +3661,8 @@ void HelpTreeBase::FillMET( const xAOD::MissingETContainer* met ) {
 
 void HelpTreeBase::ClearMET() {
 
+  this->WaitForWrite();
+
   m_metFinalClus      = -999;
   m_metFinalClusPx    = -999;
   m_metFinalClusPy    = -999;
@@ -3271,12 +3720,7 @@ void HelpTreeBase::Fill_Fix30( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix30.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix30("BTag_SF_FixedCutBEff_30");
-  if ( sfFix30.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix30.push_back( sfFix30( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix30.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix30, thisJet->m_jet_mv2c20_sfFix30 );
 }
 
 void HelpTreeBase::Fill_Fix50( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3287,12 +3731,7 @@ void HelpTreeBase::Fill_Fix50( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix50.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix50("BTag_SF_FixedCutBEff_50");
-  if ( sfFix50.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix50.push_back( sfFix50( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix50.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix50, thisJet->m_jet_mv2c20_sfFix50 );
 }
 
 void HelpTreeBase::Fill_Fix60( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3303,12 +3742,7 @@ void HelpTreeBase::Fill_Fix60( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix60.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix60("BTag_SF_FixedCutBEff_60");
-  if ( sfFix60.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix60.push_back( sfFix60( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix60.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix60, thisJet->m_jet_mv2c20_sfFix60 );
 }
 
 void HelpTreeBase::Fill_Fix70( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3319,12 +3753,7 @@ void HelpTreeBase::Fill_Fix70( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix70.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix70("BTag_SF_FixedCutBEff_70");
-  if ( sfFix70.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix70.push_back( sfFix70( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix70.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix70, thisJet->m_jet_mv2c20_sfFix70 );
 }
 
 void HelpTreeBase::Fill_Fix77( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3335,12 +3764,7 @@ void HelpTreeBase::Fill_Fix77( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix77.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix77("BTag_SF_FixedCutBEff_77");
-  if ( sfFix77.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix77.push_back( sfFix77( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix77.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix77, thisJet->m_jet_mv2c20_sfFix77 );
 }
 
 void HelpTreeBase::Fill_Fix80( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3351,12 +3775,7 @@ void HelpTreeBase::Fill_Fix80( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix80.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix80("BTag_SF_FixedCutBEff_80");
-  if ( sfFix80.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix80.push_back( sfFix80( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix80.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix80, thisJet->m_jet_mv2c20_sfFix80 );
 }
 
 void HelpTreeBase::Fill_Fix85( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3367,12 +3786,7 @@ void HelpTreeBase::Fill_Fix85( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix85.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix85("BTag_SF_FixedCutBEff_85");
-  if ( sfFix85.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix85.push_back( sfFix85( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix85.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix85, thisJet->m_jet_mv2c20_sfFix85 );
 }
 
 void HelpTreeBase::Fill_Fix90( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3383,12 +3797,7 @@ void HelpTreeBase::Fill_Fix90( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFix90.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFix90("BTag_SF_FixedCutBEff_90");
-  if ( sfFix90.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFix90.push_back( sfFix90( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFix90.push_back(junk);
-  }
+  this->fillSF( *jet, sfFix90, thisJet->m_jet_mv2c20_sfFix90 );
 }
 
 
@@ -3402,12 +3811,7 @@ void HelpTreeBase::Fill_Flt30( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt30.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt30("BTag_SF_FlatBEff_30");
-  if ( sfFlt30.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt30.push_back( sfFlt30( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt30.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt30, thisJet->m_jet_mv2c20_sfFlt30 );
 }
 
 void HelpTreeBase::Fill_Flt40( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3418,12 +3822,7 @@ void HelpTreeBase::Fill_Flt40( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt40.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt40("BTag_SF_FlatBEff_40");
-  if ( sfFlt40.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt40.push_back( sfFlt40( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt40.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt40, thisJet->m_jet_mv2c20_sfFlt40 );
 }
 
 void HelpTreeBase::Fill_Flt50( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3434,12 +3833,7 @@ void HelpTreeBase::Fill_Flt50( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt50.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt50("BTag_SF_FlatBEff_50");
-  if ( sfFlt50.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt50.push_back( sfFlt50( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt50.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt50, thisJet->m_jet_mv2c20_sfFlt50 );
 }
 
 void HelpTreeBase::Fill_Flt60( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3450,12 +3844,7 @@ void HelpTreeBase::Fill_Flt60( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt60.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt60("BTag_SF_FlatBEff_60");
-  if ( sfFlt60.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt60.push_back( sfFlt60( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt60.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt60, thisJet->m_jet_mv2c20_sfFlt60 );
 }
 
 void HelpTreeBase::Fill_Flt70( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3466,12 +3855,7 @@ void HelpTreeBase::Fill_Flt70( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt70.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt70("BTag_SF_FlatBEff_70");
-  if ( sfFlt70.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt70.push_back( sfFlt70( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt70.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt70, thisJet->m_jet_mv2c20_sfFlt70 );
 }
 
 void HelpTreeBase::Fill_Flt77( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3482,12 +3866,7 @@ void HelpTreeBase::Fill_Flt77( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt77.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt77("BTag_SF_FlatBEff_77");
-  if ( sfFlt77.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt77.push_back( sfFlt77( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt77.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt77, thisJet->m_jet_mv2c20_sfFlt77 );
 }
 
 void HelpTreeBase::Fill_Flt85( const xAOD::Jet* jet, jetInfo* thisJet ) {
@@ -3498,11 +3877,6 @@ void HelpTreeBase::Fill_Flt85( const xAOD::Jet* jet, jetInfo* thisJet ) {
   } else { thisJet->m_jet_mv2c20_isFlt85.push_back( -1 ); }
   if(!m_isMC) { return; }
   static SG::AuxElement::ConstAccessor< std::vector<float> > sfFlt85("BTag_SF_FlatBEff_85");
-  if ( sfFlt85.isAvailable( *jet ) ) {
-    thisJet->m_jet_mv2c20_sfFlt85.push_back( sfFlt85( *jet ) );
-  } else {
-    std::vector<float> junk(1,-999);
-    thisJet->m_jet_mv2c20_sfFlt85.push_back(junk);
-  }
+  this->fillSF( *jet, sfFlt85, thisJet->m_jet_mv2c20_sfFlt85 );
 }
 
@@ -90,6 +90,7 @@ namespace HelperClasses{
     m_caloClus      = has_exact("caloClusters");
     m_muonSF        = has_exact("muonSF");
     m_electronSF    = has_exact("electronSF");
+    m_eventWeights  = has_exact("eventWeights");
   }
 
   void TriggerInfoSwitch::initialize(){
@@ -133,6 +133,27 @@ std::string HelperFunctions::replaceString(std::string subject, const std::strin
   return subject;
 }
 
+int HelperFunctions::getIsolationWPBit( const std::string& WP )
+{
+  // the order must never change, as it defines the content of the 'isIsolatedBits' decoration
+  static const std::vector<std::string> isoWPs = { "LooseTrackOnly", "Loose", "Tight", "Gradient", "GradientLoose",
+                                                   "GradientT1", "GradientT2", "EL0p06", "MU0p06",
+                                                   "FixedCutLoose", "FixedCutTight", "FixedCutTightTrackOnly",
+                                                   "UserDefinedFixEfficiency", "UserDefinedCut" };
+
+  for ( unsigned int idx(0); idx < isoWPs.size(); ++idx ) {
+    if ( isoWPs.at(idx) == WP ) { return static_cast<int>(idx); }
+  }
+  return -1;
+}
+
+int HelperFunctions::getIsolationDecision( uint32_t isoBits, const std::string& WP )
+{
+  int bit = getIsolationWPBit( WP );
+  if ( bit < 0 || !( isoBits & ( 1u << ( bit + 16 ) ) ) ) { return -1; }
+  return ( isoBits & ( 1u << bit ) ) ? 1 : 0;
+}
+
 std::vector<TString> HelperFunctions::SplitString(TString& orig, const char separator)
 {
     // 'splitV' with the primitive strings
@@ -14,10 +14,13 @@
 
 #include "xAODAnaHelpers/HistogramManager.h"
 
+#include "TError.h"
+
 /* constructors and destructors */
 HistogramManager::HistogramManager(std::string name, std::string detailStr):
   m_name(name),
-  m_detailStr(detailStr)
+  m_detailStr(detailStr),
+  m_nominalWeight(1.0)
 {
 
   // if last character of name is a alphanumeric add a / so that
@@ -152,3 +155,119 @@ void HistogramManager::SetLabel(TH1* hist, std::string xlabel, std::string ylabe
   hist->GetZaxis()->SetTitle(zlabel.c_str());
   this->SetLabel(hist, xlabel, ylabel);
 }
+
+/* Weight channels */
+void HistogramManager::setWeightChannels(const std::vector<std::string>& channels, EL::Worker* wk)
+{
+  m_weightChannels = channels;
+  m_channelWeights.assign( m_weightChannels.size(), 1.0 );
+
+  for( auto hist : m_allHists ){
+    // the copies are put in a subdirectory named after the channel
+    std::string histName( hist->GetName() );
+    std::string histBase = ( histName.find(m_name) == 0 ) ? histName.substr( m_name.size() ) : histName;
+
+    std::vector< TH1* >& copies = m_channelHists[hist];
+    for( unsigned int iChannel = copies.size(); iChannel < m_weightChannels.size(); ++iChannel ){
+      TH1* tmp = static_cast<TH1*>( hist->Clone( (m_name + m_weightChannels.at(iChannel) + "/" + histBase).c_str() ) );
+      tmp->Reset();
+      copies.push_back( tmp );
+      if( wk ) { wk->addOutput( tmp ); }
+    }
+  }
+}
+
+void HistogramManager::setEventWeights(const std::vector<float>& weights)
+{
+  m_nominalWeight = ( weights.empty() ) ? 0.0 : weights.at(0);
+  for( unsigned int iChannel = 0; iChannel < m_channelWeights.size(); ++iChannel ){
+    // a missing channel gets the nominal weight
+    m_channelWeights.at(iChannel) = ( iChannel + 1 < weights.size() ) ? weights.at(iChannel + 1) : m_nominalWeight;
+  }
+}
+
+void HistogramManager::setEventWeights(const std::vector<std::string>& channels, const std::vector<float>& weights, EL::Worker* wk)
+{
+  if( m_weightChannels.size() != channels.size() ) { this->setWeightChannels( channels, wk ); }
+  this->setEventWeights( weights );
+}
+
+StatusCode HistogramManager::readEventWeights(const xAOD::EventInfo* eventInfo, const std::string& weightName, bool fillWeightSysts, xAOD::TStore* store,
+                                              float& eventWeight, const std::vector<float>*& weights, std::vector<std::string>& channels)
+{
+  eventWeight = 1.0;
+  weights = nullptr;
+
+  static SG::AuxElement::ConstAccessor< float > mcEvtWeightAcc("mcEventWeight");
+  const std::vector<float>* allWeights(nullptr);
+  if( !weightName.empty() && eventInfo->isAvailable< std::vector<float> >( weightName ) ) {
+    allWeights = &eventInfo->auxdataConst< std::vector<float> >( weightName );
+    if( !allWeights->empty() ) { eventWeight = allWeights->front(); }
+  } else if( mcEvtWeightAcc.isAvailable( *eventInfo ) ) {
+    eventWeight = mcEvtWeightAcc( *eventInfo );
+  }
+
+  // nothing else to do without weight systematics, e.g. on data
+  if( !fillWeightSysts || !allWeights || allWeights->size() <= 1 ) { return StatusCode::SUCCESS; }
+
+  // the names are the same in all the events
+  if( channels.empty() ) {
+    const std::string namesKey = weightName + "_Names";
+    const std::vector<std::string>* weightNames(nullptr);
+    if( !store || !store->contains< std::vector<std::string> >( namesKey ) || !store->retrieve( weightNames, namesKey ).isSuccess() ) {
+      Error("HistogramManager::readEventWeights()", "Cannot find the names of the weights %s in TStore", namesKey.c_str());
+      return StatusCode::FAILURE;
+    }
+    if( weightNames->size() != allWeights->size() ) {
+      Error("HistogramManager::readEventWeights()", "Found %lu names in %s for %lu weights", weightNames->size(), namesKey.c_str(), allWeights->size());
+      return StatusCode::FAILURE;
+    }
+    channels.assign( weightNames->begin() + 1, weightNames->end() );
+  }
+
+  weights = allWeights;
+  return StatusCode::SUCCESS;
+}
+
+int HistogramManager::fill(TH1F* hist, double x, double w)
+{
+  // TH1::Fill() returns the bin it filled, so that it does not need to be found again for each channel
+  int bin = hist->Fill(x, w);
+  this->fillChannels(hist, bin, w);
+  return bin;
+}
+
+int HistogramManager::fill(TH2F* hist, double x, double y, double w)
+{
+  int bin = hist->Fill(x, y, w);
+  this->fillChannels(hist, bin, w);
+  return bin;
+}
+
+int HistogramManager::fill(TH3F* hist, double x, double y, double z, double w)
+{
+  int bin = hist->Fill(x, y, z, w);
+  this->fillChannels(hist, bin, w);
+  return bin;
+}
+
+void HistogramManager::fillChannels(TH1* hist, int bin, double w)
+{
+  if( m_weightChannels.empty() || bin < 0 ) { return; }
+
+  auto copies_itr = m_channelHists.find( hist );
+  if( copies_itr == m_channelHists.end() ) { return; }
+
+  // the factor of the fill on top of the event weight (e.g. a per-object weight). The channels are filled with their own weight times that
+  // factor, not with a ratio to the nominal weight: a channel can be non-zero when the nominal weight is 0 (e.g. a SF of 0 in the nominal only).
+  // The factor is then unknown, and the fill is taken to be weighted by the event weight alone
+  const double factor = ( m_nominalWeight != 0 ) ? w / m_nominalWeight : 1.0;
+
+  for( unsigned int iChannel = 0; iChannel < copies_itr->second.size(); ++iChannel ){
+    TH1* copy = copies_itr->second[iChannel];
+    double wChannel = factor * m_channelWeights[iChannel];
+    copy->AddBinContent(bin, wChannel);
+    if( copy->GetSumw2N() ) { copy->GetSumw2()->fArray[bin] += wChannel * wChannel; }
+    copy->SetEntries( copy->GetEntries() + 1 );
+  }
+}
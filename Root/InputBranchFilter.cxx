@@ -0,0 +1,157 @@
+/******************************************
+ *
+ * Restrict the reading of the input tree
+ * to the branches actually used, learnt
+ * over the first events or read from a file.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <fstream>
+
+// package include(s):
+#include "xAODAnaHelpers/InputBranchFilter.h"
+
+// ROOT include(s):
+#include "TBranch.h"
+#include "TError.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+
+InputBranchFilter::InputBranchFilter( unsigned int learnEntries, bool disableUnused, Long64_t cacheSize ) :
+  m_learnEntries(learnEntries),
+  m_disableUnused(disableUnused),
+  m_cacheSize(cacheSize),
+  m_learning(learnEntries > 0),
+  m_nLearned(0)
+{ }
+
+InputBranchFilter::~InputBranchFilter() {}
+
+StatusCode InputBranchFilter::readList( const std::string& fileName )
+{
+  const std::string path = gSystem->ExpandPathName( fileName.c_str() );
+  std::ifstream in( path.c_str() );
+  if ( !in.is_open() ) {
+    Error("InputBranchFilter::readList()", "Cannot open the list of branches %s", path.c_str());
+    return StatusCode::FAILURE;
+  }
+
+  m_branches.clear();
+  std::string line;
+  while ( std::getline( in, line ) ) {
+    line = line.substr( 0, line.find('#') );
+    line.erase( 0, line.find_first_not_of(" \t") );
+    line.erase( line.find_last_not_of(" \t\r") + 1 );
+    if ( !line.empty() ) { m_branches.insert( line ); }
+  }
+
+  if ( m_branches.empty() ) {
+    Error("InputBranchFilter::readList()", "No branch in %s", path.c_str());
+    return StatusCode::FAILURE;
+  }
+
+  Info("InputBranchFilter::readList()", "Read %lu branches from %s", m_branches.size(), path.c_str());
+  m_learning = false;
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode InputBranchFilter::writeList( const std::string& fileName ) const
+{
+  std::ofstream out( fileName.c_str() );
+  if ( !out.is_open() ) {
+    Error("InputBranchFilter::writeList()", "Cannot write the list of branches to %s", fileName.c_str());
+    return StatusCode::FAILURE;
+  }
+
+  out << "# input branches read during the first " << m_nLearned << " events" << std::endl;
+  for ( const auto& branch : m_branches ) { out << branch << std::endl; }
+
+  Info("InputBranchFilter::writeList()", "Wrote %lu branches to %s", m_branches.size(), fileName.c_str());
+
+  return StatusCode::SUCCESS;
+}
+
+void InputBranchFilter::collect( TObjArray* branches )
+{
+  if ( !branches ) { return; }
+
+  for ( TObject* obj : *branches ) {
+    TBranch* branch = static_cast<TBranch*>( obj );
+    // -1 until the first GetEntry()
+    if ( branch->GetReadEntry() >= 0 ) { m_branches.insert( branch->GetName() ); }
+    this->collect( branch->GetListOfBranches() );
+  }
+}
+
+bool InputBranchFilter::learn( TTree* tree, bool countEvent )
+{
+  if ( !m_learning || !tree ) { return false; }
+
+  this->collect( tree->GetListOfBranches() );
+
+  if ( !countEvent ) { return false; }
+
+  // called at the start of each event: m_nLearned events have been fully processed
+  if ( m_nLearned < m_learnEntries ) {
+    ++m_nLearned;
+  } else {
+    m_learning = false;
+    Info("InputBranchFilter::learn()", "%lu of the input branches were read during the first %u events", m_branches.size(), m_nLearned);
+    this->apply( tree );
+    return true;
+  }
+
+  return false;
+}
+
+void InputBranchFilter::apply( TTree* tree ) const
+{
+  if ( m_learning || !tree ) { return; }
+
+  if ( m_disableUnused ) {
+    tree->SetBranchStatus( "*", 0 );
+    for ( const auto& branch : m_branches ) {
+      // the static list may come from a different kind of input
+      if ( !tree->GetBranch( branch.c_str() ) ) { continue; }
+      tree->SetBranchStatus( branch.c_str(), 1 );
+    }
+  }
+
+  if ( m_cacheSize > 0 ) { tree->SetCacheSize( m_cacheSize ); }
+  if ( tree->GetCacheSize() > 0 ) {
+    tree->DropBranchFromCache( "*", kTRUE );
+    for ( const auto& branch : m_branches ) {
+      if ( !tree->GetBranch( branch.c_str() ) ) { continue; }
+      tree->AddBranchToCache( branch.c_str(), kFALSE );
+    }
+    tree->StopCacheLearningPhase();
+  }
+}
+
+StatusCode InputBranchFilter::check( TTree* tree ) const
+{
+  if ( !m_disableUnused || m_learning || !tree ) { return StatusCode::SUCCESS; }
+
+  // TEvent sets the address of a branch when it connects it to a container or an aux variable. A disabled one
+  // is then never read, and the variables keep the values of the last event read before it was disabled
+  for ( TObject* obj : *tree->GetListOfBranches() ) {
+    TBranch* branch = static_cast<TBranch*>( obj );
+    if ( branch->TestBit( kDoNotProcess ) && branch->GetAddress() ) {
+      Error("InputBranchFilter::check()", "Branch %s is read, but has been disabled as it was not read during the learning phase. "
+            "Learn over more events, add it to the list of branches, or set DisableUnreadBranches to false", branch->GetName());
+      return StatusCode::FAILURE;
+    }
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+void InputBranchFilter::print() const
+{
+  Info("InputBranchFilter::print()", "Input branches read (%lu):", m_branches.size());
+  for ( const auto& branch : m_branches ) {
+    Info("InputBranchFilter::print()", "\t%s", branch.c_str());
+  }
+}
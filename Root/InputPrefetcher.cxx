@@ -0,0 +1,98 @@
+/******************************************
+ *
+ * Read the start and the end of the next
+ * input file in a background thread, to
+ * warm the page cache before it is opened.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// package include(s):
+#include "xAODAnaHelpers/InputPrefetcher.h"
+
+// ROOT include(s):
+#include "TError.h"
+
+InputPrefetcher::InputPrefetcher( const std::vector<std::string>& files, Long64_t headBytes, Long64_t tailBytes ) :
+  m_files(files),
+  m_headBytes(headBytes),
+  m_tailBytes(tailBytes)
+{ }
+
+InputPrefetcher::~InputPrefetcher()
+{
+  wait();
+}
+
+void InputPrefetcher::wait()
+{
+  if ( m_thread.joinable() ) { m_thread.join(); }
+}
+
+bool InputPrefetcher::prefetchNext( const std::string& currentFile )
+{
+  // the previous read is done by now, unless the current file was much shorter to process
+  wait();
+
+  // the current file, as given by EventLoop, can differ from the list by its protocol or directory
+  const std::string current = localPath( currentFile );
+  const std::string currentBase = current.substr( current.find_last_of('/') + 1 );
+  std::vector<std::string>::const_iterator it = std::find_if( m_files.begin(), m_files.end(),
+    [&]( const std::string& file ) { return localPath( file ) == current; } );
+  if ( it == m_files.end() ) {
+    it = std::find_if( m_files.begin(), m_files.end(),
+      [&]( const std::string& file ) { const std::string path = localPath( file ); return path.substr( path.find_last_of('/') + 1 ) == currentBase; } );
+  }
+  if ( it == m_files.end() || ++it == m_files.end() ) { return false; }
+
+  const std::string next = localPath( *it );
+  if ( next.empty() ) {
+    Info("InputPrefetcher::prefetchNext()", "Not prefetching %s: not a local file", it->c_str());
+    return false;
+  }
+
+  Info("InputPrefetcher::prefetchNext()", "Prefetching %s", next.c_str());
+  m_thread = std::thread( &InputPrefetcher::warm, next, m_headBytes, m_tailBytes );
+
+  return true;
+}
+
+std::string InputPrefetcher::localPath( const std::string& file )
+{
+  if ( file.compare( 0, 7, "file://" ) == 0 ) { return file.substr( 7 ); }
+  if ( file.compare( 0, 5, "file:" ) == 0 )   { return file.substr( 5 ); }
+  // any other protocol (root://, http://, dcap://, ...) is read by ROOT itself
+  if ( file.find("://") != std::string::npos || file.find(':') < file.find('/') ) { return ""; }
+  return file;
+}
+
+void InputPrefetcher::warm( std::string path, Long64_t headBytes, Long64_t tailBytes )
+{
+  // plain system calls only: the job keeps using ROOT in the main thread meanwhile
+  const int fd = open( path.c_str(), O_RDONLY );
+  if ( fd < 0 ) { return; }
+
+  struct stat st;
+  if ( fstat( fd, &st ) == 0 ) {
+    const Long64_t size = st.st_size;
+    const Long64_t head = std::min( headBytes, size );
+    const Long64_t tail = std::max( head, size - tailBytes );
+
+    // the pages read are kept by the system, the buffer is thrown away
+    const size_t bufSize = 1 << 20;
+    std::vector<char> buffer( bufSize );
+    for ( Long64_t offset = 0; offset < head; offset += bufSize ) {
+      if ( pread( fd, buffer.data(), std::min<Long64_t>( bufSize, head - offset ), offset ) <= 0 ) { break; }
+    }
+    for ( Long64_t offset = tail; offset < size; offset += bufSize ) {
+      if ( pread( fd, buffer.data(), std::min<Long64_t>( bufSize, size - offset ), offset ) <= 0 ) { break; }
+    }
+  }
+
+  close( fd );
+}
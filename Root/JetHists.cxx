@@ -315,12 +315,12 @@ StatusCode JetHists::execute( const xAOD::JetContainer* jets, float eventWeight,
 
     int numJets = std::min( m_infoSwitch->m_numLeadingJets, (int)jets->size() );
     for(int iJet=0; iJet < numJets; ++iJet){
-      m_NjetsPt.at(iJet)->        Fill( jets->at(iJet)->pt()/1e3,   eventWeight);
-      m_NjetsEta.at(iJet)->       Fill( jets->at(iJet)->eta(),      eventWeight);
-      m_NjetsPhi.at(iJet)->       Fill( jets->at(iJet)->phi(),      eventWeight);
-      m_NjetsM.at(iJet)->         Fill( jets->at(iJet)->m()/1e3,    eventWeight);
-      m_NjetsE.at(iJet)->         Fill( jets->at(iJet)->e()/1e3,    eventWeight);
-      m_NjetsRapidity.at(iJet)->  Fill( jets->at(iJet)->rapidity(), eventWeight);
+      fill( m_NjetsPt.at(iJet),         jets->at(iJet)->pt()/1e3,   eventWeight);
+      fill( m_NjetsEta.at(iJet),        jets->at(iJet)->eta(),      eventWeight);
+      fill( m_NjetsPhi.at(iJet),        jets->at(iJet)->phi(),      eventWeight);
+      fill( m_NjetsM.at(iJet),          jets->at(iJet)->m()/1e3,    eventWeight);
+      fill( m_NjetsE.at(iJet),          jets->at(iJet)->e()/1e3,    eventWeight);
+      fill( m_NjetsRapidity.at(iJet),   jets->at(iJet)->rapidity(), eventWeight);
     }
   }
 
@@ -332,18 +332,18 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
   if(m_debug) std::cout << "in execute " <<std::endl;
 
   //basic
-  m_jetPt ->        Fill( jet->pt()/1e3,    eventWeight );
-  m_jetEta->        Fill( jet->eta(),       eventWeight );
-  m_jetPhi->        Fill( jet->phi(),       eventWeight );
-  m_jetM->          Fill( jet->m()/1e3,     eventWeight );
-  m_jetE->          Fill( jet->e()/1e3,     eventWeight );
-  m_jetRapidity->   Fill( jet->rapidity(),  eventWeight );
+  fill( m_jetPt,          jet->pt()/1e3,    eventWeight );
+  fill( m_jetEta,         jet->eta(),       eventWeight );
+  fill( m_jetPhi,         jet->phi(),       eventWeight );
+  fill( m_jetM,           jet->m()/1e3,     eventWeight );
+  fill( m_jetE,           jet->e()/1e3,     eventWeight );
+  fill( m_jetRapidity,    jet->rapidity(),  eventWeight );
 
   // kinematic
   if( m_infoSwitch->m_kinematic ) {
-    m_jetPx->  Fill( jet->px()/1e3,  eventWeight );
-    m_jetPy->  Fill( jet->py()/1e3,  eventWeight );
-    m_jetPz->  Fill( jet->pz()/1e3,  eventWeight );
+    fill( m_jetPx,   jet->px()/1e3,  eventWeight );
+    fill( m_jetPy,   jet->py()/1e3,  eventWeight );
+    fill( m_jetPz,   jet->pz()/1e3,  eventWeight );
   } // fillKinematic
 
   // clean
@@ -351,38 +351,38 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
     static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
     if( jetTime.isAvailable( *jet ) ) {
-      m_jetTime ->  Fill( jetTime( *jet ), eventWeight );
+      fill( m_jetTime,    jetTime( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> LArQuality ("LArQuality");
     if( LArQuality.isAvailable( *jet ) ) {
-      m_LArQuality ->  Fill( LArQuality( *jet ), eventWeight );
+      fill( m_LArQuality,    LArQuality( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> hecq ("HECQuality");
     if( hecq.isAvailable( *jet ) ) {
-      m_hecq ->  Fill( hecq( *jet ), eventWeight );
+      fill( m_hecq,    hecq( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> negE ("NegativeE");
     if( negE.isAvailable( *jet ) ) {
-      m_negE ->  Fill( negE( *jet ), eventWeight );
+      fill( m_negE,    negE( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> avLArQF ("AverageLArQF");
     if( avLArQF.isAvailable( *jet ) ) {
-      m_avLArQF ->  Fill( avLArQF( *jet ), eventWeight );
+      fill( m_avLArQF,    avLArQF( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> bchCorrCell ("BchCorrCell");
     if( bchCorrCell.isAvailable( *jet ) ) {
-      m_bchCorrCell ->  Fill( bchCorrCell( *jet ), eventWeight );
+      fill( m_bchCorrCell,    bchCorrCell( *jet ), eventWeight );
     }
 
     // 0062       N90Cells?
     static SG::AuxElement::ConstAccessor<float> N90Const ("N90Constituents");
     if( N90Const.isAvailable( *jet ) ) {
-      m_N90Const ->  Fill( N90Const( *jet ), eventWeight );
+      fill( m_N90Const,    N90Const( *jet ), eventWeight );
     }
 
 
@@ -405,39 +405,39 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
     static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
     if( HECf.isAvailable( *jet ) ) {
-      m_HECf ->  Fill( HECf( *jet ), eventWeight );
+      fill( m_HECf,    HECf( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> EMf ("EMFrac");
     if( EMf.isAvailable( *jet ) ) {
-      m_EMf ->  Fill( EMf( *jet ), eventWeight );
+      fill( m_EMf,    EMf( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> centroidR ("CentroidR");
     if( centroidR.isAvailable( *jet ) ) {
-      m_centroidR ->  Fill( centroidR( *jet ), eventWeight );
+      fill( m_centroidR,    centroidR( *jet ), eventWeight );
     }
 
     /*
 
     static SG::AuxElement::ConstAccessor<float> samplingMax ("SamplingMax");
     if( samplingMax.isAvailable( *jet ) ) {
-      m_samplingMax ->  Fill( samplingMax( *jet ), eventWeight );
+      fill( m_samplingMax,    samplingMax( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> ePerSamp ("EnergyPerSampling");
     if( ePerSamp.isAvailable( *jet ) ) {
-      m_ePerSamp ->  Fill( ePerSamp( *jet ), eventWeight );
+      fill( m_ePerSamp,    ePerSamp( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> fracSampMax ("FracSamplingMax");
     if( fracSampMax.isAvailable( *jet ) ) {
-      m_fracSampMax ->  Fill( fracSampMax( *jet ), eventWeight );
+      fill( m_fracSampMax,    fracSampMax( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> lowEtFrac ("LowEtConstituentsFrac");
     if( lowEtFrac.isAvailable( *jet ) ) {
-      m_lowEtFrac ->  Fill( lowEtFrac( *jet ), eventWeight );
+      fill( m_lowEtFrac,    lowEtFrac( *jet ), eventWeight );
     }
 
  // 0036       Offset,
@@ -451,30 +451,30 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     if( ePerSamp.isAvailable( *jet ) ) {
       vector<float> ePerSampVals = ePerSamp( *jet );
       float jetE = jet->e();
-      m_PreSamplerB -> Fill( ePerSampVals.at(0) / jetE );
-      m_EMB1        -> Fill( ePerSampVals.at(1) / jetE );
-      m_EMB2        -> Fill( ePerSampVals.at(2) / jetE );
-      m_EMB3        -> Fill( ePerSampVals.at(3) / jetE );
-      m_PreSamplerE -> Fill( ePerSampVals.at(4) / jetE );
-      m_EME1        -> Fill( ePerSampVals.at(5) / jetE );
-      m_EME2        -> Fill( ePerSampVals.at(6) / jetE );
-      m_EME3        -> Fill( ePerSampVals.at(7) / jetE );
-      m_HEC0        -> Fill( ePerSampVals.at(8) / jetE );
-      m_HEC1        -> Fill( ePerSampVals.at(9) / jetE );
-      m_HEC2        -> Fill( ePerSampVals.at(10) / jetE );
-      m_HEC3        -> Fill( ePerSampVals.at(11) / jetE );
-      m_TileBar0    -> Fill( ePerSampVals.at(12) / jetE );
-      m_TileBar1    -> Fill( ePerSampVals.at(13) / jetE );
-      m_TileBar2    -> Fill( ePerSampVals.at(14) / jetE );
-      m_TileGap1    -> Fill( ePerSampVals.at(15) / jetE );
-      m_TileGap2    -> Fill( ePerSampVals.at(16) / jetE );
-      m_TileGap3    -> Fill( ePerSampVals.at(17) / jetE );
-      m_TileExt0    -> Fill( ePerSampVals.at(18) / jetE );
-      m_TileExt1    -> Fill( ePerSampVals.at(19) / jetE );
-      m_TileExt2    -> Fill( ePerSampVals.at(20) / jetE );
-      m_FCAL0       -> Fill( ePerSampVals.at(21) / jetE );
-      m_FCAL1       -> Fill( ePerSampVals.at(22) / jetE );
-      m_FCAL2       -> Fill( ePerSampVals.at(23) / jetE );
+      fill( m_PreSamplerB,   ePerSampVals.at(0) / jetE );
+      fill( m_EMB1,          ePerSampVals.at(1) / jetE );
+      fill( m_EMB2,          ePerSampVals.at(2) / jetE );
+      fill( m_EMB3,          ePerSampVals.at(3) / jetE );
+      fill( m_PreSamplerE,   ePerSampVals.at(4) / jetE );
+      fill( m_EME1,          ePerSampVals.at(5) / jetE );
+      fill( m_EME2,          ePerSampVals.at(6) / jetE );
+      fill( m_EME3,          ePerSampVals.at(7) / jetE );
+      fill( m_HEC0,          ePerSampVals.at(8) / jetE );
+      fill( m_HEC1,          ePerSampVals.at(9) / jetE );
+      fill( m_HEC2,          ePerSampVals.at(10) / jetE );
+      fill( m_HEC3,          ePerSampVals.at(11) / jetE );
+      fill( m_TileBar0,      ePerSampVals.at(12) / jetE );
+      fill( m_TileBar1,      ePerSampVals.at(13) / jetE );
+      fill( m_TileBar2,      ePerSampVals.at(14) / jetE );
+      fill( m_TileGap1,      ePerSampVals.at(15) / jetE );
+      fill( m_TileGap2,      ePerSampVals.at(16) / jetE );
+      fill( m_TileGap3,      ePerSampVals.at(17) / jetE );
+      fill( m_TileExt0,      ePerSampVals.at(18) / jetE );
+      fill( m_TileExt1,      ePerSampVals.at(19) / jetE );
+      fill( m_TileExt2,      ePerSampVals.at(20) / jetE );
+      fill( m_FCAL0,         ePerSampVals.at(21) / jetE );
+      fill( m_FCAL1,         ePerSampVals.at(22) / jetE );
+      fill( m_FCAL2,         ePerSampVals.at(23) / jetE );
     }
   }
 
@@ -486,32 +486,32 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
     static SG::AuxElement::ConstAccessor<int> actArea ("ActiveArea");
     if( actArea.isAvailable( *jet ) ) {
-      m_actArea ->  Fill( actArea( *jet ), eventWeight );
+      fill( m_actArea,    actArea( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> voroniA ("VoronoiArea");
     if( voroniA.isAvailable( *jet ) ) {
-      m_voroniA ->  Fill( voroniA( *jet ), eventWeight );
+      fill( m_voroniA,    voroniA( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> voroniAE ("VoronoiAreaE");
     if( voroniAE.isAvailable( *jet ) ) {
-      m_voroniAE ->  Fill( voroniAE( *jet ), eventWeight );
+      fill( m_voroniAE,    voroniAE( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> voroniAPx ("VoronoiAreaPx");
     if( voroniAPx.isAvailable( *jet ) ) {
-      m_voroniAPx ->  Fill( voroniAPx( *jet ), eventWeight );
+      fill( m_voroniAPx,    voroniAPx( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> voroniAPy ("CentroidR");
     if( voroniAPy.isAvailable( *jet ) ) {
-      m_voroniAPy ->  Fill( voroniAPy( *jet ), eventWeight );
+      fill( m_voroniAPy,    voroniAPy( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> voroniAPz ("CentroidR");
     if( voroniAPz.isAvailable( *jet ) ) {
-      m_voroniAPz ->  Fill( voroniAPz( *jet ), eventWeight );
+      fill( m_voroniAPz,    voroniAPz( *jet ), eventWeight );
     }
 
   }
@@ -551,7 +551,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     // 0029       KtDR,
     static SG::AuxElement::ConstAccessor<int> ktDR ("KtDR");
     if( ktDR.isAvailable( *jet ) ) {
-      m_ktDR ->  Fill( ktDR( *jet ), eventWeight );
+      fill( m_ktDR,    ktDR( *jet ), eventWeight );
     }
  // 0050       YFlip12,
  // 0051       YFlip13,
@@ -589,37 +589,37 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
     static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
     if( TruthLabelID.isAvailable( *jet ) ) {
-      m_truthLabelID ->  Fill( TruthLabelID( *jet ), eventWeight );
+      fill( m_truthLabelID,    TruthLabelID( *jet ), eventWeight );
     }else{
       static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
       if( PartonTruthLabelID.isAvailable( *jet ) ) {
-	m_truthLabelID ->  Fill( PartonTruthLabelID( *jet ), eventWeight );
+	fill( m_truthLabelID,    PartonTruthLabelID( *jet ), eventWeight );
       }
     }
 
     static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
     if( TruthCount.isAvailable( *jet ) ) {
-      m_truthCount ->  Fill( TruthCount( *jet ), eventWeight );
+      fill( m_truthCount,    TruthCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
     if( TruthPt.isAvailable( *jet ) ) {
-      m_truthPt ->  Fill( TruthPt( *jet )/1000, eventWeight );
+      fill( m_truthPt,    TruthPt( *jet )/1000, eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
     if( TruthLabelDeltaR_B.isAvailable( *jet ) ) {
-      m_truthDr_B ->  Fill( TruthLabelDeltaR_B( *jet ), eventWeight );
+      fill( m_truthDr_B,    TruthLabelDeltaR_B( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
     if( TruthLabelDeltaR_C.isAvailable( *jet ) ) {
-      m_truthDr_C ->  Fill( TruthLabelDeltaR_C( *jet ), eventWeight );
+      fill( m_truthDr_C,    TruthLabelDeltaR_C( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
     if( TruthLabelDeltaR_T.isAvailable( *jet ) ) {
-      m_truthDr_T ->  Fill( TruthLabelDeltaR_T( *jet ), eventWeight );
+      fill( m_truthDr_T,    TruthLabelDeltaR_T( *jet ), eventWeight );
     }
 
   }
@@ -632,32 +632,32 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     //
     static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
     if( GhostBHadronsFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_BhadFinal ->  Fill( GhostBHadronsFinalCount( *jet ), eventWeight );
+      fill( m_truthCount_BhadFinal,    GhostBHadronsFinalCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
     if( GhostBHadronsInitialCount.isAvailable( *jet ) ) {
-      m_truthCount_BhadInit ->  Fill( GhostBHadronsInitialCount( *jet ), eventWeight );
+      fill( m_truthCount_BhadInit,    GhostBHadronsInitialCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
     if( GhostBQuarksFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_BQFinal ->  Fill( GhostBQuarksFinalCount( *jet ), eventWeight );
+      fill( m_truthCount_BQFinal,    GhostBQuarksFinalCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
     if( GhostBHadronsFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_BhadFinal ->  Fill( GhostBHadronsFinalPt( *jet ), eventWeight );
+      fill( m_truthPt_BhadFinal,    GhostBHadronsFinalPt( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
     if( GhostBHadronsInitialPt.isAvailable( *jet ) ) {
-      m_truthPt_BhadInit ->  Fill( GhostBHadronsInitialPt( *jet ), eventWeight );
+      fill( m_truthPt_BhadInit,    GhostBHadronsInitialPt( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
     if( GhostBQuarksFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_BQFinal ->  Fill( GhostBQuarksFinalPt( *jet ), eventWeight );
+      fill( m_truthPt_BQFinal,    GhostBQuarksFinalPt( *jet ), eventWeight );
     }
 
 
@@ -666,32 +666,32 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     //
     static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
     if( GhostCHadronsFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_ChadFinal ->  Fill( GhostCHadronsFinalCount( *jet ), eventWeight );
+      fill( m_truthCount_ChadFinal,    GhostCHadronsFinalCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
     if( GhostCHadronsInitialCount.isAvailable( *jet ) ) {
-      m_truthCount_ChadInit ->  Fill( GhostCHadronsInitialCount( *jet ), eventWeight );
+      fill( m_truthCount_ChadInit,    GhostCHadronsInitialCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
     if( GhostCQuarksFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_CQFinal ->  Fill( GhostCQuarksFinalCount( *jet ), eventWeight );
+      fill( m_truthCount_CQFinal,    GhostCQuarksFinalCount( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
     if( GhostCHadronsFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_ChadFinal ->  Fill( GhostCHadronsFinalPt( *jet ), eventWeight );
+      fill( m_truthPt_ChadFinal,    GhostCHadronsFinalPt( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
     if( GhostCHadronsInitialPt.isAvailable( *jet ) ) {
-      m_truthPt_ChadInit ->  Fill( GhostCHadronsInitialPt( *jet ), eventWeight );
+      fill( m_truthPt_ChadInit,    GhostCHadronsInitialPt( *jet ), eventWeight );
     }
 
     static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
     if( GhostCQuarksFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_CQFinal ->  Fill( GhostCQuarksFinalPt( *jet ), eventWeight );
+      fill( m_truthPt_CQFinal,    GhostCQuarksFinalPt( *jet ), eventWeight );
     }
 
 
@@ -700,13 +700,13 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     //
     static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
     if( GhostTausFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_TausFinal ->  Fill( GhostTausFinalCount( *jet ), eventWeight );
+      fill( m_truthCount_TausFinal,    GhostTausFinalCount( *jet ), eventWeight );
     }
 
 
     static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
     if( GhostTausFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_TausFinal ->  Fill( GhostTausFinalPt( *jet ), eventWeight );
+      fill( m_truthPt_TausFinal,    GhostTausFinalPt( *jet ), eventWeight );
     }
 
 
@@ -730,19 +730,19 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     btag_info->MVx_discriminant("MV2c00", MV2c00);
     btag_info->MVx_discriminant("MV2c10", MV2c10);
     btag_info->MVx_discriminant("MV2c20", MV2c20);
-    m_MV2c00 ->  Fill( MV2c00, eventWeight );
-    m_MV2c10 ->  Fill( MV2c10, eventWeight );
-    m_MV2c20 ->  Fill( MV2c20, eventWeight );
+    fill( m_MV2c00,    MV2c00, eventWeight );
+    fill( m_MV2c10,    MV2c10, eventWeight );
+    fill( m_MV2c20,    MV2c20, eventWeight );
 
     static SG::AuxElement::ConstAccessor<double> SV0_significance3DAcc ("SV0_significance3D");
     if ( SV0_significance3DAcc.isAvailable(*btag_info) ) {
-      m_SV0             ->  Fill( btag_info->SV0_significance3D() , eventWeight );
-      m_SV1             ->  Fill( btag_info->SV1_loglikelihoodratio() , eventWeight );
-      m_IP2D            ->  Fill( btag_info->IP2D_loglikelihoodratio() , eventWeight );
-      m_IP3D            ->  Fill( btag_info->IP3D_loglikelihoodratio() , eventWeight );
-      m_COMB            ->  Fill( btag_info->SV1_loglikelihoodratio() + btag_info->IP3D_loglikelihoodratio() , eventWeight );
-      m_JetFitter       ->  Fill( btag_info->JetFitter_loglikelihoodratio() , eventWeight );
-      m_JetFitterCombNN ->  Fill( btag_info->JetFitterCombNN_loglikelihoodratio() , eventWeight );
+      fill( m_SV0,                btag_info->SV0_significance3D() , eventWeight );
+      fill( m_SV1,                btag_info->SV1_loglikelihoodratio() , eventWeight );
+      fill( m_IP2D,               btag_info->IP2D_loglikelihoodratio() , eventWeight );
+      fill( m_IP3D,               btag_info->IP3D_loglikelihoodratio() , eventWeight );
+      fill( m_COMB,               btag_info->SV1_loglikelihoodratio() + btag_info->IP3D_loglikelihoodratio() , eventWeight );
+      fill( m_JetFitter,          btag_info->JetFitter_loglikelihoodratio() , eventWeight );
+      fill( m_JetFitterCombNN,    btag_info->JetFitterCombNN_loglikelihoodratio() , eventWeight );
     }
 
     if(m_infoSwitch->m_jetFitterDetails){
@@ -759,17 +759,17 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
       static SG::AuxElement::ConstAccessor< double > jf_pc           ("JetFitter_pc");
       static SG::AuxElement::ConstAccessor< double > jf_pu           ("JetFitter_pu");
 
-      if(jf_nVTXAcc.isAvailable       (*btag_info)) m_jf_nVTX           ->Fill(jf_nVTXAcc       (*btag_info), eventWeight);
-      if(jf_nSingleTracks.isAvailable (*btag_info)) m_jf_nSingleTracks  ->Fill(jf_nSingleTracks (*btag_info), eventWeight);
-      if(jf_nTracksAtVtx.isAvailable  (*btag_info)) m_jf_nTracksAtVtx   ->Fill(jf_nTracksAtVtx  (*btag_info), eventWeight);
-      if(jf_mass.isAvailable          (*btag_info)) m_jf_mass           ->Fill(jf_mass          (*btag_info)/1000, eventWeight);
-      if(jf_energyFraction.isAvailable(*btag_info)) m_jf_energyFraction ->Fill(jf_energyFraction(*btag_info), eventWeight);
-      if(jf_significance3d.isAvailable(*btag_info)) m_jf_significance3d ->Fill(jf_significance3d(*btag_info), eventWeight);
-      if(jf_deltaeta.isAvailable      (*btag_info)) m_jf_deltaeta       ->Fill(jf_deltaeta      (*btag_info), eventWeight);
-      if(jf_deltaphi.isAvailable      (*btag_info)) m_jf_deltaphi       ->Fill(jf_deltaphi      (*btag_info), eventWeight);
-      if(jf_N2Tpar.isAvailable        (*btag_info)) m_jf_N2Tpar         ->Fill(jf_N2Tpar        (*btag_info), eventWeight);
-      if(jf_pb.isAvailable            (*btag_info)) m_jf_pb             ->Fill(jf_pb            (*btag_info), eventWeight);
-      if(jf_pu.isAvailable            (*btag_info)) m_jf_pu             ->Fill(jf_pu            (*btag_info), eventWeight);
+      if(jf_nVTXAcc.isAvailable       (*btag_info)) fill( m_jf_nVTX,           jf_nVTXAcc       (*btag_info), eventWeight);
+      if(jf_nSingleTracks.isAvailable (*btag_info)) fill( m_jf_nSingleTracks,  jf_nSingleTracks (*btag_info), eventWeight);
+      if(jf_nTracksAtVtx.isAvailable  (*btag_info)) fill( m_jf_nTracksAtVtx,   jf_nTracksAtVtx  (*btag_info), eventWeight);
+      if(jf_mass.isAvailable          (*btag_info)) fill( m_jf_mass,           jf_mass          (*btag_info)/1000, eventWeight);
+      if(jf_energyFraction.isAvailable(*btag_info)) fill( m_jf_energyFraction, jf_energyFraction(*btag_info), eventWeight);
+      if(jf_significance3d.isAvailable(*btag_info)) fill( m_jf_significance3d, jf_significance3d(*btag_info), eventWeight);
+      if(jf_deltaeta.isAvailable      (*btag_info)) fill( m_jf_deltaeta,       jf_deltaeta      (*btag_info), eventWeight);
+      if(jf_deltaphi.isAvailable      (*btag_info)) fill( m_jf_deltaphi,       jf_deltaphi      (*btag_info), eventWeight);
+      if(jf_N2Tpar.isAvailable        (*btag_info)) fill( m_jf_N2Tpar,         jf_N2Tpar        (*btag_info), eventWeight);
+      if(jf_pb.isAvailable            (*btag_info)) fill( m_jf_pb,             jf_pb            (*btag_info), eventWeight);
+      if(jf_pu.isAvailable            (*btag_info)) fill( m_jf_pu,             jf_pu            (*btag_info), eventWeight);
     }
 
 
@@ -789,11 +789,11 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
       static SG::AuxElement::ConstAccessor< float   > sv0_efracsvxAcc     ("SV0_efracsvx");                                                                  	/// @brief SV0 : 3D vertex significance
       static SG::AuxElement::ConstAccessor< float   > sv0_normdistAcc     ("SV0_normdist");
 
-      if(sv0_NGTinSvxAcc .isAvailable(*btag_info)) m_sv0_NGTinSvx -> Fill( sv0_NGTinSvxAcc (*btag_info), eventWeight);
-      if(sv0_N2TpairAcc  .isAvailable(*btag_info)) m_sv0_N2Tpair  -> Fill( sv0_N2TpairAcc  (*btag_info), eventWeight);
-      if(sv0_masssvxAcc  .isAvailable(*btag_info)) m_sv0_massvx   -> Fill( sv0_masssvxAcc  (*btag_info)/1000, eventWeight);
-      if(sv0_efracsvxAcc .isAvailable(*btag_info)) m_sv0_efracsvx -> Fill( sv0_efracsvxAcc (*btag_info), eventWeight);
-      if(sv0_normdistAcc .isAvailable(*btag_info)) m_sv0_normdist -> Fill( sv0_normdistAcc (*btag_info), eventWeight);
+      if(sv0_NGTinSvxAcc .isAvailable(*btag_info)) fill( m_sv0_NGTinSvx,   sv0_NGTinSvxAcc (*btag_info), eventWeight);
+      if(sv0_N2TpairAcc  .isAvailable(*btag_info)) fill( m_sv0_N2Tpair,    sv0_N2TpairAcc  (*btag_info), eventWeight);
+      if(sv0_masssvxAcc  .isAvailable(*btag_info)) fill( m_sv0_massvx,     sv0_masssvxAcc  (*btag_info)/1000, eventWeight);
+      if(sv0_efracsvxAcc .isAvailable(*btag_info)) fill( m_sv0_efracsvx,   sv0_efracsvxAcc (*btag_info), eventWeight);
+      if(sv0_normdistAcc .isAvailable(*btag_info)) fill( m_sv0_normdist,   sv0_normdistAcc (*btag_info), eventWeight);
 
       //
       // SV1
@@ -809,11 +809,11 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
       static SG::AuxElement::ConstAccessor< float   > sv1_efracsvxAcc     ("SV1_efracsvx");                                                                  	/// @brief SV1 : 3D vertex significance
       static SG::AuxElement::ConstAccessor< float   > sv1_normdistAcc     ("SV1_normdist");
 
-      if(sv1_NGTinSvxAcc .isAvailable(*btag_info)) m_sv1_NGTinSvx -> Fill( sv1_NGTinSvxAcc (*btag_info), eventWeight);
-      if(sv1_N2TpairAcc  .isAvailable(*btag_info)) m_sv1_N2Tpair  -> Fill( sv1_N2TpairAcc  (*btag_info), eventWeight);
-      if(sv1_masssvxAcc  .isAvailable(*btag_info)) m_sv1_massvx   -> Fill( sv1_masssvxAcc  (*btag_info)/1000, eventWeight);
-      if(sv1_efracsvxAcc .isAvailable(*btag_info)) m_sv1_efracsvx -> Fill( sv1_efracsvxAcc (*btag_info), eventWeight);
-      if(sv1_normdistAcc .isAvailable(*btag_info)) m_sv1_normdist -> Fill( sv1_normdistAcc (*btag_info), eventWeight);
+      if(sv1_NGTinSvxAcc .isAvailable(*btag_info)) fill( m_sv1_NGTinSvx,   sv1_NGTinSvxAcc (*btag_info), eventWeight);
+      if(sv1_N2TpairAcc  .isAvailable(*btag_info)) fill( m_sv1_N2Tpair,    sv1_N2TpairAcc  (*btag_info), eventWeight);
+      if(sv1_masssvxAcc  .isAvailable(*btag_info)) fill( m_sv1_massvx,     sv1_masssvxAcc  (*btag_info)/1000, eventWeight);
+      if(sv1_efracsvxAcc .isAvailable(*btag_info)) fill( m_sv1_efracsvx,   sv1_efracsvxAcc (*btag_info), eventWeight);
+      if(sv1_normdistAcc .isAvailable(*btag_info)) fill( m_sv1_normdist,   sv1_normdistAcc (*btag_info), eventWeight);
 
     }
 
@@ -841,35 +841,35 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
       if(IP2D_gradeOfTracksAcc .isAvailable(*btag_info)){
 	unsigned int nIP2DTracks = IP2D_gradeOfTracksAcc(*btag_info).size();
-	m_nIP2DTracks -> Fill( nIP2DTracks, eventWeight);
-	for(int grade : IP2D_gradeOfTracksAcc(*btag_info))        m_IP2D_gradeOfTracks->Fill(grade, eventWeight);
+	fill( m_nIP2DTracks,   nIP2DTracks, eventWeight);
+	for(int grade : IP2D_gradeOfTracksAcc(*btag_info))        fill( m_IP2D_gradeOfTracks, grade, eventWeight);
       }
 
       if(IP2D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
-	for(bool flag : IP2D_flagFromV0ofTracksAcc(*btag_info))   m_IP2D_flagFromV0ofTracks->Fill(flag, eventWeight);
+	for(bool flag : IP2D_flagFromV0ofTracksAcc(*btag_info))   fill( m_IP2D_flagFromV0ofTracks, flag, eventWeight);
       }
 
       if(IP2D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
-	for(float d0 : IP2D_valD0wrtPVofTracksAcc(*btag_info))    m_IP2D_valD0wrtPVofTracks->Fill(d0, eventWeight);
+	for(float d0 : IP2D_valD0wrtPVofTracksAcc(*btag_info))    fill( m_IP2D_valD0wrtPVofTracks, d0, eventWeight);
       }
 
       if(IP2D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0Sig : IP2D_sigD0wrtPVofTracksAcc(*btag_info)) {
-	  m_IP2D_sigD0wrtPVofTracks  ->Fill(d0Sig, eventWeight);
-	  m_IP2D_sigD0wrtPVofTracks_l->Fill(d0Sig, eventWeight);
+	  fill( m_IP2D_sigD0wrtPVofTracks,  d0Sig, eventWeight);
+	  fill( m_IP2D_sigD0wrtPVofTracks_l, d0Sig, eventWeight);
 	}
       }
 
       if(IP2D_weightBofTracksAcc .isAvailable(*btag_info)){
-	for(float weightB : IP2D_weightBofTracksAcc(*btag_info))  m_IP2D_weightBofTracks->Fill(weightB, eventWeight);
+	for(float weightB : IP2D_weightBofTracksAcc(*btag_info))  fill( m_IP2D_weightBofTracks, weightB, eventWeight);
       }
 
       if(IP2D_weightCofTracksAcc .isAvailable(*btag_info)){
-	for(float weightC : IP2D_weightCofTracksAcc(*btag_info))  m_IP2D_weightCofTracks->Fill(weightC, eventWeight);
+	for(float weightC : IP2D_weightCofTracksAcc(*btag_info))  fill( m_IP2D_weightCofTracks, weightC, eventWeight);
       }
 
       if(IP2D_weightUofTracksAcc .isAvailable(*btag_info)){
-	for(float weightU : IP2D_weightUofTracksAcc(*btag_info))  m_IP2D_weightUofTracks->Fill(weightU, eventWeight);
+	for(float weightU : IP2D_weightUofTracksAcc(*btag_info))  fill( m_IP2D_weightUofTracks, weightU, eventWeight);
       }
 
       //
@@ -897,46 +897,46 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
 
       if(IP3D_gradeOfTracksAcc .isAvailable(*btag_info)){
 	unsigned int nIP3DTracks = IP3D_gradeOfTracksAcc(*btag_info).size();
-	m_nIP3DTracks -> Fill( nIP3DTracks, eventWeight);
-	for(int grade : IP3D_gradeOfTracksAcc(*btag_info))        m_IP3D_gradeOfTracks->Fill(grade, eventWeight);
+	fill( m_nIP3DTracks,   nIP3DTracks, eventWeight);
+	for(int grade : IP3D_gradeOfTracksAcc(*btag_info))        fill( m_IP3D_gradeOfTracks, grade, eventWeight);
       }
 
       if(IP3D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
-	for(bool flag : IP3D_flagFromV0ofTracksAcc(*btag_info))   m_IP3D_flagFromV0ofTracks->Fill(flag, eventWeight);
+	for(bool flag : IP3D_flagFromV0ofTracksAcc(*btag_info))   fill( m_IP3D_flagFromV0ofTracks, flag, eventWeight);
       }
 
       if(IP3D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
-	for(float d0 : IP3D_valD0wrtPVofTracksAcc(*btag_info))    m_IP3D_valD0wrtPVofTracks->Fill(d0, eventWeight);
+	for(float d0 : IP3D_valD0wrtPVofTracksAcc(*btag_info))    fill( m_IP3D_valD0wrtPVofTracks, d0, eventWeight);
       }
 
       if(IP3D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0Sig : IP3D_sigD0wrtPVofTracksAcc(*btag_info)){
-	  m_IP3D_sigD0wrtPVofTracks  ->Fill(d0Sig, eventWeight);
-	  m_IP3D_sigD0wrtPVofTracks_l->Fill(d0Sig, eventWeight);
+	  fill( m_IP3D_sigD0wrtPVofTracks,  d0Sig, eventWeight);
+	  fill( m_IP3D_sigD0wrtPVofTracks_l, d0Sig, eventWeight);
 	}
       }
 
       if(IP3D_valZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
-	for(float z0 : IP3D_valZ0wrtPVofTracksAcc(*btag_info))    m_IP3D_valZ0wrtPVofTracks->Fill(z0, eventWeight);
+	for(float z0 : IP3D_valZ0wrtPVofTracksAcc(*btag_info))    fill( m_IP3D_valZ0wrtPVofTracks, z0, eventWeight);
       }
 
       if(IP3D_sigZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float z0Sig : IP3D_sigZ0wrtPVofTracksAcc(*btag_info)){
-	  m_IP3D_sigZ0wrtPVofTracks  ->Fill(z0Sig, eventWeight);
-	  m_IP3D_sigZ0wrtPVofTracks_l->Fill(z0Sig, eventWeight);
+	  fill( m_IP3D_sigZ0wrtPVofTracks,  z0Sig, eventWeight);
+	  fill( m_IP3D_sigZ0wrtPVofTracks_l, z0Sig, eventWeight);
 	}
       }
 
       if(IP3D_weightBofTracksAcc .isAvailable(*btag_info)){
-	for(float weightB : IP3D_weightBofTracksAcc(*btag_info))  m_IP3D_weightBofTracks->Fill(weightB, eventWeight);
+	for(float weightB : IP3D_weightBofTracksAcc(*btag_info))  fill( m_IP3D_weightBofTracks, weightB, eventWeight);
       }
 
       if(IP3D_weightCofTracksAcc .isAvailable(*btag_info)){
-	for(float weightC : IP3D_weightCofTracksAcc(*btag_info))  m_IP3D_weightCofTracks->Fill(weightC, eventWeight);
+	for(float weightC : IP3D_weightCofTracksAcc(*btag_info))  fill( m_IP3D_weightCofTracks, weightC, eventWeight);
       }
 
       if(IP3D_weightUofTracksAcc .isAvailable(*btag_info)){
-	for(float weightU : IP3D_weightUofTracksAcc(*btag_info))  m_IP3D_weightUofTracks->Fill(weightU, eventWeight);
+	for(float weightU : IP3D_weightUofTracksAcc(*btag_info))  fill( m_IP3D_weightUofTracks, weightU, eventWeight);
       }
 
 
@@ -951,7 +951,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
   vector<float> chfs = jet->getAttribute< vector<float> >(xAOD::JetAttribute::SumPtTrkPt1000);
   float chf(-1);
   if( pvLoc >= 0 && pvLoc < (int)chfs.size() ) {
-    m_chf ->  Fill( chfs.at( pvLoc ) , eventWeight );
+    fill( m_chf,    chfs.at( pvLoc ) , eventWeight );
   }
   */
 
@@ -960,10 +960,10 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
   if( m_infoSwitch->m_resolution ) {
     //float ghostTruthPt = jet->getAttribute( xAOD::JetAttribute::GhostTruthPt );
     float ghostTruthPt = jet->auxdata< float >( "GhostTruthPt" );
-    m_jetGhostTruthPt -> Fill( ghostTruthPt/1e3, eventWeight );
+    fill( m_jetGhostTruthPt,   ghostTruthPt/1e3, eventWeight );
     float resolution = jet->pt()/ghostTruthPt - 1;
-    m_jetPt_vs_resolution -> Fill( jet->pt()/1e3, resolution, eventWeight );
-    m_jetGhostTruthPt_vs_resolution -> Fill( ghostTruthPt/1e3, resolution, eventWeight );
+    fill( m_jetPt_vs_resolution,   jet->pt()/1e3, resolution, eventWeight );
+    fill( m_jetGhostTruthPt_vs_resolution,   ghostTruthPt/1e3, resolution, eventWeight );
   }
 
   if( m_infoSwitch->m_substructure ){
@@ -974,18 +974,18 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int /*pvL
     static SG::AuxElement::ConstAccessor<float> Tau2_wta("Tau2_wta");
     static SG::AuxElement::ConstAccessor<float> Tau3_wta("Tau3_wta");
 
-    if(Tau1.isAvailable(*jet)) m_tau1->Fill( Tau1(*jet), eventWeight );
-    if(Tau2.isAvailable(*jet)) m_tau2->Fill( Tau2(*jet), eventWeight );
-    if(Tau3.isAvailable(*jet)) m_tau3->Fill( Tau3(*jet), eventWeight );
-    if(Tau1.isAvailable(*jet) && Tau2.isAvailable(*jet)) m_tau21->Fill( Tau2(*jet)/Tau1(*jet), eventWeight );
-    if(Tau2.isAvailable(*jet) && Tau3.isAvailable(*jet)) m_tau32->Fill( Tau3(*jet)/Tau2(*jet), eventWeight );
-    if(Tau1_wta.isAvailable(*jet)) m_tau1_wta->Fill( Tau1_wta(*jet), eventWeight );
-    if(Tau2_wta.isAvailable(*jet)) m_tau2_wta->Fill( Tau2_wta(*jet), eventWeight );
-    if(Tau3_wta.isAvailable(*jet)) m_tau3_wta->Fill( Tau3_wta(*jet), eventWeight );
-    if(Tau1_wta.isAvailable(*jet) && Tau2_wta.isAvailable(*jet)) m_tau21_wta->Fill( Tau2_wta(*jet)/Tau1_wta(*jet), eventWeight );
-    if(Tau2_wta.isAvailable(*jet) && Tau3_wta.isAvailable(*jet)) m_tau32_wta->Fill( Tau3_wta(*jet)/Tau2_wta(*jet), eventWeight );
-
-    m_numConstituents->Fill( jet->numConstituents(), eventWeight );
+    if(Tau1.isAvailable(*jet)) fill( m_tau1, Tau1(*jet), eventWeight );
+    if(Tau2.isAvailable(*jet)) fill( m_tau2, Tau2(*jet), eventWeight );
+    if(Tau3.isAvailable(*jet)) fill( m_tau3, Tau3(*jet), eventWeight );
+    if(Tau1.isAvailable(*jet) && Tau2.isAvailable(*jet)) fill( m_tau21, Tau2(*jet)/Tau1(*jet), eventWeight );
+    if(Tau2.isAvailable(*jet) && Tau3.isAvailable(*jet)) fill( m_tau32, Tau3(*jet)/Tau2(*jet), eventWeight );
+    if(Tau1_wta.isAvailable(*jet)) fill( m_tau1_wta, Tau1_wta(*jet), eventWeight );
+    if(Tau2_wta.isAvailable(*jet)) fill( m_tau2_wta, Tau2_wta(*jet), eventWeight );
+    if(Tau3_wta.isAvailable(*jet)) fill( m_tau3_wta, Tau3_wta(*jet), eventWeight );
+    if(Tau1_wta.isAvailable(*jet) && Tau2_wta.isAvailable(*jet)) fill( m_tau21_wta, Tau2_wta(*jet)/Tau1_wta(*jet), eventWeight );
+    if(Tau2_wta.isAvailable(*jet) && Tau3_wta.isAvailable(*jet)) fill( m_tau32_wta, Tau3_wta(*jet)/Tau2_wta(*jet), eventWeight );
+
+    fill( m_numConstituents, jet->numConstituents(), eventWeight );
 
   }
 
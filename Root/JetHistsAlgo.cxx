@@ -19,11 +19,15 @@
 ClassImp(JetHistsAlgo)
 
 JetHistsAlgo :: JetHistsAlgo (std::string className) :
-    Algorithm(className)
+    Algorithm(className),
+    m_skim(nullptr)
 {
   m_inContainerName         = "";
   // which plots will be turned on
   m_detailStr               = "";
+  m_eventWeightName         = "";
+  m_fillWeightSysts         = false;
+  m_skimPredicate           = "";
   // name of algo input container comes from - only if
   m_inputAlgo               = "";
 
@@ -55,6 +59,7 @@ EL::StatusCode JetHistsAlgo::AddHists( std::string name ) {
   RETURN_CHECK("JetHistsAlgo::AddHists", jetHists->initialize(), "");
   jetHists->record( wk() );
   m_plots[name] = jetHists;
+  if( !m_weightChannels.empty() ) { m_plots[name]->setWeightChannels( m_weightChannels, wk() ); }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -68,6 +73,9 @@ EL::StatusCode JetHistsAlgo :: configure ()
     m_inContainerName         = config->GetValue("InputContainer",  m_inContainerName.c_str());
     // which plots will be turned on
     m_detailStr               = config->GetValue("DetailStr",       m_detailStr.c_str());
+    m_eventWeightName         = config->GetValue("EventWeightName", m_eventWeightName.c_str());
+    m_fillWeightSysts         = config->GetValue("FillWeightSysts", m_fillWeightSysts);
+    m_skimPredicate           = config->GetValue("SkimPredicate",   m_skimPredicate.c_str());
     // name of algo input container comes from - only if
     m_inputAlgo               = config->GetValue("InputAlgo",       m_inputAlgo.c_str());
 
@@ -109,6 +117,7 @@ EL::StatusCode JetHistsAlgo :: initialize ()
   if(m_inputAlgo.empty()) { AddHists( "" ); }
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
+  RETURN_CHECK("JetHistsAlgo::initialize()", EventSkim::create( m_skimPredicate, m_skim ), "");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -117,9 +126,17 @@ EL::StatusCode JetHistsAlgo :: execute ()
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
 
+  // skim first, so that the rejected events cost nothing else
+  bool passSkim(true);
+  RETURN_CHECK("JetHistsAlgo::execute()", EventSkim::passes( m_skim, eventInfo, m_event, m_store, passSkim ), "");
+  if ( !passSkim ) { return EL::StatusCode::SUCCESS; }
+
+  // event weight, and the weight systematics if requested (see HistogramManager::readEventWeights)
   float eventWeight(1);
-  if( eventInfo->isAvailable< float >( "mcEventWeight" ) ) {
-    eventWeight = eventInfo->auxdecor< float >( "mcEventWeight" );
+  const std::vector<float>* eventWeights(nullptr);
+  RETURN_CHECK("JetHistsAlgo::execute()", HistogramManager::readEventWeights( eventInfo, m_eventWeightName, m_fillWeightSysts, m_store, eventWeight, eventWeights, m_weightChannels ), "");
+  if( eventWeights ) {
+    for( auto plots : m_plots ) { plots.second->setEventWeights( m_weightChannels, *eventWeights, wk() ); }
   }
 
   // get the highest sum pT^2 primary vertex location in the PV vector
@@ -156,7 +173,10 @@ EL::StatusCode JetHistsAlgo :: execute ()
     // loop over systematics
     for( auto systName : *systNames ) {
       RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(inJets, m_inContainerName+systName, m_event, m_store, m_verbose) ,"");
-      if( m_plots.find( systName ) == m_plots.end() ) { this->AddHists( systName ); }
+      if( m_plots.find( systName ) == m_plots.end() ) {
+        this->AddHists( systName );
+        if( eventWeights ) { m_plots[systName]->setEventWeights( m_weightChannels, *eventWeights, wk() ); }
+      }
       RETURN_CHECK("JetHistsAlgo::execute()", m_plots[systName]->execute( inJets, eventWeight, pvLocation ), "");
     }
 
@@ -174,6 +194,7 @@ EL::StatusCode JetHistsAlgo :: finalize () {
       if(plots.second) delete plots.second;
     }
   }
+  EventSkim::release( m_skim );
   return EL::StatusCode::SUCCESS;
 }
 
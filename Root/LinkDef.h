@@ -27,6 +27,7 @@
 #include <xAODAnaHelpers/ElectronEfficiencyCorrector.h>
 #include <xAODAnaHelpers/MuonEfficiencyCorrector.h>
 #include <xAODAnaHelpers/BJetEfficiencyCorrector.h>
+#include <xAODAnaHelpers/EventWeightBuilder.h>
 
 /* Plotting Tools */
 #include <xAODAnaHelpers/JetHistsAlgo.h>
@@ -75,6 +76,7 @@
 #pragma link C++ class ElectronEfficiencyCorrector+;
 #pragma link C++ class MuonEfficiencyCorrector+;
 #pragma link C++ class BJetEfficiencyCorrector+;
+#pragma link C++ class EventWeightBuilder+;
 
 #pragma link C++ class JetHistsAlgo+;
 #pragma link C++ class MuonHistsAlgo+;
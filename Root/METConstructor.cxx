@@ -1,4 +1,7 @@
 #include <iostream>
+#include <algorithm>
+#include <deque>
+#include <map>
 
 #include <EventLoop/Job.h>
 #include <EventLoop/StatusCode.h>
@@ -19,6 +22,7 @@
 #include "xAODJet/JetContainer.h"
 
 #include "xAODCore/ShallowCopy.h"
+#include "AthContainers/ConstDataVector.h"
 
 // #include "xAODMissingET/MissingET.h"
 #include "xAODMissingET/MissingETContainer.h"
@@ -54,7 +58,10 @@ ClassImp(METConstructor)
 
 METConstructor :: METConstructor (std::string className) :
     Algorithm(className),
-    m_metmaker(0)
+    m_metmaker(0),
+    m_metMap(0),
+    m_coreMet(0),
+    m_nomJets(0)
 {
 
   m_debug           = false;
@@ -82,6 +89,14 @@ METConstructor :: METConstructor (std::string className) :
   m_useCaloJetTerm  = true;
   m_useTrackJetTerm = false;
 
+  m_inputAlgoJets      = "";
+  m_inputAlgoElectrons = "";
+  m_inputAlgoPhotons   = "";
+  m_inputAlgoTaus      = "";
+  m_inputAlgoMuons     = "";
+  m_outputAlgo         = "";
+  m_doIncrementalMET   = true;
+
 }
 
 EL::StatusCode  METConstructor :: configure ()
@@ -129,6 +144,14 @@ EL::StatusCode  METConstructor :: configure ()
   m_useCaloJetTerm  = config->GetValue("UseCaloJetTerm",    m_useCaloJetTerm);
   m_useTrackJetTerm = config->GetValue("UseTrackJetTerm",   m_useTrackJetTerm);
 
+  m_inputAlgoJets      = config->GetValue("InputAlgoJets",      m_inputAlgoJets);
+  m_inputAlgoElectrons = config->GetValue("InputAlgoElectrons", m_inputAlgoElectrons);
+  m_inputAlgoPhotons   = config->GetValue("InputAlgoPhotons",   m_inputAlgoPhotons);
+  m_inputAlgoTaus      = config->GetValue("InputAlgoTaus",      m_inputAlgoTaus);
+  m_inputAlgoMuons     = config->GetValue("InputAlgoMuons",     m_inputAlgoMuons);
+  m_outputAlgo         = config->GetValue("OutputAlgo",         m_outputAlgo);
+  m_doIncrementalMET   = config->GetValue("IncrementalMET",     m_doIncrementalMET);
+
   if( m_mapName.Length() == 0 ) {
     Error("configure()", "MapName is empty!");
     return EL::StatusCode::FAILURE;
@@ -230,6 +253,37 @@ EL::StatusCode METConstructor :: initialize ()
   RETURN_CHECK( "METConstructor::initialize()", m_metmaker->setProperty( "DoMuonEloss", m_doMuonEloss), "");
   RETURN_CHECK( "METConstructor::initialize()", m_metmaker->setProperty( "DoIsolMuonEloss", m_doIsolMuonEloss), "");
 
+  // the object terms, in the order they are rebuilt
+  struct TermConfig { const char* name; xAOD::Type::ObjectType type; TString container; TString inputAlgo; };
+  const TermConfig termConfigs[] = {
+    { "RefEle",   xAOD::Type::Electron, m_inputElectrons, m_inputAlgoElectrons },
+    { "RefGamma", xAOD::Type::Photon,   m_inputPhotons,   m_inputAlgoPhotons   },
+    { "RefTau",   xAOD::Type::Tau,      m_inputTaus,      m_inputAlgoTaus      },
+    { "Muons",    xAOD::Type::Muon,     m_inputMuons,     m_inputAlgoMuons     }
+  };
+  m_objectTerms.clear();
+  for ( const auto& termConfig : termConfigs ) {
+    if ( termConfig.container.Length() == 0 ) { continue; }
+    ObjectTerm term;
+    term.m_name      = termConfig.name;
+    term.m_type      = termConfig.type;
+    term.m_container = termConfig.container.Data();
+    term.m_inputAlgo = termConfig.inputAlgo.Data();
+    term.m_nomObjects = new ConstDataVector<xAOD::IParticleContainer>(SG::VIEW_ELEMENTS);
+    m_objectTerms.push_back( term );
+  }
+
+  m_jetTermNames.clear();
+  if ( m_useCaloJetTerm ) {
+    m_jetTermNames = { "RefJet", "SoftClus", "PVSoftTrk" };
+  } else if ( m_useTrackJetTerm ) {
+    m_jetTermNames = { "RefJetTrk", "PVSoftTrk" };
+  }
+
+  bool doSysts = m_inputAlgoJets.Length() > 0;
+  for ( const auto& term : m_objectTerms ) { doSysts = doSysts || !term.m_inputAlgo.empty(); }
+  if ( doSysts && m_outputAlgo.IsNull() ) { m_outputAlgo = m_outputContainer + "_Syst"; }
+
   Info("initialize()", "METConstructor Interface %s succesfully initialized!", m_name.c_str());
 
   return EL::StatusCode::SUCCESS;
@@ -246,120 +300,155 @@ EL::StatusCode METConstructor :: execute ()
   if(m_debug) Info("execute()", "Performing MET reconstruction...");
 
 
-  // Create a MissingETContainer with its aux store
-  xAOD::MissingETContainer* newMet = new xAOD::MissingETContainer();
-  RETURN_CHECK("METConstructor::execute()", m_store->record(newMet, m_outputContainer.Data()), "Failed to store MET output container.");
-
-  xAOD::MissingETAuxContainer* metAuxCont = new xAOD::MissingETAuxContainer();
-  RETURN_CHECK("METConstructor::execute()", m_store->record(metAuxCont, (m_outputContainer + "Aux.").Data()), "Failed to store MET output container.");
-  newMet->setStore(metAuxCont);
-
+  // everything that does not depend on the variation is resolved once per event, and shared by all the rebuilds below
+  m_metMap  = 0;
+  m_coreMet = 0;
+  m_nomJets = 0;
+  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(m_metMap,  m_mapName.Data(), m_event, m_store, m_verbose), "Failed retrieving MET Map.");
+  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(m_coreMet, m_coreName.Data(), m_event, m_store, m_verbose), "Failed retrieving MET Core.");
+  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(m_nomJets, m_inputJets.Data(), m_event, m_store, m_verbose), "Failed retrieving jet cont.");
+  m_metMap->resetObjSelectionFlags();
 
-  const xAOD::MissingETAssociationMap* metMap = 0;
-  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(metMap,  m_mapName.Data(), m_event, m_store, m_verbose), "Failed retrieving MET Map.");
-  metMap->resetObjSelectionFlags();
+  ///////////////////////
+  //////  NOMINAL  //////
+  ///////////////////////
+  xAOD::MissingETContainer* newMet(nullptr);
+  RETURN_CHECK("METConstructor::execute()", this->recordOutput( "", newMet ), "");
+  RETURN_CHECK("METConstructor::execute()", this->rebuildObjectTerms( newMet, std::vector<unsigned int>(), "", true ), "");
+  RETURN_CHECK("METConstructor::execute()", this->rebuildJetTerms( newMet, "" ), "");
+  RETURN_CHECK("METConstructor::execute()", this->buildMETSums( newMet ), "");
 
   ///////////////////////
-  ////// ELECTRONS  /////
+  ////  SYSTEMATICS  ////
   ///////////////////////
-  if( m_inputElectrons.Length() > 0 ) {
-    const xAOD::ElectronContainer* eleCont(0);
-    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(eleCont, m_inputElectrons.Data(), m_event, m_store, m_verbose), "Failed retrieving electron cont.");
-    if (m_doElectronCuts) {
-      ConstDataVector<xAOD::ElectronContainer> metElectrons(SG::VIEW_ELEMENTS);
-      for (const auto& el : *eleCont) if (CutsMETMaker::accept(el)) metElectrons.push_back(el);
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefEle", xAOD::Type::Electron, newMet, metElectrons.asDataVector(), metMap), "Failed rebuilding electron component.");
-    } else {
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefEle", xAOD::Type::Electron, newMet, eleCont, metMap), "Failed rebuilding electron component.");
+  //
+  // the variations of all the inputs are merged by name: one name gives one output, where every input with that
+  // name is varied (e.g. the EG_* variations of the electrons and the photons, which vary RefEle and RefGamma together).
+  //
+  // the terms are rebuilt in the order electrons, photons, taus, muons, jets (+ soft term), and the selection
+  // flags of the association map set by one term affect the following ones.
+  // - jet variations: the flags of the object terms are still the nominal ones, so only the jet and soft terms are rebuilt
+  // - object variations where the same objects are given to METMaker as in nominal: the overlaps are the same, so
+  //   only the momenta in the varied terms change. These terms are re-summed from the objects kept in nominal
+  // - anything else: full rebuild. These are done last, as they change the flags of the association map
+  //
+  std::vector< Variation > variations;
+  std::map< std::string, unsigned int > variationIndex;
+  auto findVariation = [&variations, &variationIndex]( const std::string& systName ) -> Variation& {
+    auto itr = variationIndex.find( systName );
+    if ( itr != variationIndex.end() ) { return variations.at( itr->second ); }
+    variationIndex[systName] = variations.size();
+    variations.push_back( Variation() );
+    variations.back().m_name = systName;
+    return variations.back();
+  };
+
+  if ( m_inputAlgoJets.Length() > 0 ) {
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(systNames, m_inputAlgoJets.Data(), 0, m_store, m_verbose), "");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      findVariation( systName ).m_jets = true;
+    }
+  }
+  for ( unsigned int iTerm = 0; iTerm < m_objectTerms.size(); ++iTerm ) {
+    const ObjectTerm& term = m_objectTerms.at(iTerm);
+    if ( term.m_inputAlgo.empty() ) { continue; }
+
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(systNames, term.m_inputAlgo, 0, m_store, m_verbose), "");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      std::vector<unsigned int>& terms = findVariation( systName ).m_terms;
+      if ( std::find( terms.begin(), terms.end(), iTerm ) == terms.end() ) { terms.push_back( iTerm ); }
     }
   }
 
+  std::vector< std::string >* vecOutContainerNames(nullptr);
+  if ( !m_outputAlgo.IsNull() ) {
+    vecOutContainerNames = new std::vector< std::string >;
+    vecOutContainerNames->push_back( "" );
+  }
 
-  //////////////////////
-  //////  PHOTONS  /////
-  //////////////////////
-  if( m_inputPhotons.Length() > 0 ) {
-    const xAOD::PhotonContainer* phoCont(0);
-    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(phoCont, m_inputPhotons.Data(), m_event, m_store, m_verbose), "Failed retrieving photon cont.");
-    if (m_doPhotonCuts) {
-      ConstDataVector<xAOD::PhotonContainer> metPhotons(SG::VIEW_ELEMENTS);
-      for (const auto& ph : *phoCont) {
-
-        bool testPID = 0;
-        ph->passSelection(testPID, "Tight");
-        if( !testPID ) continue;
-
-        //ATH_MSG_VERBOSE("Photon author = " << ph->author() << " test " << (ph->author()&20));
-        if (!(ph->author() & 20)) continue;
+  std::vector< const Variation* > fullRebuilds;
 
-        if (ph->pt() < 25e3) continue;
+  for ( const auto& variation : variations ) {
+    if ( vecOutContainerNames ) { vecOutContainerNames->push_back( variation.m_name ); }
 
-        float feta = fabs(ph->eta());
-        if (feta > 2.37 || (1.37 < feta && feta < 1.52)) continue;
+    if ( !m_doIncrementalMET ) {
+      fullRebuilds.push_back( &variation );
+      continue;
+    }
 
-        metPhotons.push_back(ph);
+    if ( variation.m_terms.empty() ) {
+      xAOD::MissingETContainer* systMet(nullptr);
+      RETURN_CHECK("METConstructor::execute()", this->recordOutput( variation.m_name, systMet ), "");
+      for ( const auto& term : m_objectTerms ) {
+        RETURN_CHECK("METConstructor::execute()", this->copyTerm( newMet, systMet, term.m_name ), "");
       }
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefGamma", xAOD::Type::Photon, newMet, metPhotons.asDataVector(), metMap), "Failed rebuilding photon component.");
-    } else {
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefGamma", xAOD::Type::Photon, newMet, phoCont, metMap), "Failed rebuilding photon component.");
+      RETURN_CHECK("METConstructor::execute()", this->rebuildJetTerms( systMet, variation.m_name ), "");
+      RETURN_CHECK("METConstructor::execute()", this->buildMETSums( systMet ), "");
+      continue;
     }
-  }
-
-
-  ///////////////////
-  //////  TAUS  /////
-  ///////////////////
-  if( m_inputTaus.Length() > 0 ) {
-    const xAOD::TauJetContainer* tauCont(0);
-    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(tauCont, m_inputTaus.Data(), m_event, m_store, m_verbose), "Failed retrieving tau cont.");
-    if (m_doTauCuts) {
-      ConstDataVector<xAOD::TauJetContainer> metTaus(SG::VIEW_ELEMENTS);
-      for (const auto& tau : *tauCont) {
 
-        if (tau->pt() < 20e3) continue;
-        if (fabs(tau->eta()) > 2.37) continue;
-        if (!m_tauSelTool->accept(tau)) continue;
-
-        metTaus.push_back(tau);
+    // the varied terms can be re-summed if they get the same objects as in nominal, and the jets are not varied
+    bool canResum = !variation.m_jets;
+    std::deque< ConstDataVector<xAOD::IParticleContainer> > metObjects;
+    for ( unsigned int iVaried = 0; canResum && iVaried < variation.m_terms.size(); ++iVaried ) {
+      const ObjectTerm& term = m_objectTerms.at( variation.m_terms.at(iVaried) );
+      // the muon energy loss correction is not a plain sum of the muon momenta
+      canResum = !( term.m_type == xAOD::Type::Muon && ( m_doMuonEloss || m_doIsolMuonEloss ) );
+      if ( !canResum ) { break; }
+
+      metObjects.emplace_back( SG::VIEW_ELEMENTS );
+      RETURN_CHECK("METConstructor::execute()", this->getMETObjects( term, variation.m_name, metObjects.at(iVaried) ), "");
+      canResum = ( metObjects.at(iVaried).size() == term.m_nomInputs.size() );
+      for ( unsigned int iObj = 0; canResum && iObj < metObjects.at(iVaried).size(); ++iObj ) {
+        canResum = ( metObjects.at(iVaried).at(iObj)->index() == term.m_nomInputs.at(iObj) );
       }
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefTau", xAOD::Type::Tau, newMet, metTaus.asDataVector(), metMap), "Failed rebuilding tau component.");
-    } else {
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("RefTau", xAOD::Type::Tau, newMet, tauCont, metMap), "Failed rebuilding tau component.");
     }
-  }
+    if ( !canResum ) {
+      fullRebuilds.push_back( &variation );
+      continue;
+    }
 
+    xAOD::MissingETContainer* systMet(nullptr);
+    RETURN_CHECK("METConstructor::execute()", this->recordOutput( variation.m_name, systMet ), "");
+    for ( const auto& otherTerm : m_objectTerms ) {
+      RETURN_CHECK("METConstructor::execute()", this->copyTerm( newMet, systMet, otherTerm.m_name ), "");
+    }
+    for ( const auto& jetTerm : m_jetTermNames ) {
+      RETURN_CHECK("METConstructor::execute()", this->copyTerm( newMet, systMet, jetTerm ), "");
+    }
 
-  ////////////////////
-  //////  MUONS  /////
-  ////////////////////
-  if( m_inputMuons.Length() > 0 ) {
-    const xAOD::MuonContainer* muonCont(0);
-    RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(muonCont, m_inputMuons.Data(), m_event, m_store, m_verbose), "Failed retrieving muon cont.");
-    if (m_doMuonCuts) {
-      ConstDataVector<xAOD::MuonContainer> metMuons(SG::VIEW_ELEMENTS);
-      for (const auto& mu : *muonCont) if (CutsMETMaker::accept(mu)) metMuons.push_back(mu);
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("Muons", xAOD::Type::Muon, newMet, metMuons.asDataVector(), metMap), "Failed rebuilding muon component.");
-    } else {
-      RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildMET("Muons", xAOD::Type::Muon, newMet, muonCont, metMap), "Failed rebuilding muon component.");
+    for ( unsigned int iVaried = 0; iVaried < variation.m_terms.size(); ++iVaried ) {
+      const ObjectTerm& term = m_objectTerms.at( variation.m_terms.at(iVaried) );
+      xAOD::MissingET* variedTerm = *(systMet->find( term.m_name ));
+      variedTerm->setMpx( 0. );
+      variedTerm->setMpy( 0. );
+      variedTerm->setSumet( 0. );
+      for ( const auto& obj : metObjects.at(iVaried) ) {
+        if ( std::binary_search( term.m_nomSelected.begin(), term.m_nomSelected.end(), obj->index() ) ) { variedTerm->add( obj ); }
+      }
     }
+
+    RETURN_CHECK("METConstructor::execute()", this->buildMETSums( systMet ), "");
   }
 
-  const xAOD::JetContainer* jetCont(0);
-  const xAOD::MissingETContainer* coreMet(0);
-  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(jetCont, m_inputJets.Data(), m_event, m_store, m_verbose), "Failed retrieving jet cont.");
-  RETURN_CHECK("METConstructor::execute()", HelperFunctions::retrieve(coreMet, m_coreName.Data(), m_event, m_store, m_verbose), "Failed retrieving MET Core.");
+  for ( const auto variation : fullRebuilds ) {
+    m_metMap->resetObjSelectionFlags();
 
-  if ( m_useCaloJetTerm ) {
-    RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildJetMET("RefJet", "SoftClus", "PVSoftTrk", newMet, jetCont, coreMet, metMap, m_doJVTCut), "Failed to build cluster-based jet/MET.");
-  } else if ( m_useTrackJetTerm ) {
-    RETURN_CHECK("METConstructor::execute()", m_metmaker->rebuildTrackMET("RefJetTrk", "PVSoftTrk", newMet, jetCont, coreMet, metMap, m_doJVTCut), "Failed to build track-based jet/MET.");
-  } else {
-    Error("execute()", "Both m_useCaloJetTerm and m_useTrackJetTerm appear to be set to 'false'. This should not happen. Please check your MET configuration file");
-    return EL::StatusCode::FAILURE;
+    xAOD::MissingETContainer* systMet(nullptr);
+    RETURN_CHECK("METConstructor::execute()", this->recordOutput( variation->m_name, systMet ), "");
+    RETURN_CHECK("METConstructor::execute()", this->rebuildObjectTerms( systMet, variation->m_terms, variation->m_name, false ), "");
+    RETURN_CHECK("METConstructor::execute()", this->rebuildJetTerms( systMet, variation->m_jets ? variation->m_name : "" ), "");
+    RETURN_CHECK("METConstructor::execute()", this->buildMETSums( systMet ), "");
   }
 
-  RETURN_CHECK("METConstructor::execute()", m_metmaker->buildMETSum("FinalClus", newMet, MissingETBase::Source::LCTopo), "Failed to build FinalClus MET.");
-  RETURN_CHECK("METConstructor::execute()", m_metmaker->buildMETSum("FinalTrk",  newMet, MissingETBase::Source::Track),  "Failed to build FinalTrk MET.");
+  // save list of systs that should be considered down stream
+  if ( vecOutContainerNames ) {
+    RETURN_CHECK("METConstructor::execute()", m_store->record( vecOutContainerNames, m_outputAlgo.Data() ), "Failed to record vector of output container names.");
+  }
 
   if ( m_debug ) {
     const xAOD::MissingETContainer* oldMet(0);
@@ -387,6 +476,166 @@ EL::StatusCode METConstructor :: execute ()
 
 
 
+EL::StatusCode METConstructor :: recordOutput ( const std::string& systName, xAOD::MissingETContainer*& newMet )
+{
+  // Create a MissingETContainer with its aux store
+  newMet = new xAOD::MissingETContainer();
+  RETURN_CHECK("METConstructor::recordOutput()", m_store->record(newMet, (m_outputContainer + systName.c_str()).Data()), "Failed to store MET output container.");
+
+  xAOD::MissingETAuxContainer* metAuxCont = new xAOD::MissingETAuxContainer();
+  RETURN_CHECK("METConstructor::recordOutput()", m_store->record(metAuxCont, (m_outputContainer + systName.c_str() + "Aux.").Data()), "Failed to store MET output container.");
+  newMet->setStore(metAuxCont);
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode METConstructor :: getMETObjects ( const ObjectTerm& term, const std::string& systName, ConstDataVector<xAOD::IParticleContainer>& metObjects )
+{
+  const std::string containerName = term.m_container + systName;
+
+  switch ( term.m_type ) {
+    case xAOD::Type::Electron: {
+      const xAOD::ElectronContainer* eleCont(0);
+      RETURN_CHECK("METConstructor::getMETObjects()", HelperFunctions::retrieve(eleCont, containerName, m_event, m_store, m_verbose), "Failed retrieving electron cont.");
+      for (const auto& el : *eleCont) if (!m_doElectronCuts || CutsMETMaker::accept(el)) metObjects.push_back(el);
+      break;
+    }
+    case xAOD::Type::Photon: {
+      const xAOD::PhotonContainer* phoCont(0);
+      RETURN_CHECK("METConstructor::getMETObjects()", HelperFunctions::retrieve(phoCont, containerName, m_event, m_store, m_verbose), "Failed retrieving photon cont.");
+      for (const auto& ph : *phoCont) if (!m_doPhotonCuts || this->acceptPhoton(ph)) metObjects.push_back(ph);
+      break;
+    }
+    case xAOD::Type::Tau: {
+      const xAOD::TauJetContainer* tauCont(0);
+      RETURN_CHECK("METConstructor::getMETObjects()", HelperFunctions::retrieve(tauCont, containerName, m_event, m_store, m_verbose), "Failed retrieving tau cont.");
+      for (const auto& tau : *tauCont) if (!m_doTauCuts || this->acceptTau(tau)) metObjects.push_back(tau);
+      break;
+    }
+    case xAOD::Type::Muon: {
+      const xAOD::MuonContainer* muonCont(0);
+      RETURN_CHECK("METConstructor::getMETObjects()", HelperFunctions::retrieve(muonCont, containerName, m_event, m_store, m_verbose), "Failed retrieving muon cont.");
+      for (const auto& mu : *muonCont) if (!m_doMuonCuts || CutsMETMaker::accept(mu)) metObjects.push_back(mu);
+      break;
+    }
+    default:
+      Error("getMETObjects()", "Unsupported object type for MET term %s", term.m_name.c_str());
+      return EL::StatusCode::FAILURE;
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode METConstructor :: rebuildObjectTerms ( xAOD::MissingETContainer* newMet, const std::vector<unsigned int>& varied, const std::string& systName, bool isNominal )
+{
+  ConstDataVector<xAOD::IParticleContainer> variedObjects(SG::VIEW_ELEMENTS);
+
+  for ( unsigned int iTerm = 0; iTerm < m_objectTerms.size(); ++iTerm ) {
+    ObjectTerm& term = m_objectTerms.at(iTerm);
+
+    // the objects passing the MET cuts are only selected once per event for nominal
+    ConstDataVector<xAOD::IParticleContainer>* metObjects = term.m_nomObjects;
+    if ( isNominal ) {
+      term.m_nomObjects->clear();
+      RETURN_CHECK("METConstructor::rebuildObjectTerms()", this->getMETObjects( term, "", *term.m_nomObjects ), "");
+    } else if ( std::find( varied.begin(), varied.end(), iTerm ) != varied.end() ) {
+      variedObjects.clear();
+      RETURN_CHECK("METConstructor::rebuildObjectTerms()", this->getMETObjects( term, systName, variedObjects ), "");
+      metObjects = &variedObjects;
+    }
+    RETURN_CHECK("METConstructor::rebuildObjectTerms()", m_metmaker->rebuildMET(term.m_name, term.m_type, newMet, metObjects->asDataVector(), m_metMap), ("Failed rebuilding " + term.m_name + " component.").c_str());
+
+    // remember which objects went into the nominal term, to re-sum it for the variations
+    if ( isNominal ) {
+      term.m_nomInputs.clear();
+      term.m_nomSelected.clear();
+      for ( const auto& obj : *metObjects ) {
+        term.m_nomInputs.push_back( obj->index() );
+        if ( xAOD::MissingETComposition::objSelected( m_metMap, obj ) ) { term.m_nomSelected.push_back( obj->index() ); }
+      }
+      std::sort( term.m_nomSelected.begin(), term.m_nomSelected.end() );
+    }
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode METConstructor :: rebuildJetTerms ( xAOD::MissingETContainer* newMet, const std::string& systName )
+{
+  const xAOD::JetContainer* jetCont(m_nomJets);
+  if ( !systName.empty() ) {
+    RETURN_CHECK("METConstructor::rebuildJetTerms()", HelperFunctions::retrieve(jetCont, (m_inputJets + systName.c_str()).Data(), m_event, m_store, m_verbose), "Failed retrieving jet cont.");
+  }
+
+  if ( m_useCaloJetTerm ) {
+    RETURN_CHECK("METConstructor::rebuildJetTerms()", m_metmaker->rebuildJetMET("RefJet", "SoftClus", "PVSoftTrk", newMet, jetCont, m_coreMet, m_metMap, m_doJVTCut), "Failed to build cluster-based jet/MET.");
+  } else if ( m_useTrackJetTerm ) {
+    RETURN_CHECK("METConstructor::rebuildJetTerms()", m_metmaker->rebuildTrackMET("RefJetTrk", "PVSoftTrk", newMet, jetCont, m_coreMet, m_metMap, m_doJVTCut), "Failed to build track-based jet/MET.");
+  } else {
+    Error("rebuildJetTerms()", "Both m_useCaloJetTerm and m_useTrackJetTerm appear to be set to 'false'. This should not happen. Please check your MET configuration file");
+    return EL::StatusCode::FAILURE;
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode METConstructor :: buildMETSums ( xAOD::MissingETContainer* newMet )
+{
+  RETURN_CHECK("METConstructor::buildMETSums()", m_metmaker->buildMETSum("FinalClus", newMet, MissingETBase::Source::LCTopo), "Failed to build FinalClus MET.");
+  RETURN_CHECK("METConstructor::buildMETSums()", m_metmaker->buildMETSum("FinalTrk",  newMet, MissingETBase::Source::Track),  "Failed to build FinalTrk MET.");
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode METConstructor :: copyTerm ( const xAOD::MissingETContainer* from, xAOD::MissingETContainer* to, const std::string& name )
+{
+  xAOD::MissingETContainer::const_iterator term_itr = from->find( name );
+  if ( term_itr == from->end() ) {
+    Error("copyTerm()", "MET term %s not found in nominal", name.c_str());
+    return EL::StatusCode::FAILURE;
+  }
+
+  xAOD::MissingET* term = new xAOD::MissingET();
+  to->push_back( term );
+  *term = **term_itr;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+bool METConstructor :: acceptPhoton ( const xAOD::Photon* ph )
+{
+  bool testPID = 0;
+  ph->passSelection(testPID, "Tight");
+  if( !testPID ) return false;
+
+  //ATH_MSG_VERBOSE("Photon author = " << ph->author() << " test " << (ph->author()&20));
+  if (!(ph->author() & 20)) return false;
+
+  if (ph->pt() < 25e3) return false;
+
+  float feta = fabs(ph->eta());
+  if (feta > 2.37 || (1.37 < feta && feta < 1.52)) return false;
+
+  return true;
+}
+
+
+bool METConstructor :: acceptTau ( const xAOD::TauJet* tau )
+{
+  if (tau->pt() < 20e3) return false;
+  if (fabs(tau->eta()) > 2.37) return false;
+  if (!m_tauSelTool->accept(tau)) return false;
+
+  return true;
+}
+
+
 EL::StatusCode METConstructor :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
@@ -419,6 +668,12 @@ EL::StatusCode METConstructor::finalize()
     m_metmaker = 0;
   }
 
+  for ( auto& term : m_objectTerms ) {
+    delete term.m_nomObjects;
+    term.m_nomObjects = 0;
+  }
+  m_objectTerms.clear();
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -50,21 +50,21 @@ StatusCode MetHists::execute( const xAOD::MissingETContainer* met, float eventWe
   // ("FinalClus" uses the calocluster-based soft terms, "FinalTrk" uses the track-based ones)
   //
   const xAOD::MissingET* final_clus = *met->find("FinalClus");
-  m_metFinalClus      -> Fill( final_clus->met()   / 1e3, eventWeight);
-  m_metFinalClusPx    -> Fill( final_clus->mpx()   / 1e3, eventWeight);
-  m_metFinalClusPy    -> Fill( final_clus->mpy()   / 1e3, eventWeight);
-  m_metFinalClusSumEt -> Fill( final_clus->sumet() / 1e3, eventWeight);
-  m_metFinalClusPhi   -> Fill( final_clus->phi()        , eventWeight);
+  fill( m_metFinalClus,        final_clus->met()   / 1e3, eventWeight);
+  fill( m_metFinalClusPx,      final_clus->mpx()   / 1e3, eventWeight);
+  fill( m_metFinalClusPy,      final_clus->mpy()   / 1e3, eventWeight);
+  fill( m_metFinalClusSumEt,   final_clus->sumet() / 1e3, eventWeight);
+  fill( m_metFinalClusPhi,     final_clus->phi()        , eventWeight);
 
   //
   // ("FinalClus" uses the calocluster-based soft terms, "FinalTrk" uses the track-based ones)
   //
   const xAOD::MissingET* final_trk = *met->find("FinalTrk");
-  m_metFinalTrk       -> Fill( final_trk->met()   / 1e3,  eventWeight);
-  m_metFinalTrkPx     -> Fill( final_trk->mpx()   / 1e3,  eventWeight);
-  m_metFinalTrkPy     -> Fill( final_trk->mpy()   / 1e3,  eventWeight);
-  m_metFinalTrkSumEt  -> Fill( final_trk->sumet() / 1e3,  eventWeight);
-  m_metFinalTrkPhi    -> Fill( final_trk->phi()        ,  eventWeight);
+  fill( m_metFinalTrk,         final_trk->met()   / 1e3,  eventWeight);
+  fill( m_metFinalTrkPx,       final_trk->mpx()   / 1e3,  eventWeight);
+  fill( m_metFinalTrkPy,       final_trk->mpy()   / 1e3,  eventWeight);
+  fill( m_metFinalTrkSumEt,    final_trk->sumet() / 1e3,  eventWeight);
+  fill( m_metFinalTrkPhi,      final_trk->phi()        ,  eventWeight);
 
   return StatusCode::SUCCESS;
 }
@@ -17,10 +17,14 @@ ClassImp(MetHistsAlgo)
 
 MetHistsAlgo :: MetHistsAlgo (std::string className) :
     Algorithm(className),
-    m_plots(nullptr)
+    m_plots(nullptr),
+    m_skim(nullptr)
 {
   m_inContainerName         = "";
   m_detailStr               = "";
+  m_eventWeightName         = "";
+  m_fillWeightSysts         = false;
+  m_skimPredicate           = "";
   m_debug                   = false;
 }
 
@@ -74,6 +78,7 @@ EL::StatusCode MetHistsAlgo :: initialize ()
   Info("initialize()", "MetHistsAlgo");
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
+  RETURN_CHECK("MetHistsAlgo::initialize()", EventSkim::create( m_skimPredicate, m_skim ), "");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -82,10 +87,18 @@ EL::StatusCode MetHistsAlgo :: execute ()
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("MetHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
 
+  // skim first, so that the rejected events cost nothing else
+  bool passSkim(true);
+  RETURN_CHECK("MetHistsAlgo::execute()", EventSkim::passes( m_skim, eventInfo, m_event, m_store, passSkim ), "");
+  if ( !passSkim ) { return EL::StatusCode::SUCCESS; }
 
+
+  // event weight, and the weight systematics if requested (see HistogramManager::readEventWeights)
   float eventWeight(1);
-  if( eventInfo->isAvailable< float >( "mcEventWeight" ) ) {
-    eventWeight = eventInfo->auxdecor< float >( "mcEventWeight" );
+  const std::vector<float>* eventWeights(nullptr);
+  RETURN_CHECK("MetHistsAlgo::execute()", HistogramManager::readEventWeights( eventInfo, m_eventWeightName, m_fillWeightSysts, m_store, eventWeight, eventWeights, m_weightChannels ), "");
+  if( eventWeights ) {
+    m_plots->setEventWeights( m_weightChannels, *eventWeights, wk() );
   }
 
   const xAOD::MissingETContainer* met(nullptr);
@@ -97,7 +110,11 @@ EL::StatusCode MetHistsAlgo :: execute ()
 }
 
 EL::StatusCode MetHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode MetHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode MetHistsAlgo :: finalize ()
+{
+  EventSkim::release( m_skim );
+  return EL::StatusCode::SUCCESS;
+}
 EL::StatusCode MetHistsAlgo :: histFinalize ()
 {
   // clean up memory
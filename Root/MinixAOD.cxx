@@ -2,6 +2,9 @@
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
+#include <algorithm>
+#include <map>
+#include <set>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -14,6 +17,7 @@
 #include "xAODCore/AuxContainerBase.h"
 #include "xAODBase/IParticleContainer.h"
 #include "xAODCore/ShallowCopy.h"
+#include "xAODCore/ShallowAuxContainer.h"
 #include "xAODEgamma/ElectronContainer.h"
 #include "xAODEgamma/ElectronAuxContainer.h"
 #include "xAODJet/JetContainer.h"
@@ -32,6 +36,9 @@
 #include "xAODTau/TauJetAuxContainer.h"
 #include "xAODTau/TauJet.h"
 
+// EDM include(s):
+#include "AthLinks/ElementLink.h"
+
 // CutBookkeeper Includes
 #include "xAODCutFlow/CutBookkeeper.h"
 #include "xAODCutFlow/CutBookkeeperContainer.h"
@@ -47,6 +54,53 @@
 #include "TEnv.h"
 #include "TSystem.h"
 
+namespace {
+
+  // HelperFunctions::recordOutput(), with the aux key resolved in the output plan
+  template <typename T1, typename T2>
+  StatusCode recordToEvent(xAOD::TEvent* event, xAOD::TStore* store, const std::string& key, const std::string& auxKey){
+    T1* cont(nullptr);
+    T2* auxcont(nullptr);
+
+    if(!store->retrieve(cont, key).isSuccess()) return StatusCode::FAILURE;
+    if(!store->retrieve(auxcont, auxKey).isSuccess()) return StatusCode::FAILURE;
+
+    if(!event->record(cont, key).isSuccess()) return StatusCode::FAILURE;
+    if(!event->record(auxcont, auxKey).isSuccess()) return StatusCode::FAILURE;
+    return StatusCode::SUCCESS;
+  }
+
+  // shallow copies have a ShallowAuxContainer instead of the full aux container
+  template <typename T1, typename T2>
+  StatusCode recordToEvent(xAOD::TEvent* event, xAOD::TStore* store, const std::string& key, const std::string& auxKey, bool shallow){
+    if(shallow) return recordToEvent<T1, xAOD::ShallowAuxContainer>(event, store, key, auxKey);
+    return recordToEvent<T1, T2>(event, store, key, auxKey);
+  }
+
+  // deep copy, to TStore and TEvent, of the elements of a view which do not belong to its parent
+  template <typename T1, typename T2, typename T3>
+  StatusCode copyOutsideParent(xAOD::TEvent* event, xAOD::TStore* store, const std::string& inKey, const std::string& key, const SG::AuxVectorData* parent){
+    const T1* view(nullptr);
+    if(!store->retrieve(view, inKey).isSuccess()) return StatusCode::FAILURE;
+
+    T1* cont = new T1;
+    T2* auxcont = new T2;
+    cont->setStore(auxcont);
+    if(!store->record(cont, key).isSuccess()) return StatusCode::FAILURE;
+    if(!store->record(auxcont, key+"Aux.").isSuccess()) return StatusCode::FAILURE;
+
+    for(const auto p: *view){
+      if(p->container() == parent) continue;
+      T3* p_new = new T3;
+      cont->push_back(p_new);
+      *p_new = *p;
+    }
+
+    return recordToEvent<T1, T2>(event, store, key, key+"Aux.");
+  }
+
+}
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(MinixAOD)
 
@@ -56,6 +110,7 @@ MinixAOD :: MinixAOD (std::string className) :
     m_shallowCopyKeys_vec(),
     m_deepCopyKeys_vec(),
     m_copyFromStoreToEventKeys_vec(),
+    m_planReady(false),
     m_fileMetaDataTool(nullptr),
     m_trigMetaDataTool(nullptr)
 {
@@ -69,7 +124,12 @@ MinixAOD :: MinixAOD (std::string className) :
   m_simpleCopyKeys = "";
   m_storeCopyKeys = "";
   m_deepCopyKeys = "";
+  m_shallowCopyKeys = "";
   m_vectorCopyKeys = "";
+  m_auxItemLists = "";
+  m_shallowDelta = false;
+  m_shallowDeltaVars = "pt.eta.phi.m";
+  m_linkViews = false;
 }
 
 EL::StatusCode  MinixAOD :: configure ()
@@ -88,7 +148,12 @@ EL::StatusCode  MinixAOD :: configure ()
     m_simpleCopyKeys    = config->GetValue("SimpleCopyKeys", m_simpleCopyKeys.c_str());
     m_storeCopyKeys     = config->GetValue("StoreCopyKeys", m_storeCopyKeys.c_str());
     m_deepCopyKeys      = config->GetValue("DeepCopyKeys", m_deepCopyKeys.c_str());
+    m_shallowCopyKeys   = config->GetValue("ShallowCopyKeys", m_shallowCopyKeys.c_str());
     m_vectorCopyKeys    = config->GetValue("VectorCopyKeys", m_vectorCopyKeys.c_str());
+    m_auxItemLists      = config->GetValue("AuxItemLists", m_auxItemLists.c_str());
+    m_shallowDelta      = config->GetValue("ShallowDelta", m_shallowDelta);
+    m_shallowDeltaVars  = config->GetValue("ShallowDeltaVars", m_shallowDeltaVars.c_str());
+    m_linkViews         = config->GetValue("LinkViews", m_linkViews);
 
     config->Print();
     Info("configure()", "MinixAOD Interface succesfully configured! ");
@@ -224,119 +289,335 @@ EL::StatusCode MinixAOD :: initialize ()
     m_vectorCopyKeys_vec.push_back(std::pair<std::string, std::string>(token.substr(0, pos), token.substr(pos+1)));
   }
 
+  // A1|A2 B1|B2 C1|C2 ... Z1|Z2 -> {A1: A2, B1: B2, ..., Z1: Z2}
+  ss.clear(); ss.str(m_auxItemLists);
+  while(std::getline(ss, token, ' ')){
+    int pos = token.find_first_of('|');
+    m_auxItemLists_map[token.substr(0, pos)] = token.substr(pos+1);
+  }
+
   if(m_debug) Info("initialize()", "MinixAOD Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
 }
 
-EL::StatusCode MinixAOD :: execute ()
+EL::StatusCode MinixAOD :: getContainerType (const std::string& key, ContainerType& type)
 {
-  if(m_verbose) Info("execute()", "Dumping objects...");
+  if      ( m_store->contains<xAOD::ElectronContainer>(key) )   { type = ELECTRONS; }
+  else if ( m_store->contains<xAOD::JetContainer>(key) )        { type = JETS; }
+  else if ( m_store->contains<xAOD::MissingETContainer>(key) )  { type = MET; }
+  else if ( m_store->contains<xAOD::MuonContainer>(key) )       { type = MUONS; }
+  else if ( m_store->contains<xAOD::PhotonContainer>(key) )     { type = PHOTONS; }
+  else if ( m_store->contains<xAOD::TauJetContainer>(key) )     { type = TAUS; }
+  else {
+    Error("getContainerType()", "Could not find container %s in TStore, or identify what type it corresponds to.", key.c_str());
+    return EL::StatusCode::FAILURE;
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+void MinixAOD :: setAuxItemList (const CopyItem& item)
+{
+  std::string itemList("");
+  if(m_auxItemLists_map.find(item.m_key) != m_auxItemLists_map.end()) itemList = m_auxItemLists_map[item.m_key];
+  else if(item.m_shallow && m_shallowDelta)                           itemList = m_shallowDeltaVars;
+  if(itemList.empty()) return;
+
+  m_event->setAuxItemList(item.m_auxKey, itemList);
+  if(m_debug) Info("setAuxItemList()", "Aux items of %s: %s", item.m_key.c_str(), itemList.c_str());
+}
+
+std::string MinixAOD :: findViewParent (const CopyItem& item)
+{
+  const xAOD::IParticleContainer* view(nullptr);
+  if(!HelperFunctions::retrieve(view, item.m_inKey, nullptr, m_store).isSuccess() || view->empty()) return "";
+
+  // all the elements must come from the same container...
+  const SG::AuxVectorData* parent = view->at(0)->container();
+  if(!parent) return "";
+  for(const auto obj: *view){
+    if(obj->container() != parent) return "";
+  }
+
+  // ... which must be written, under the same name
+  for(const auto& candidate: m_recordPlan){
+    if(candidate.m_type == MET) continue;
+    const xAOD::IParticleContainer* cont(nullptr);
+    if(!HelperFunctions::retrieve(cont, candidate.m_key, nullptr, m_store).isSuccess()) continue;
+    if(static_cast<const SG::AuxVectorData*>(cont) == parent) return candidate.m_key;
+  }
+  for(const auto& candidate: m_simpleCopyPlan){
+    const xAOD::IParticleContainer* cont(nullptr);
+    if(!HelperFunctions::retrieve(cont, candidate.m_key, m_event, nullptr).isSuccess()) continue;
+    if(static_cast<const SG::AuxVectorData*>(cont) == parent) return candidate.m_key;
+  }
+
+  return "";
+}
+
+EL::StatusCode MinixAOD :: recordViewLinks (const CopyItem& item)
+{
+  const xAOD::IParticleContainer* view(nullptr);
+  RETURN_CHECK("MinixAOD::recordViewLinks()", HelperFunctions::retrieve(view, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+  const xAOD::IParticleContainer* parent(nullptr);
+  RETURN_CHECK("MinixAOD::recordViewLinks()", HelperFunctions::retrieve(parent, item.m_linkParent, m_event, m_store, m_verbose), std::string("Could not retrieve container "+item.m_linkParent+". Enable m_verbose to find out why.").c_str());
+
+  // the elements from another container (in a later event) are deep-copied instead, into a container written every event
+  const std::string copyKey = item.m_key+"Copy";
+  const SG::AuxVectorData* parentData = static_cast<const SG::AuxVectorData*>(parent);
+  switch(item.m_type){
+    case ELECTRONS:
+      RETURN_CHECK("MinixAOD::recordViewLinks()", (copyOutsideParent<xAOD::ElectronContainer, xAOD::ElectronAuxContainer, xAOD::Electron>(m_event, m_store, item.m_inKey, copyKey, parentData)), std::string("Could not deep copy "+item.m_inKey+" to "+copyKey+".").c_str());
+      break;
+    case JETS:
+      RETURN_CHECK("MinixAOD::recordViewLinks()", (copyOutsideParent<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(m_event, m_store, item.m_inKey, copyKey, parentData)), std::string("Could not deep copy "+item.m_inKey+" to "+copyKey+".").c_str());
+      break;
+    case MUONS:
+      RETURN_CHECK("MinixAOD::recordViewLinks()", (copyOutsideParent<xAOD::MuonContainer, xAOD::MuonAuxContainer, xAOD::Muon>(m_event, m_store, item.m_inKey, copyKey, parentData)), std::string("Could not deep copy "+item.m_inKey+" to "+copyKey+".").c_str());
+      break;
+    case PHOTONS:
+      RETURN_CHECK("MinixAOD::recordViewLinks()", (copyOutsideParent<xAOD::PhotonContainer, xAOD::PhotonAuxContainer, xAOD::Photon>(m_event, m_store, item.m_inKey, copyKey, parentData)), std::string("Could not deep copy "+item.m_inKey+" to "+copyKey+".").c_str());
+      break;
+    case TAUS:
+      RETURN_CHECK("MinixAOD::recordViewLinks()", (copyOutsideParent<xAOD::TauJetContainer, xAOD::TauJetAuxContainer, xAOD::TauJet>(m_event, m_store, item.m_inKey, copyKey, parentData)), std::string("Could not deep copy "+item.m_inKey+" to "+copyKey+".").c_str());
+      break;
+    case MET:
+      // never linked, see buildPlan()
+      break;
+  }
+
+  std::vector< ElementLink<xAOD::IParticleContainer> >* links = new std::vector< ElementLink<xAOD::IParticleContainer> >();
+  links->reserve(view->size());
+  size_t nCopied(0);
+  for(const auto obj: *view){
+    if(obj->container() == parentData) links->push_back(ElementLink<xAOD::IParticleContainer>(item.m_linkParent, obj->index()));
+    else                               links->push_back(ElementLink<xAOD::IParticleContainer>(copyKey, nCopied++));
+  }
+  if(nCopied > 0 && m_debug) Info("recordViewLinks()", "%lu elements of %s do not belong to %s, deep-copied to %s", nCopied, item.m_inKey.c_str(), item.m_linkParent.c_str(), copyKey.c_str());
+
+  RETURN_CHECK("MinixAOD::recordViewLinks()", m_event->record(links, item.m_key), std::string("Could not record "+item.m_key+" to TEvent.").c_str());
+
+  return EL::StatusCode::SUCCESS;
+}
 
+EL::StatusCode MinixAOD :: buildPlan ()
+{
   // simple copy is easiest - it's in the input, copy over, no need for types
   for(const auto& key: m_simpleCopyKeys_vec){
-    RETURN_CHECK("MinixAOD::execute()", m_event->copy(key), std::string("Could not copy "+key+" from input file.").c_str());
-    if(m_debug) std::cout << "Copying " << key << " from input file" << std::endl;
+    CopyItem item;
+    item.m_key     = key;
+    item.m_auxKey  = key+"Aux.";
+    item.m_shallow = false;
+    this->setAuxItemList(item);
+    m_simpleCopyPlan.push_back(item);
   }
 
+  std::vector<std::string> recordKeys(m_copyFromStoreToEventKeys_vec);
+  std::map<std::string, ContainerType> deepCopyTypes;
+
   // we need to make deep copies
   for(const auto& keypair: m_deepCopyKeys_vec){
-    auto in_key = keypair.first;
-    auto out_key = keypair.second;
-
-    const xAOD::IParticleContainer* cont(nullptr);
-    RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, in_key, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+in_key+" from TStore. Enable m_verbose to find out why.").c_str());
-
-    if(const xAOD::ElectronContainer* t_cont = dynamic_cast<const xAOD::ElectronContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::ElectronContainer, xAOD::ElectronAuxContainer, xAOD::Electron>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else if(const xAOD::JetContainer* t_cont = dynamic_cast<const xAOD::JetContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else if(const xAOD::MissingETContainer* t_cont = dynamic_cast<const xAOD::MissingETContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::MissingETContainer, xAOD::MissingETAuxContainer, xAOD::MissingET>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else if(const xAOD::MuonContainer* t_cont = dynamic_cast<const xAOD::MuonContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::MuonContainer, xAOD::MuonAuxContainer, xAOD::Muon>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else if(const xAOD::PhotonContainer* t_cont = dynamic_cast<const xAOD::PhotonContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::PhotonContainer, xAOD::PhotonAuxContainer, xAOD::Photon>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else if(const xAOD::TauJetContainer* t_cont = dynamic_cast<const xAOD::TauJetContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::TauJetContainer, xAOD::TauJetAuxContainer, xAOD::TauJet>(m_store, out_key.c_str(), t_cont)), std::string("Could not deep copy "+in_key+" to "+out_key+".").c_str());
-    } else {
-      std::cout << "Could not identify what container " << in_key << " corresponds to for deep-copying." << std::endl;
-      return EL::StatusCode::FAILURE;
-    }
-    m_copyFromStoreToEventKeys_vec.push_back(out_key);
-
-    if(m_debug) std::cout << "Deep-Copied " << in_key << " to " << out_key << " to record to output file" << std::endl;
+    CopyItem item;
+    item.m_inKey   = keypair.first;
+    item.m_key     = keypair.second;
+    item.m_auxKey  = keypair.second+"Aux.";
+    item.m_shallow = false;
+    RETURN_CHECK("MinixAOD::buildPlan()", this->getContainerType(item.m_inKey, item.m_type), "");
+    m_deepCopyPlan.push_back(item);
+
+    // the deep copy does not exist yet
+    deepCopyTypes[item.m_key] = item.m_type;
+    recordKeys.push_back(item.m_key);
   }
 
   // shallow IO handling (if no parent, assume deep copy)
   for(const auto& keypair: m_shallowCopyKeys_vec){
-    auto key = keypair.first;
-    auto parent = keypair.second;
+    if(!keypair.second.empty()) recordKeys.push_back(keypair.second);
+    else if(m_shallowDelta) Warning("buildPlan()", "No parent given for %s: it cannot be read back as a delta", keypair.first.c_str());
+    recordKeys.push_back(keypair.first);
+  }
+
+  // vector handling (if no parent, assume deep copy)
+  // - the contents of the vectors are read every event (see collectVectorItems()), only their parents are in the plan
+  for(const auto& keypair: m_vectorCopyKeys_vec){
+    if(!keypair.second.empty()) recordKeys.push_back(keypair.second);
+    else if(m_shallowDelta) Warning("buildPlan()", "No parent given for the containers of %s: they cannot be read back as deltas", keypair.first.c_str());
+  }
 
-    // only add the parent if it doesn't exist
-    if(!parent.empty()) m_copyFromStoreToEventKeys_vec.push_back(parent);
+  // remove duplicates
+  std::set<std::string> uniqueKeys(recordKeys.begin(), recordKeys.end());
 
-    if(m_debug){
-      std::cout << "Copying " << key;
-      if(!parent.empty()) std::cout << " as well as it's parent " << parent;
-      std::cout << std::endl;
+  for(const auto& key: uniqueKeys){
+    CopyItem item;
+    item.m_key     = key;
+    item.m_auxKey  = key+"Aux.";
+    if(deepCopyTypes.find(key) != deepCopyTypes.end()){
+      item.m_type    = deepCopyTypes[key];
+      item.m_shallow = false;
+    } else {
+      RETURN_CHECK("MinixAOD::buildPlan()", this->getContainerType(key, item.m_type), "");
+      item.m_shallow = m_store->contains<xAOD::ShallowAuxContainer>(item.m_auxKey);
     }
+    this->setAuxItemList(item);
+    m_recordPlan.push_back(item);
+    m_recordPlanKeys.insert(key);
+  }
 
-    m_copyFromStoreToEventKeys_vec.push_back(key);
+  // views into a written container are written as links, and not recorded themselves
+  if(m_linkViews){
+    for(auto& item: m_deepCopyPlan){
+      if(item.m_type == MET) continue;
+      item.m_linkParent = this->findViewParent(item);
+      if(item.m_linkParent.empty()) continue;
+      Info("buildPlan()", "%s is written as links into %s", item.m_key.c_str(), item.m_linkParent.c_str());
+      m_recordPlan.erase(std::remove_if(m_recordPlan.begin(), m_recordPlan.end(), [&item](const CopyItem& record){ return record.m_key == item.m_key; }), m_recordPlan.end());
+      m_recordPlanKeys.erase(item.m_key);
+    }
   }
 
-  // vector handling (if no parent, assume deep copy)
-  for(const auto& keypair: m_vectorCopyKeys_vec){
-    auto vectorName = keypair.first;
-    auto parent = keypair.second;
+  Info("buildPlan()", "Output plan: %lu containers copied from the input, %lu deep-copied, %lu recorded from TStore", m_simpleCopyPlan.size(), m_deepCopyPlan.size(), m_recordPlan.size());
+  if(m_debug){
+    for(const auto& item: m_recordPlan) Info("buildPlan()", "\t%s", item.m_key.c_str());
+  }
 
-    std::vector<std::string>* vector(nullptr);
-    RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(vector, vectorName, nullptr, m_store, m_verbose), std::string("Could not retrieve vector "+vectorName+" from TStore. Enable m_verbose to find out why.").c_str());
+  m_planReady = true;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode MinixAOD :: collectVectorItems ()
+{
+  m_eventVectorItems.clear();
 
-    // only add the parent if it doesn't exist
-    if(!parent.empty()) m_copyFromStoreToEventKeys_vec.push_back(parent);
+  for(const auto& keypair: m_vectorCopyKeys_vec){
+    std::vector<std::string>* vector(nullptr);
+    RETURN_CHECK("MinixAOD::collectVectorItems()", HelperFunctions::retrieve(vector, keypair.first, nullptr, m_store, m_verbose), std::string("Could not retrieve vector "+keypair.first+" from TStore. Enable m_verbose to find out why.").c_str());
 
-    std::cout << "The following containers are being copied over:" << std::endl;
     for(const auto& key: *vector){
-      if(m_debug) std::cout << "\t" << key << std::endl;
-      m_copyFromStoreToEventKeys_vec.push_back(key);
+      // the containers of the plan, and those of another vector, are recorded once
+      if(m_recordPlanKeys.find(key) != m_recordPlanKeys.end()) continue;
+
+      auto item_itr = m_vectorCopyItems.find(key);
+      if(item_itr == m_vectorCopyItems.end()){
+        CopyItem item;
+        item.m_key     = key;
+        item.m_auxKey  = key+"Aux.";
+        RETURN_CHECK("MinixAOD::collectVectorItems()", this->getContainerType(key, item.m_type), "");
+        item.m_shallow = m_store->contains<xAOD::ShallowAuxContainer>(item.m_auxKey);
+        this->setAuxItemList(item);
+        item_itr = m_vectorCopyItems.insert(std::make_pair(key, item)).first;
+        if(m_debug) Info("collectVectorItems()", "\t%s (from %s)", key.c_str(), keypair.first.c_str());
+      }
+
+      if(std::find(m_eventVectorItems.begin(), m_eventVectorItems.end(), &item_itr->second) == m_eventVectorItems.end()){
+        m_eventVectorItems.push_back(&item_itr->second);
+      }
     }
-    if(m_debug && !parent.empty()) std::cout << "... along with their parent " << parent << std::endl;
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
 
+EL::StatusCode MinixAOD :: recordItem (const CopyItem& item)
+{
+  // the shallow copies are recreated every event, so their aux store is switched every event
+  if(item.m_shallow && m_shallowDelta){
+    xAOD::ShallowAuxContainer* auxcont(nullptr);
+    RETURN_CHECK("MinixAOD::recordItem()", m_store->retrieve(auxcont, item.m_auxKey), std::string("Could not retrieve "+item.m_auxKey+" from TStore.").c_str());
+    auxcont->setShallowIO(true);
   }
 
-  // remove duplicates from m_copyFromStoreToEventKeys_vec
-  // - see http://stackoverflow.com/a/1041939/1532974
-  std::set<std::string> s;
-  unsigned size = m_copyFromStoreToEventKeys_vec.size();
-  for( unsigned i = 0; i < size; ++i ) s.insert( m_copyFromStoreToEventKeys_vec[i] );
-  m_copyFromStoreToEventKeys_vec.assign( s.begin(), s.end() );
+  switch(item.m_type){
+    case ELECTRONS:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::ElectronContainer, xAOD::ElectronAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+    case JETS:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::JetContainer, xAOD::JetAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+    case MET:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::MissingETContainer, xAOD::MissingETAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+    case MUONS:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::MuonContainer, xAOD::MuonAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+    case PHOTONS:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::PhotonContainer, xAOD::PhotonAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+    case TAUS:
+      RETURN_CHECK("MinixAOD::recordItem()", (recordToEvent<xAOD::TauJetContainer, xAOD::TauJetAuxContainer>(m_event, m_store, item.m_key, item.m_auxKey, item.m_shallow)), std::string("Could not copy "+item.m_key+" from TStore to TEvent.").c_str());
+      break;
+  }
 
-  // all we need to do is retrieve it and figure out what type it is to record it and we're done
-  for(const auto& key: m_copyFromStoreToEventKeys_vec){
-    const xAOD::IParticleContainer* cont(nullptr);
-    RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, key, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+key+" from TStore. Enable m_verbose to find out why.").c_str());
-
-    if(dynamic_cast<const xAOD::ElectronContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::ElectronContainer, xAOD::ElectronAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent.").c_str());
-    } else if(dynamic_cast<const xAOD::JetContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::JetContainer, xAOD::JetAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent.").c_str());
-    } else if(dynamic_cast<const xAOD::MissingETContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::MissingETContainer, xAOD::MissingETAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent.").c_str());
-    } else if(dynamic_cast<const xAOD::MuonContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::MuonContainer, xAOD::MuonAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent").c_str());
-    } else if(dynamic_cast<const xAOD::PhotonContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::PhotonContainer, xAOD::PhotonAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent.").c_str());
-    } else if(dynamic_cast<const xAOD::TauJetContainer*>(cont)){
-      RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::recordOutput<xAOD::TauJetContainer, xAOD::TauJetAuxContainer>(m_event, m_store, key)), std::string("Could not copy "+key+" from TStore to TEvent.").c_str());
-    } else {
-      std::cout << "Could not identify what container " << key << " corresponds to for copying from TStore to TEvent." << std::endl;
-      return EL::StatusCode::FAILURE;
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode MinixAOD :: execute ()
+{
+  if(m_verbose) Info("execute()", "Dumping objects...");
+
+  if(!m_planReady){
+    RETURN_CHECK("MinixAOD::execute()", this->buildPlan(), "Could not build the output plan.");
+  }
+  RETURN_CHECK("MinixAOD::execute()", this->collectVectorItems(), "");
+
+  for(const auto& item: m_simpleCopyPlan){
+    RETURN_CHECK("MinixAOD::execute()", m_event->copy(item.m_key), std::string("Could not copy "+item.m_key+" from input file.").c_str());
+  }
+
+  for(const auto& item: m_deepCopyPlan){
+    if(!item.m_linkParent.empty()){
+      RETURN_CHECK("MinixAOD::execute()", this->recordViewLinks(item), "");
+      continue;
     }
 
-    if(m_debug) std::cout << "Copied " << key << " and it's auxiliary container from TStore to TEvent" << std::endl;
+    switch(item.m_type){
+      case ELECTRONS: {
+        const xAOD::ElectronContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::ElectronContainer, xAOD::ElectronAuxContainer, xAOD::Electron>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+      case JETS: {
+        const xAOD::JetContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+      case MET: {
+        const xAOD::MissingETContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::MissingETContainer, xAOD::MissingETAuxContainer, xAOD::MissingET>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+      case MUONS: {
+        const xAOD::MuonContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::MuonContainer, xAOD::MuonAuxContainer, xAOD::Muon>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+      case PHOTONS: {
+        const xAOD::PhotonContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::PhotonContainer, xAOD::PhotonAuxContainer, xAOD::Photon>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+      case TAUS: {
+        const xAOD::TauJetContainer* cont(nullptr);
+        RETURN_CHECK("MinixAOD::execute()", HelperFunctions::retrieve(cont, item.m_inKey, nullptr, m_store, m_verbose), std::string("Could not retrieve container "+item.m_inKey+" from TStore. Enable m_verbose to find out why.").c_str());
+        RETURN_CHECK("MinixAOD::execute()", (HelperFunctions::makeDeepCopy<xAOD::TauJetContainer, xAOD::TauJetAuxContainer, xAOD::TauJet>(m_store, item.m_key, cont)), std::string("Could not deep copy "+item.m_inKey+" to "+item.m_key+".").c_str());
+        break;
+      }
+    }
   }
 
+  // all we need to do is retrieve it and record it with the type found when building the plan
+  for(const auto& item: m_recordPlan){
+    RETURN_CHECK("MinixAOD::execute()", this->recordItem(item), "");
+  }
+  for(const auto item: m_eventVectorItems){
+    RETURN_CHECK("MinixAOD::execute()", this->recordItem(*item), "");
+  }
 
   m_event->fill();
   if(m_debug) Info("execute()", "Finished dumping objects...");
@@ -28,6 +28,8 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/MuonEfficiencyCorrector.h"
+#include "xAODAnaHelpers/ScaleFactorCache.h"
+#include "xAODAnaHelpers/ScaleFactorTable.h"
 
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
@@ -46,7 +48,9 @@ MuonEfficiencyCorrector :: MuonEfficiencyCorrector (std::string className) :
     m_asgMuonEffCorrTool_muSF_Reco(nullptr),
     m_asgMuonEffCorrTool_muSF_Iso(nullptr),
     m_asgMuonEffCorrTool_muSF_Trig(nullptr),
-    m_pileuptool(nullptr)
+    m_pileuptool(nullptr),
+    m_SFCacheReco(nullptr),
+    m_SFCacheIso(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -92,6 +96,18 @@ MuonEfficiencyCorrector :: MuonEfficiencyCorrector (std::string className) :
   m_outputSystNamesIso         = "MuonEfficiencyCorrector_IsoSyst";
   m_outputSystNamesTrig        = "MuonEfficiencyCorrector_TrigSyst";
 
+  // SF tables
+  //
+  m_writeSFTable               = false;
+
+  // SF memoization
+  //
+  m_useSFCache                 = false;
+  m_SFCacheSize                = 10000;
+  m_SFCachePtBins              = "";
+  m_SFCacheEtaBins             = "";
+  m_SFCachePhiBins             = "";
+
 }
 
 
@@ -140,6 +156,16 @@ EL::StatusCode  MuonEfficiencyCorrector :: configure ()
     m_outputSystNamesIso         = config->GetValue("OutputSystNamesIso",  m_outputSystNamesIso.c_str());
     m_outputSystNamesTrig        = config->GetValue("OutputSystNamesTrig", m_outputSystNamesTrig.c_str());
 
+    // SF tables
+    m_writeSFTable               = config->GetValue("WriteSFTable"   , m_writeSFTable);
+
+    // SF memoization
+    m_useSFCache                 = config->GetValue("UseSFCache"     , m_useSFCache);
+    m_SFCacheSize                = config->GetValue("SFCacheSize"    , m_SFCacheSize);
+    m_SFCachePtBins              = config->GetValue("SFCachePtBins"  , m_SFCachePtBins.c_str());
+    m_SFCacheEtaBins             = config->GetValue("SFCacheEtaBins" , m_SFCacheEtaBins.c_str());
+    m_SFCachePhiBins             = config->GetValue("SFCachePhiBins" , m_SFCachePhiBins.c_str());
+
     config->Print();
 
     Info("configure()", "MuonEfficiencyCorrector Interface succesfully configured! ");
@@ -386,6 +412,17 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
 
   // *********************************************************************************
 
+  // Initialise SF caches (reco and iso only: the trigger SF is computed for the whole muon container)
+  //
+  if ( m_useSFCache ) {
+    if ( m_SFCachePtBins.empty() || m_SFCacheEtaBins.empty() || m_SFCachePhiBins.empty() ) {
+      Error("initialize()", "UseSFCache requires the pT, eta and phi bin edges of the SF maps (SFCachePtBins, SFCacheEtaBins, SFCachePhiBins). Exiting" );
+      return EL::StatusCode::FAILURE;
+    }
+    m_SFCacheReco = new ScaleFactorCache( m_name + "_Reco", m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins, m_SFCachePhiBins );
+    m_SFCacheIso  = new ScaleFactorCache( m_name + "_Iso",  m_SFCacheSize, m_SFCachePtBins, m_SFCacheEtaBins, m_SFCachePhiBins );
+  }
+
   Info("initialize()", "MuonEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -508,6 +545,9 @@ EL::StatusCode MuonEfficiencyCorrector :: finalize ()
   if ( m_asgMuonEffCorrTool_muSF_Trig )  { m_asgMuonEffCorrTool_muSF_Trig = nullptr; delete m_asgMuonEffCorrTool_muSF_Trig; }
   if ( m_pileuptool )                    { m_pileuptool = nullptr;                   delete m_pileuptool; }
 
+  if ( m_SFCacheReco ) { m_SFCacheReco->printStats(); delete m_SFCacheReco; m_SFCacheReco = nullptr; }
+  if ( m_SFCacheIso )  { m_SFCacheIso->printStats();  delete m_SFCacheIso;  m_SFCacheIso = nullptr;  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -547,6 +587,11 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
   std::vector< std::string >* sysVariationNamesIso   = new std::vector< std::string >;
   std::vector< std::string >* sysVariationNamesTrig  = new std::vector< std::string >;
 
+  // The SFs may depend on the data period: use the random run number assigned by the PRW tool, if any
+  //
+  static SG::AuxElement::ConstAccessor< unsigned int > randomRunNumberAcc("RandomRunNumber");
+  unsigned int runNumber = ( randomRunNumberAcc.isAvailable( *eventInfo ) ) ? randomRunNumberAcc( *eventInfo ) : eventInfo->runNumber();
+
   // 1.
   // Reco efficiency SFs - this is a per-MUON weight
   //
@@ -559,6 +604,10 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
   std::string RECO_SF_NAME_GLOBAL = m_outputSystNamesReco + "_GLOBAL";
   SG::AuxElement::Decorator< std::vector<float> > sfVecReco_GLOBAL ( RECO_SF_NAME_GLOBAL );
 
+  // Or store all the SFs in a single table (see ScaleFactorTable)
+  //
+  ScaleFactorTable* sfTableReco = ( m_writeSFTable ) ? new ScaleFactorTable( inputMuons, m_systListReco.size() ) : nullptr;
+
   for ( const auto& syst_it : m_systListReco ) {
 
     // Initialise product of SFs for *this* systematic
@@ -575,6 +624,7 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
     }
     if ( m_debug ) { Info("executeSF()", "Muon reco efficiency SF decoration name is: %s", sfName.c_str()); }
     sysVariationNamesReco->push_back(sfName);
+    const unsigned int systIdx = sysVariationNamesReco->size() - 1;
 
     // apply syst
     //
@@ -607,19 +657,19 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
        //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* muon)
        //
        SG::AuxElement::Decorator< std::vector<float> > sfVecReco( m_outputSystNamesReco );
-       if ( !sfVecReco.isAvailable( *mu_itr ) ) {
+       if ( !sfTableReco && !sfVecReco.isAvailable( *mu_itr ) ) {
 	 sfVecReco( *mu_itr ) = std::vector<float>();
        }
 
        float recoEffSF(1.0);
-       if ( m_asgMuonEffCorrTool_muSF_Reco->getEfficiencyScaleFactor( *mu_itr, recoEffSF ) != CP::CorrectionCode::Ok ) {
+       if ( this->getCachedSF( m_asgMuonEffCorrTool_muSF_Reco, m_SFCacheReco, syst_it, mu_itr, runNumber, recoEffSF ) != CP::CorrectionCode::Ok ) {
          Warning( "executeSF()", "Problem in getEfficiencyScaleFactor");
          recoEffSF = 1.0;
        }
        //
        // Add it to decoration vector
        //
-       sfVecReco( *mu_itr ).push_back( recoEffSF );
+       if ( sfTableReco ) { sfTableReco->set( *mu_itr, systIdx, recoEffSF ); } else { sfVecReco( *mu_itr ).push_back( recoEffSF ); }
 
        recoEffSF_GLOBAL *= recoEffSF;
 
@@ -651,6 +701,7 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
        Info( "executeSF()", "--------------------------------------");
     }
     sfVecReco_GLOBAL( *eventInfo ).push_back( recoEffSF_GLOBAL );
+    if ( sfTableReco ) { sfTableReco->setGlobal( systIdx, recoEffSF_GLOBAL ); }
 
   }  // close loop on reco efficiency SF systematics
 
@@ -666,6 +717,10 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
   std::string ISO_SF_NAME_GLOBAL = m_outputSystNamesIso + "_GLOBAL";
   SG::AuxElement::Decorator< std::vector<float> > sfVecIso_GLOBAL ( ISO_SF_NAME_GLOBAL );
 
+  // Or store all the SFs in a single table (see ScaleFactorTable)
+  //
+  ScaleFactorTable* sfTableIso = ( m_writeSFTable ) ? new ScaleFactorTable( inputMuons, m_systListIso.size() ) : nullptr;
+
   for ( const auto& syst_it : m_systListIso ) {
 
     // Initialise product of SFs for *this* systematic
@@ -682,6 +737,7 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
     }
     if ( m_debug ) { Info("executeSF()", "Muon iso efficiency SF decoration name is: %s", sfName.c_str()); }
     sysVariationNamesIso->push_back(sfName);
+    const unsigned int systIdx = sysVariationNamesIso->size() - 1;
 
     // apply syst
     //
@@ -714,19 +770,19 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
        //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* muon)
        //
        SG::AuxElement::Decorator< std::vector<float> > sfVecIso( m_outputSystNamesIso );
-       if ( !sfVecIso.isAvailable( *mu_itr ) ) {
+       if ( !sfTableIso && !sfVecIso.isAvailable( *mu_itr ) ) {
 	 sfVecIso( *mu_itr ) = std::vector<float>();
        }
 
        float IsoEffSF(1.0);
-       if ( m_asgMuonEffCorrTool_muSF_Iso->getEfficiencyScaleFactor( *mu_itr, IsoEffSF ) != CP::CorrectionCode::Ok ) {
+       if ( this->getCachedSF( m_asgMuonEffCorrTool_muSF_Iso, m_SFCacheIso, syst_it, mu_itr, runNumber, IsoEffSF ) != CP::CorrectionCode::Ok ) {
          Warning( "executeSF()", "Problem in getEfficiencyScaleFactor");
 	 IsoEffSF = 1.0;
        }
        //
        // Add it to decoration vector
        //
-       sfVecIso( *mu_itr ).push_back(IsoEffSF);
+       if ( sfTableIso ) { sfTableIso->set( *mu_itr, systIdx, IsoEffSF ); } else { sfVecIso( *mu_itr ).push_back( IsoEffSF ); }
 
        isoEffSF_GLOBAL *= IsoEffSF;
 
@@ -760,6 +816,7 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
        Info( "executeSF()", "--------------------------------------");
     }
     sfVecIso_GLOBAL( *eventInfo ).push_back( isoEffSF_GLOBAL );
+    if ( sfTableIso ) { sfTableIso->setGlobal( systIdx, isoEffSF_GLOBAL ); }
 
   }  // close loop on isolation efficiency SF systematics
 
@@ -858,5 +915,30 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF (  const xAOD::MuonContainer
     if ( !m_store->contains<std::vector<std::string> >(m_outputSystNamesTrig) ) { RETURN_CHECK( "MuonEfficiencyCorrector::executeSF()", m_store->record( sysVariationNamesTrig, m_outputSystNamesTrig), "Failed to record vector of systematic names for muon trigger efficiency  SF" ); }
   }
 
+  // Record the SF tables in TStore - one set per input container
+  //
+  if ( m_writeSFTable ) {
+    std::string tableSuffix = ( countSyst == 0 ) ? "_Table" : "_Table_" + std::to_string( countSyst );
+    if ( !m_store->contains<ScaleFactorTable>( m_outputSystNamesReco + tableSuffix ) ) { RETURN_CHECK( "MuonEfficiencyCorrector::executeSF()", m_store->record( sfTableReco, m_outputSystNamesReco + tableSuffix ), "Failed to record Reco SF table" ); } else { delete sfTableReco; }
+    if ( !m_store->contains<ScaleFactorTable>( m_outputSystNamesIso + tableSuffix ) ) { RETURN_CHECK( "MuonEfficiencyCorrector::executeSF()", m_store->record( sfTableIso, m_outputSystNamesIso + tableSuffix ), "Failed to record Iso SF table" ); } else { delete sfTableIso; }
+  }
+
   return EL::StatusCode::SUCCESS;
 }
+
+CP::CorrectionCode MuonEfficiencyCorrector :: getCachedSF ( CP::MuonEfficiencyScaleFactors* tool, ScaleFactorCache* cache, const CP::SystematicSet& syst,
+                                                            const xAOD::Muon* mu, unsigned int runNumber, float& sf )
+{
+  if ( !cache ) { return tool->getEfficiencyScaleFactor( *mu, sf ); }
+
+  // the muon type is part of the key, as e.g. calo-tagged muons get a dedicated SF
+  //
+  ScaleFactorCache::Key key = cache->makeKey( syst.hash(), mu->pt(), mu->eta(), mu->phi(), static_cast<int>( mu->muonType() ), runNumber );
+
+  if ( cache->get( key, sf ) ) { return CP::CorrectionCode::Ok; }
+
+  CP::CorrectionCode code = tool->getEfficiencyScaleFactor( *mu, sf );
+  if ( code == CP::CorrectionCode::Ok ) { cache->put( key, sf ); }
+
+  return code;
+}
@@ -97,17 +97,17 @@ StatusCode MuonHists::execute( const xAOD::Muon* muon, float eventWeight) {
   if(m_debug) std::cout << "in execute " <<std::endl;
 
   //basic
-  m_Pt ->        Fill( muon->pt()/1e3,    eventWeight );
-  m_Eta->        Fill( muon->eta(),       eventWeight );
-  m_Phi->        Fill( muon->phi(),       eventWeight );
-  m_M->          Fill( muon->m()/1e3,     eventWeight );
-  m_E->          Fill( muon->e()/1e3,     eventWeight );
+  fill( m_Pt,          muon->pt()/1e3,    eventWeight );
+  fill( m_Eta,         muon->eta(),       eventWeight );
+  fill( m_Phi,         muon->phi(),       eventWeight );
+  fill( m_M,           muon->m()/1e3,     eventWeight );
+  fill( m_E,           muon->e()/1e3,     eventWeight );
 
   // kinematic
   if( m_infoSwitch->m_kinematic ) {
-    m_Px->  Fill( muon->p4().Px()/1e3,  eventWeight );
-    m_Py->  Fill( muon->p4().Py()/1e3,  eventWeight );
-    m_Pz->  Fill( muon->p4().Pz()/1e3,  eventWeight );
+    fill( m_Px,   muon->p4().Px()/1e3,  eventWeight );
+    fill( m_Py,   muon->p4().Py()/1e3,  eventWeight );
+    fill( m_Pz,   muon->p4().Pz()/1e3,  eventWeight );
   } // fillKinematic
 
 
@@ -127,29 +127,29 @@ StatusCode MuonHists::execute( const xAOD::Muon* muon, float eventWeight) {
     static SG::AuxElement::Accessor<char> isIsoUserDefinedFixEfficiencyAcc ("isIsolated_UserDefinedFixEfficiency");
     static SG::AuxElement::Accessor<char> isIsoUserDefinedCutAcc ("isIsolated_UserDefinedCut");
 
-    if ( isIsoLooseTrackOnlyAcc.isAvailable( *muon ) ) { m_isIsolated_LooseTrackOnly->Fill( isIsoLooseTrackOnlyAcc( *muon ) ,  eventWeight ); } else {m_isIsolated_LooseTrackOnly->Fill( -1 ,  eventWeight );}
-    if ( isIsoLooseAcc.isAvailable( *muon ) )          { m_isIsolated_Loose->Fill( isIsoLooseAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_Loose->Fill( -1 ,  eventWeight ); }
-    if ( isIsoTightAcc.isAvailable( *muon ) )          { m_isIsolated_Tight->Fill( isIsoTightAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_Tight->Fill( -1 ,  eventWeight ); }
-    if ( isIsoGradientAcc.isAvailable( *muon ) )       { m_isIsolated_Gradient->Fill( isIsoGradientAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_Gradient->Fill( -1 ,  eventWeight ); }
-    if ( isIsoGradientLooseAcc.isAvailable( *muon ) )  { m_isIsolated_GradientLoose->Fill( isIsoGradientLooseAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_GradientLoose->Fill( -1 ,  eventWeight ); }
-    if ( isIsoGradientT1Acc.isAvailable( *muon ) )     { m_isIsolated_GradientT1->Fill( isIsoGradientT1Acc( *muon ) ,  eventWeight ); } else { m_isIsolated_GradientT1->Fill( -1 ,  eventWeight ); }
-    if ( isIsoGradientT2Acc.isAvailable( *muon ) )     { m_isIsolated_GradientT2->Fill( isIsoGradientT2Acc( *muon ) ,  eventWeight ); } else { m_isIsolated_GradientT2->Fill( -1 ,  eventWeight ); }
-    if ( isIsoMU0p06Acc.isAvailable( *muon ) )          { m_isIsolated_MU0p06->Fill( isIsoMU0p06Acc( *muon ) ,  eventWeight ); } else { m_isIsolated_MU0p06->Fill( -1 ,  eventWeight ); }
-    if ( isIsoFixedCutLooseAcc.isAvailable( *muon ) )          { m_isIsolated_FixedCutLoose->Fill( isIsoFixedCutLooseAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_FixedCutLoose->Fill( -1 ,  eventWeight ); }
-    if ( isIsoFixedCutTightAcc.isAvailable( *muon ) )          { m_isIsolated_FixedCutTight->Fill( isIsoFixedCutTightAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_FixedCutTight->Fill( -1 ,  eventWeight ); }
-    if ( isIsoFixedCutTightTrackOnlyAcc.isAvailable( *muon ) )          { m_isIsolated_FixedCutTightTrackOnly->Fill( isIsoFixedCutTightTrackOnlyAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_FixedCutTightTrackOnly->Fill( -1 ,  eventWeight ); }
-    if ( isIsoUserDefinedFixEfficiencyAcc.isAvailable( *muon ) ) { m_isIsolated_UserDefinedFixEfficiency->Fill( isIsoUserDefinedFixEfficiencyAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_UserDefinedFixEfficiency->Fill( -1 ,  eventWeight ); }
-    if ( isIsoUserDefinedCutAcc.isAvailable( *muon ) )           { m_isIsolated_UserDefinedCut->Fill( isIsoUserDefinedCutAcc( *muon ) ,  eventWeight ); } else { m_isIsolated_UserDefinedCut->Fill( -1 ,  eventWeight ); }
-
-    m_ptcone20     ->Fill( muon->isolation( xAOD::Iso::ptcone20 )     / 1e3,  eventWeight );
-    m_ptcone30     ->Fill( muon->isolation( xAOD::Iso::ptcone30 )     / 1e3,  eventWeight );
-    m_ptcone40     ->Fill( muon->isolation( xAOD::Iso::ptcone40 )     / 1e3,  eventWeight );
-    m_ptvarcone20  ->Fill( muon->isolation( xAOD::Iso::ptvarcone20 )  / 1e3,  eventWeight );
-    m_ptvarcone30  ->Fill( muon->isolation( xAOD::Iso::ptvarcone30 )  / 1e3,  eventWeight );
-    m_ptvarcone40  ->Fill( muon->isolation( xAOD::Iso::ptvarcone40 )  / 1e3,  eventWeight );
-    m_topoetcone20 ->Fill( muon->isolation( xAOD::Iso::topoetcone20 ) / 1e3,  eventWeight );
-    m_topoetcone30 ->Fill( muon->isolation( xAOD::Iso::topoetcone30 ) / 1e3,  eventWeight );
-    m_topoetcone40 ->Fill( muon->isolation( xAOD::Iso::topoetcone40 ) / 1e3,  eventWeight );
+    if ( isIsoLooseTrackOnlyAcc.isAvailable( *muon ) ) { fill( m_isIsolated_LooseTrackOnly, isIsoLooseTrackOnlyAcc( *muon ) ,  eventWeight ); } else {fill( m_isIsolated_LooseTrackOnly, -1 ,  eventWeight );}
+    if ( isIsoLooseAcc.isAvailable( *muon ) )          { fill( m_isIsolated_Loose, isIsoLooseAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_Loose, -1 ,  eventWeight ); }
+    if ( isIsoTightAcc.isAvailable( *muon ) )          { fill( m_isIsolated_Tight, isIsoTightAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_Tight, -1 ,  eventWeight ); }
+    if ( isIsoGradientAcc.isAvailable( *muon ) )       { fill( m_isIsolated_Gradient, isIsoGradientAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_Gradient, -1 ,  eventWeight ); }
+    if ( isIsoGradientLooseAcc.isAvailable( *muon ) )  { fill( m_isIsolated_GradientLoose, isIsoGradientLooseAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_GradientLoose, -1 ,  eventWeight ); }
+    if ( isIsoGradientT1Acc.isAvailable( *muon ) )     { fill( m_isIsolated_GradientT1, isIsoGradientT1Acc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_GradientT1, -1 ,  eventWeight ); }
+    if ( isIsoGradientT2Acc.isAvailable( *muon ) )     { fill( m_isIsolated_GradientT2, isIsoGradientT2Acc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_GradientT2, -1 ,  eventWeight ); }
+    if ( isIsoMU0p06Acc.isAvailable( *muon ) )          { fill( m_isIsolated_MU0p06, isIsoMU0p06Acc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_MU0p06, -1 ,  eventWeight ); }
+    if ( isIsoFixedCutLooseAcc.isAvailable( *muon ) )          { fill( m_isIsolated_FixedCutLoose, isIsoFixedCutLooseAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_FixedCutLoose, -1 ,  eventWeight ); }
+    if ( isIsoFixedCutTightAcc.isAvailable( *muon ) )          { fill( m_isIsolated_FixedCutTight, isIsoFixedCutTightAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_FixedCutTight, -1 ,  eventWeight ); }
+    if ( isIsoFixedCutTightTrackOnlyAcc.isAvailable( *muon ) )          { fill( m_isIsolated_FixedCutTightTrackOnly, isIsoFixedCutTightTrackOnlyAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_FixedCutTightTrackOnly, -1 ,  eventWeight ); }
+    if ( isIsoUserDefinedFixEfficiencyAcc.isAvailable( *muon ) ) { fill( m_isIsolated_UserDefinedFixEfficiency, isIsoUserDefinedFixEfficiencyAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_UserDefinedFixEfficiency, -1 ,  eventWeight ); }
+    if ( isIsoUserDefinedCutAcc.isAvailable( *muon ) )           { fill( m_isIsolated_UserDefinedCut, isIsoUserDefinedCutAcc( *muon ) ,  eventWeight ); } else { fill( m_isIsolated_UserDefinedCut, -1 ,  eventWeight ); }
+
+    fill( m_ptcone20,      muon->isolation( xAOD::Iso::ptcone20 )     / 1e3,  eventWeight );
+    fill( m_ptcone30,      muon->isolation( xAOD::Iso::ptcone30 )     / 1e3,  eventWeight );
+    fill( m_ptcone40,      muon->isolation( xAOD::Iso::ptcone40 )     / 1e3,  eventWeight );
+    fill( m_ptvarcone20,   muon->isolation( xAOD::Iso::ptvarcone20 )  / 1e3,  eventWeight );
+    fill( m_ptvarcone30,   muon->isolation( xAOD::Iso::ptvarcone30 )  / 1e3,  eventWeight );
+    fill( m_ptvarcone40,   muon->isolation( xAOD::Iso::ptvarcone40 )  / 1e3,  eventWeight );
+    fill( m_topoetcone20,  muon->isolation( xAOD::Iso::topoetcone20 ) / 1e3,  eventWeight );
+    fill( m_topoetcone30,  muon->isolation( xAOD::Iso::topoetcone30 ) / 1e3,  eventWeight );
+    fill( m_topoetcone40,  muon->isolation( xAOD::Iso::topoetcone40 ) / 1e3,  eventWeight );
 
   }
 
@@ -160,10 +160,10 @@ StatusCode MuonHists::execute( const xAOD::Muon* muon, float eventWeight) {
     static SG::AuxElement::Accessor<char> isMediumQAcc ("isMediumQ");
     static SG::AuxElement::Accessor<char> isTightQAcc ("isTightQ");
 
-    if( isVeryLooseQAcc.isAvailable( *muon ) ) { m_isVeryLoose->Fill( static_cast<int>(isVeryLooseQAcc( *muon )),  eventWeight ); } else { m_isVeryLoose->Fill( -1 ,  eventWeight ); }
-    if( isLooseQAcc.isAvailable( *muon ) )     { m_isLoose    ->Fill( static_cast<int>(isLooseQAcc    ( *muon )),  eventWeight ); }         else { m_isLoose->Fill( -1 ,  eventWeight ); }
-    if( isMediumQAcc.isAvailable( *muon ) )    { m_isMedium   ->Fill( static_cast<int>(isMediumQAcc   ( *muon )),  eventWeight ); }       else { m_isMedium->Fill( -1 ,  eventWeight ); }
-    if( isTightQAcc.isAvailable( *muon ) )     { m_isTight    ->Fill( static_cast<int>(isTightQAcc    ( *muon )),  eventWeight ); }         else { m_isTight->Fill( -1 ,  eventWeight ); }
+    if( isVeryLooseQAcc.isAvailable( *muon ) ) { fill( m_isVeryLoose, static_cast<int>(isVeryLooseQAcc( *muon )),  eventWeight ); } else { fill( m_isVeryLoose, -1 ,  eventWeight ); }
+    if( isLooseQAcc.isAvailable( *muon ) )     { fill( m_isLoose,     static_cast<int>(isLooseQAcc    ( *muon )),  eventWeight ); }         else { fill( m_isLoose, -1 ,  eventWeight ); }
+    if( isMediumQAcc.isAvailable( *muon ) )    { fill( m_isMedium,    static_cast<int>(isMediumQAcc   ( *muon )),  eventWeight ); }       else { fill( m_isMedium, -1 ,  eventWeight ); }
+    if( isTightQAcc.isAvailable( *muon ) )     { fill( m_isTight,     static_cast<int>(isTightQAcc    ( *muon )),  eventWeight ); }         else { fill( m_isTight, -1 ,  eventWeight ); }
 
   }
 
@@ -18,11 +18,15 @@
 ClassImp(MuonHistsAlgo)
 
 MuonHistsAlgo :: MuonHistsAlgo (std::string className) :
-    Algorithm(className)
+    Algorithm(className),
+    m_skim(nullptr)
 {
   m_inContainerName         = "";
   // which plots will be turned on
   m_detailStr               = "";
+  m_eventWeightName         = "";
+  m_fillWeightSysts         = false;
+  m_skimPredicate           = "";
   // name of algo input container comes from - only if
   m_inputAlgo               = "";
 
@@ -54,6 +58,7 @@ EL::StatusCode MuonHistsAlgo::AddHists( std::string name ) {
   RETURN_CHECK("MuonHistsAlgo::AddHists", muonHists->initialize(), "");
   muonHists->record( wk() );
   m_plots[name] = muonHists;
+  if( !m_weightChannels.empty() ) { m_plots[name]->setWeightChannels( m_weightChannels, wk() ); }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -67,6 +72,9 @@ EL::StatusCode MuonHistsAlgo :: configure ()
     m_inContainerName         = config->GetValue("InputContainer",  m_inContainerName.c_str());
     // which plots will be turned on
     m_detailStr               = config->GetValue("DetailStr",       m_detailStr.c_str());
+    m_eventWeightName         = config->GetValue("EventWeightName", m_eventWeightName.c_str());
+    m_fillWeightSysts         = config->GetValue("FillWeightSysts", m_fillWeightSysts);
+    m_skimPredicate           = config->GetValue("SkimPredicate",   m_skimPredicate.c_str());
     // name of algo input container comes from - only if
     m_inputAlgo               = config->GetValue("InputAlgo",       m_inputAlgo.c_str());
 
@@ -108,6 +116,7 @@ EL::StatusCode MuonHistsAlgo :: initialize ()
   if(m_inputAlgo.empty()) { AddHists( "" ); }
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
+  RETURN_CHECK("MuonHistsAlgo::initialize()", EventSkim::create( m_skimPredicate, m_skim ), "");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -116,9 +125,17 @@ EL::StatusCode MuonHistsAlgo :: execute ()
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("MuonHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
 
+  // skim first, so that the rejected events cost nothing else
+  bool passSkim(true);
+  RETURN_CHECK("MuonHistsAlgo::execute()", EventSkim::passes( m_skim, eventInfo, m_event, m_store, passSkim ), "");
+  if ( !passSkim ) { return EL::StatusCode::SUCCESS; }
+
+  // event weight, and the weight systematics if requested (see HistogramManager::readEventWeights)
   float eventWeight(1);
-  if( eventInfo->isAvailable< float >( "mcEventWeight" ) ) {
-    eventWeight = eventInfo->auxdecor< float >( "mcEventWeight" );
+  const std::vector<float>* eventWeights(nullptr);
+  RETURN_CHECK("MuonHistsAlgo::execute()", HistogramManager::readEventWeights( eventInfo, m_eventWeightName, m_fillWeightSysts, m_store, eventWeight, eventWeights, m_weightChannels ), "");
+  if( eventWeights ) {
+    for( auto plots : m_plots ) { plots.second->setEventWeights( m_weightChannels, *eventWeights, wk() ); }
   }
 
   // this will hold the collection processed
@@ -150,7 +167,10 @@ EL::StatusCode MuonHistsAlgo :: execute ()
     // loop over systematics
     for( auto systName : *systNames ) {
       RETURN_CHECK("MuonHistsAlgo::execute()", HelperFunctions::retrieve(inMuons, m_inContainerName+systName, m_event, m_store, m_verbose) ,"");
-      if( m_plots.find( systName ) == m_plots.end() ) { this->AddHists( systName ); }
+      if( m_plots.find( systName ) == m_plots.end() ) {
+        this->AddHists( systName );
+        if( eventWeights ) { m_plots[systName]->setEventWeights( m_weightChannels, *eventWeights, wk() ); }
+      }
       RETURN_CHECK("MuonHistsAlgo::execute()", m_plots[systName]->execute( inMuons, eventWeight ), "");
     }
 
@@ -168,6 +188,7 @@ EL::StatusCode MuonHistsAlgo :: finalize () {
       if(plots.second) delete plots.second;
     }
   }
+  EventSkim::release( m_skim );
   return EL::StatusCode::SUCCESS;
 }
 
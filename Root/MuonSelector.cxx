@@ -31,6 +31,7 @@
 #include "TrigConfxAOD/xAODConfigTool.h"
 #include "TrigDecisionTool/TrigDecisionTool.h"
 #include "TrigMuonMatching/TrigMuonMatching.h"
+#include "xAODAnaHelpers/TrigMatchingEngine.h"
 #include "PATCore/TAccept.h"
 
 // ROOT include(s):
@@ -50,10 +51,12 @@ MuonSelector :: MuonSelector (std::string className) :
     m_cutflowHistW(nullptr),
     m_mu_cutflowHist_1(nullptr),
     m_mu_cutflowHist_2(nullptr),
+    m_MinIsoCutPosition(0),
     m_IsolationSelectionTool(nullptr),
     m_muonSelectionTool(nullptr),
     m_trigDecTool(nullptr),
-    m_trigMuonMatchTool(nullptr)
+    m_trigMuonMatchTool(nullptr),
+    m_trigMuonMatchEngine(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -115,12 +118,14 @@ MuonSelector :: MuonSelector (std::string className) :
   m_TrackIsoEff             = "98";
   m_CaloBasedIsoType        = "topoetcone20";
   m_TrackBasedIsoType       = "ptvarcone30";
+  m_singlePassIso           = false;
 
   // trigger matching stuff
   //
   m_singleMuTrigChains      = "";
   m_diMuTrigChains          = "";
   m_minDeltaR               = 0.1;
+  m_useTrigMatchingEngine   = false;
 
 }
 
@@ -166,12 +171,14 @@ EL::StatusCode  MuonSelector :: configure ()
     m_TrackIsoEff             = config->GetValue("TrackIsoEfficiency",  m_TrackIsoEff.c_str());
     m_CaloBasedIsoType        = config->GetValue("CaloBasedIsoType"  ,  m_CaloBasedIsoType.c_str());
     m_TrackBasedIsoType       = config->GetValue("TrackBasedIsoType" ,  m_TrackBasedIsoType.c_str());
+    m_singlePassIso           = config->GetValue("SinglePassIsolation", m_singlePassIso);
 
     m_singleMuTrigChains      = config->GetValue("SingleMuTrigChains" , m_singleMuTrigChains.c_str() );
     m_singleMuTrigChains      = config->GetValue("SingleMuTrigChain" , m_singleMuTrigChains.c_str() );
     m_diMuTrigChains	      = config->GetValue("DiMuTrigChains"     , m_diMuTrigChains.c_str() );
     m_diMuTrigChains	      = config->GetValue("DiMuTrigChain"     , m_diMuTrigChains.c_str() );
     m_minDeltaR 	      = config->GetValue("MinDeltaR"         , m_minDeltaR );
+    m_useTrigMatchingEngine   = config->GetValue("UseTrigMatchingEngine", m_useTrigMatchingEngine );
 
     config->Print();
 
@@ -529,6 +536,13 @@ EL::StatusCode MuonSelector :: execute ()
     for ( auto const &chain : m_diMuTrigChainsList ) { Info("execute()", "\t %s", chain.c_str()); }
     Info("execute()", "\n");
 
+    // batched matching for the single muon chains (di-muon chains are still handled by TrigMuonMatching)
+    //
+    if ( m_useTrigMatchingEngine ) {
+      Info("execute()", "Single muon trigger matching will be done w/ TrigMatchingEngine - results in 'isTrigMatchedVecMu' decoration");
+      m_trigMuonMatchEngine = new TrigMatchingEngine( m_trigDecTool, TrigMatchingEngine::FeatureType::Muon, m_singleMuTrigChainsList, "isTrigMatchedVecMu", m_minDeltaR, m_debug );
+    }
+
   }
 
   // did any collection pass the cuts?
@@ -729,25 +743,36 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
 
       if ( m_debug ) { Info("executeSelection()", "Single Muon Trigger Matching "); }
 
-      for ( auto const &chain : m_singleMuTrigChainsList ) {
+      // match all the selected muons against all the chains in one go
+      //
+      if ( m_trigMuonMatchEngine ) {
 
-        if ( m_debug ) { Info("executeSelection()", "\t checking trigger chain %s", chain.c_str()); }
+        const xAOD::EventInfo* eventInfo(nullptr);
+        RETURN_CHECK("MuonSelector::executeSelection()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
 
-        for ( auto const muon : *selectedMuons ) {
+        RETURN_CHECK("MuonSelector::executeSelection()", m_trigMuonMatchEngine->fetchFeatures( eventInfo ), "Failed to fetch HLT muon features");
+        m_trigMuonMatchEngine->match( selectedMuons );
+      } else {
+        for ( auto const &chain : m_singleMuTrigChainsList ) {
 
-          //  For each muon, decorate w/ a map<string,char> with the 'isMatched' info associated
-          //  to each trigger chain in the input list.
-          //  If decoration map doesn't exist for this muon yet, create it (will be done only for the 1st iteration on the chain names)
-          //
-          if ( !isTrigMatchedMapMuDecor.isAvailable( *muon ) ) {
-            isTrigMatchedMapMuDecor( *muon ) = std::map<std::string,char>();
-          }
+          if ( m_debug ) { Info("executeSelection()", "\t checking trigger chain %s", chain.c_str()); }
 
-          int matched = ( m_trigMuonMatchTool->match( muon, chain, m_minDeltaR ) ) ? 1 : 0;
+          for ( auto const muon : *selectedMuons ) {
 
-          if ( m_debug ) { Info("executeSelection()", "\t\t is muon trigger matched? %i", matched); }
+            //  For each muon, decorate w/ a map<string,char> with the 'isMatched' info associated
+            //  to each trigger chain in the input list.
+            //  If decoration map doesn't exist for this muon yet, create it (will be done only for the 1st iteration on the chain names)
+            //
+            if ( !isTrigMatchedMapMuDecor.isAvailable( *muon ) ) {
+              isTrigMatchedMapMuDecor( *muon ) = std::map<std::string,char>();
+            }
 
-          ( isTrigMatchedMapMuDecor( *muon ) )[chain] = static_cast<char>(matched);
+            int matched = ( m_trigMuonMatchTool->match( muon, chain, m_minDeltaR ) ) ? 1 : 0;
+
+            if ( m_debug ) { Info("executeSelection()", "\t\t is muon trigger matched? %i", matched); }
+
+            ( isTrigMatchedMapMuDecor( *muon ) )[chain] = static_cast<char>(matched);
+          }
         }
       }
 
@@ -827,6 +852,7 @@ EL::StatusCode MuonSelector :: finalize ()
   if ( m_muonSelectionTool )      { m_muonSelectionTool = nullptr;      delete m_muonSelectionTool;      }
   if ( m_IsolationSelectionTool ) { m_IsolationSelectionTool = nullptr; delete m_IsolationSelectionTool; }
   if ( m_trigMuonMatchTool )      {  m_trigMuonMatchTool = nullptr;     delete m_trigMuonMatchTool;      }
+  if ( m_trigMuonMatchEngine )    {  delete m_trigMuonMatchEngine;      m_trigMuonMatchEngine = nullptr; }
 
   if ( m_useCutFlow ) {
     Info("histFinalize()", "Filling cutflow");
@@ -1000,24 +1026,73 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
   //
   Root::TAccept accept_list = m_IsolationSelectionTool->accept( *muon );
 
-  // Decorate w/ decision for all input WPs
-  //
-  std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
+  if ( m_singlePassIso ) {
 
-    std::string decorWP = base_decor + "_" + WP_itr;
+    // Resolve the position of each WP in the TAccept (and its bit in the packed word) only once,
+    // so that no string lookup is needed per object
+    //
+    if ( m_IsoCutPositions.empty() ) {
+      for ( auto WP_itr : m_IsoKeys ) {
+        m_IsoCutPositions.push_back( accept_list.getCutPosition( WP_itr.c_str() ) );
+        m_IsoBits.push_back( HelperFunctions::getIsolationWPBit( WP_itr ) );
+        if ( m_IsoBits.back() < 0 ) { Warning("PassCuts()", "Isolation WP %s cannot be packed in 'isIsolatedBits': will decorate w/ 'isIsolated_%s' instead", WP_itr.c_str(), WP_itr.c_str() ); }
+      }
+      if ( !m_MinIsoWPCut.empty() ) { m_MinIsoCutPosition = accept_list.getCutPosition( m_MinIsoWPCut.c_str() ); }
+    }
 
-    if ( m_debug ) { Info("PassCuts()", "Decorate muon with %s - accept() ? %i", decorWP.c_str(), accept_list.getCutResult( WP_itr.c_str()) ); }
-    muon->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+    // Decorate w/ decision for all input WPs in one word
+    //
+    uint32_t isoBits(0);
+    for ( unsigned int idx(0); idx < m_IsoKeys.size(); ++idx ) {
 
-  }
+      bool pass = accept_list.getCutResult( m_IsoCutPositions.at(idx) );
+      int  bit  = m_IsoBits.at(idx);
+
+      if ( bit < 0 ) {
+        muon->auxdecor<char>( "isIsolated_" + m_IsoKeys.at(idx) ) = static_cast<char>( pass );
+        continue;
+      }
+
+      if ( pass ) { isoBits |= ( 1u << bit ); }
+      isoBits |= ( 1u << ( bit + 16 ) );
+
+    }
+
+    static SG::AuxElement::Decorator< uint32_t > isoBitsDecor("isIsolatedBits");
+    isoBitsDecor( *muon ) = isoBits;
+
+    if ( m_debug ) { Info("PassCuts()", "Decorate muon with isIsolatedBits = 0x%08x", isoBits ); }
+
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoCutPosition ) ) {
+      if ( m_debug ) { Info("PassCuts()", "Muon failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
+      return 0;
+    }
+
+  } else {
+
+    // Decorate w/ decision for all input WPs
+    //
+    std::string base_decor("isIsolated");
+    for ( auto WP_itr : m_IsoKeys ) {
+
+      std::string decorWP = base_decor + "_" + WP_itr;
+
+      if ( m_debug ) { Info("PassCuts()", "Decorate muon with %s - accept() ? %i", decorWP.c_str(), accept_list.getCutResult( WP_itr.c_str()) ); }
+      muon->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+
+    }
+
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+      if ( m_debug ) { Info("PassCuts()", "Muon failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
+      return 0;
+    }
 
-  // Apply the cut if needed
-  //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
-    if ( m_debug ) { Info("PassCuts()", "Muon failed isolation cut %s ",  m_MinIsoWPCut.c_str() ); }
-    return 0;
   }
+
   if(m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_iso_cut, 1 );
   if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_iso_cut, 1 ); }
 
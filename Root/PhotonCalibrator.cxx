@@ -102,6 +102,8 @@ PhotonCalibrator :: PhotonCalibrator (std::string className) :
   m_esModel                 = "";
   m_decorrelationModel      = "";
 
+  m_singlePassPID           = false;
+
 }
 
 
@@ -133,6 +135,8 @@ EL::StatusCode  PhotonCalibrator :: configure ()
 
     m_useAFII                 = config->GetValue("AFII" , false );
 
+    m_singlePassPID           = config->GetValue("SinglePassPID" , m_singlePassPID );
+
     config->Print();
 
     Info("configure()", "PhotonCalibrator Interface succesfully configured! ");
@@ -585,9 +589,19 @@ EL::StatusCode PhotonCalibrator :: decorate(xAOD::Photon* photon)
   }
 
   // (2) evaluate the ID quality
-  const bool isTight  = m_photonTightIsEMSelector->accept(photon);
-  const bool isMedium = m_photonMediumIsEMSelector->accept(photon);
-  const bool isLoose  = m_photonLooseIsEMSelector->accept(photon);
+  //
+  // in single-pass mode, exploit the nesting of the photon menus (Tight is a subset of Medium, which is a subset of Loose):
+  // evaluate from the loosest, and do not re-run the tighter selectors once a menu fails
+  bool isTight(false), isMedium(false), isLoose(false);
+  if ( m_singlePassPID ) {
+    isLoose  = m_photonLooseIsEMSelector->accept(photon);
+    isMedium = isLoose  && m_photonMediumIsEMSelector->accept(photon);
+    isTight  = isMedium && m_photonTightIsEMSelector->accept(photon);
+  } else {
+    isTight  = m_photonTightIsEMSelector->accept(photon);
+    isMedium = m_photonMediumIsEMSelector->accept(photon);
+    isLoose  = m_photonLooseIsEMSelector->accept(photon);
+  }
   photon->auxdecor< bool >( "PhotonID_Tight"    ) = isTight;
   photon->auxdecor< bool >( "PhotonID_Medium"   ) = isMedium;
   photon->auxdecor< bool >( "PhotonID_Loose"    ) = isLoose;
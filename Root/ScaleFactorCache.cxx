@@ -0,0 +1,119 @@
+/******************************************
+ *
+ * Bounded LRU cache of binned scale factors,
+ * to avoid calling the CP efficiency tools
+ * again for objects in an already seen bin.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+// package include(s):
+#include "xAODAnaHelpers/ScaleFactorCache.h"
+
+// ROOT include(s):
+#include "TError.h"
+
+ScaleFactorCache::ScaleFactorCache( const std::string& name, unsigned int maxSize,
+                                    const std::string& ptBins, const std::string& etaBins, const std::string& phiBins ) :
+  m_name(name),
+  m_maxSize(maxSize),
+  m_hits(0),
+  m_misses(0)
+{
+  m_ptBins  = this->parseEdges( ptBins );
+  m_etaBins = this->parseEdges( etaBins );
+  m_phiBins = this->parseEdges( phiBins );
+}
+
+ScaleFactorCache::~ScaleFactorCache() {}
+
+std::vector<float> ScaleFactorCache::parseEdges( const std::string& edges ) const
+{
+  std::vector<float> parsed;
+
+  std::istringstream ss(edges);
+  std::string token;
+  while ( std::getline(ss, token, ',') ) {
+    if ( token.find_first_not_of(" ") == std::string::npos ) { continue; }
+    parsed.push_back( std::stof(token) );
+  }
+  std::sort( parsed.begin(), parsed.end() );
+
+  return parsed;
+}
+
+int64_t ScaleFactorCache::getBin( const std::vector<float>& edges, float value ) const
+{
+  if ( edges.empty() ) {
+    uint32_t bits(0);
+    std::memcpy( &bits, &value, sizeof(bits) );
+    return static_cast<int64_t>(bits);
+  }
+  return std::upper_bound( edges.begin(), edges.end(), value ) - edges.begin();
+}
+
+ScaleFactorCache::Key ScaleFactorCache::makeKey( std::size_t systHash, float pt, float eta, float phi, int label, unsigned int runNumber ) const
+{
+  // convert to GeV only to find the bin, so that exact values are not rounded
+  //
+  float ptBinVar = m_ptBins.empty() ? pt : pt * 1e-3;
+  return Key( systHash, this->getBin( m_ptBins, ptBinVar ), this->getBin( m_etaBins, eta ), this->getBin( m_phiBins, phi ), label, runNumber );
+}
+
+bool ScaleFactorCache::get( const Key& key, float& sf )
+{
+  auto index_itr = m_index.find( key );
+  if ( index_itr == m_index.end() ) {
+    ++m_misses;
+    return false;
+  }
+
+  // move the entry to the front
+  m_entries.splice( m_entries.begin(), m_entries, index_itr->second );
+
+  sf = index_itr->second->second;
+  ++m_hits;
+  return true;
+}
+
+void ScaleFactorCache::put( const Key& key, float sf )
+{
+  if ( m_maxSize == 0 ) { return; }
+
+  auto index_itr = m_index.find( key );
+  if ( index_itr != m_index.end() ) {
+    index_itr->second->second = sf;
+    m_entries.splice( m_entries.begin(), m_entries, index_itr->second );
+    return;
+  }
+
+  if ( m_entries.size() >= m_maxSize ) {
+    m_index.erase( m_entries.back().first );
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front( key, sf );
+  m_index[key] = m_entries.begin();
+}
+
+void ScaleFactorCache::clear()
+{
+  m_entries.clear();
+  m_index.clear();
+}
+
+float ScaleFactorCache::getHitRate() const
+{
+  unsigned long long calls = m_hits + m_misses;
+  return ( calls > 0 ) ? static_cast<float>(m_hits) / calls : 0.0;
+}
+
+void ScaleFactorCache::printStats() const
+{
+  Info("ScaleFactorCache::printStats()", "%s: %llu hits, %llu misses (hit rate = %.1f %%), %lu entries (max %u)",
+       m_name.c_str(), m_hits, m_misses, 100.0 * this->getHitRate(), m_entries.size(), m_maxSize );
+}
@@ -0,0 +1,70 @@
+/******************************************
+ *
+ * Contiguous objects-by-systematics table
+ * of scale factors, to be stored in TStore
+ * instead of per-object vector decorations.
+ *
+ ******************************************/
+
+// package include(s):
+#include "xAODAnaHelpers/ScaleFactorTable.h"
+
+ScaleFactorTable::ScaleFactorTable() :
+  m_container(nullptr),
+  m_nRows(0),
+  m_nSysts(0),
+  m_defaultSF(-999.0)
+{ }
+
+ScaleFactorTable::ScaleFactorTable( const xAOD::IParticleContainer* objects, unsigned int nSysts, float defaultSF ) :
+  m_container(nullptr),
+  m_nRows(0),
+  m_nSysts(nSysts),
+  m_defaultSF(defaultSF)
+{
+
+  // the objects are indexed by their position in the original container, so that views can be tabulated as well
+  //
+  for ( auto obj : *objects ) {
+    if ( !m_container ) { m_container = obj->container(); }
+    if ( obj->container() != m_container ) { continue; }
+    if ( obj->index() + 1 > m_nRows ) { m_nRows = obj->index() + 1; }
+  }
+
+  m_sfs.assign( m_nRows * m_nSysts, m_defaultSF );
+  m_filled.assign( m_nRows, 0 );
+  m_global.assign( m_nSysts, m_defaultSF );
+
+}
+
+ScaleFactorTable::~ScaleFactorTable() {}
+
+bool ScaleFactorTable::set( const SG::AuxElement& obj, unsigned int systIdx, float sf )
+{
+  if ( obj.container() != m_container || obj.index() >= m_nRows || systIdx >= m_nSysts ) { return false; }
+
+  m_sfs[ obj.index() * m_nSysts + systIdx ] = sf;
+  m_filled[ obj.index() ] = 1;
+
+  return true;
+}
+
+void ScaleFactorTable::setGlobal( unsigned int systIdx, float sf )
+{
+  if ( systIdx < m_nSysts ) { m_global[systIdx] = sf; }
+}
+
+const float* ScaleFactorTable::getRow( const SG::AuxElement& obj ) const
+{
+  if ( obj.container() != m_container || obj.index() >= m_nRows || !m_filled[ obj.index() ] ) { return nullptr; }
+
+  return &m_sfs[ obj.index() * m_nSysts ];
+}
+
+float ScaleFactorTable::get( const SG::AuxElement& obj, unsigned int systIdx ) const
+{
+  const float* row = this->getRow( obj );
+  if ( !row || systIdx >= m_nSysts ) { return m_defaultSF; }
+
+  return row[systIdx];
+}
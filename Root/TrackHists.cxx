@@ -143,32 +143,32 @@ StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vert
 
   float        sinT        = sin(trk->theta());
 
-  m_trk_Pt       -> Fill( trkPt,            eventWeight );
-  m_trk_Pt_l     -> Fill( trkPt,            eventWeight );
-  m_trk_Eta      -> Fill( trk->eta(),       eventWeight );
-  m_trk_Phi      -> Fill( trk->phi(),       eventWeight );
-  m_trk_d0       -> Fill( d0,               eventWeight );
-  m_trk_z0       -> Fill( z0,               eventWeight );
-  m_trk_z0sinT   -> Fill(z0*sinT,           eventWeight );
+  fill( m_trk_Pt,         trkPt,            eventWeight );
+  fill( m_trk_Pt_l,       trkPt,            eventWeight );
+  fill( m_trk_Eta,        trk->eta(),       eventWeight );
+  fill( m_trk_Phi,        trk->phi(),       eventWeight );
+  fill( m_trk_d0,         d0,               eventWeight );
+  fill( m_trk_z0,         z0,               eventWeight );
+  fill( m_trk_z0sinT,    z0*sinT,           eventWeight );
 
-  m_trk_chi2Prob -> Fill( chi2Prob ,        eventWeight );
-  m_trk_charge   -> Fill( trk->charge() ,   eventWeight );
+  fill( m_trk_chi2Prob,   chi2Prob ,        eventWeight );
+  fill( m_trk_charge,     trk->charge() ,   eventWeight );
 
   if(m_fillIPDetails){
     float d0Err = sqrt((trk->definingParametersCovMatrixVec().at(0)));
     float d0Sig = (d0Err > 0) ? d0/d0Err : -1 ;
-    m_trk_d0_l         -> Fill(d0    , eventWeight );
-    m_trk_d0Err        -> Fill(d0Err , eventWeight );
-    m_trk_d0Sig        -> Fill(d0Sig , eventWeight );
+    fill( m_trk_d0_l,          d0    , eventWeight );
+    fill( m_trk_d0Err,         d0Err , eventWeight );
+    fill( m_trk_d0Sig,         d0Sig , eventWeight );
 
     float z0Err = sqrt((trk->definingParametersCovMatrixVec().at(2)));
     float z0Sig = (z0Err > 0) ? z0/z0Err : -1 ;
 
-    m_trk_z0_l         -> Fill(z0         , eventWeight );
-    m_trk_z0sinT_l     -> Fill(z0*sinT,     eventWeight );
-    m_trk_z0Err        -> Fill(z0Err      , eventWeight );
-    m_trk_z0Sig        -> Fill(z0Sig      , eventWeight );
-    m_trk_z0SigsinT    -> Fill(z0Sig*sinT , eventWeight );
+    fill( m_trk_z0_l,          z0         , eventWeight );
+    fill( m_trk_z0sinT_l,      z0*sinT,     eventWeight );
+    fill( m_trk_z0Err,         z0Err      , eventWeight );
+    fill( m_trk_z0Sig,         z0Sig      , eventWeight );
+    fill( m_trk_z0SigsinT,     z0Sig*sinT , eventWeight );
 
   }
 
@@ -190,13 +190,13 @@ StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vert
 
     uint8_t nSi     = nPix     + nSCT;
     uint8_t nSiDead = nPixDead + nSCTDead;
-    m_trk_nBL        -> Fill( nBL         , eventWeight );
-    m_trk_nSi        -> Fill( nSi         , eventWeight );
-    m_trk_nSiAndDead -> Fill( nSi+nSiDead , eventWeight );
-    m_trk_nSiDead    -> Fill( nSiDead     , eventWeight );
-    m_trk_nSCT       -> Fill( nSCT        , eventWeight );
-    m_trk_nPix       -> Fill( nPix        , eventWeight );
-    m_trk_nPixHoles  -> Fill( nPixHoles   , eventWeight );
+    fill( m_trk_nBL,          nBL         , eventWeight );
+    fill( m_trk_nSi,          nSi         , eventWeight );
+    fill( m_trk_nSiAndDead,   nSi+nSiDead , eventWeight );
+    fill( m_trk_nSiDead,      nSiDead     , eventWeight );
+    fill( m_trk_nSCT,         nSCT        , eventWeight );
+    fill( m_trk_nPix,         nPix        , eventWeight );
+    fill( m_trk_nPixHoles,    nPixHoles   , eventWeight );
 
   }
 
@@ -208,21 +208,21 @@ StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vert
 
   if(m_fillChi2Details){
     float chi2NDoF     = (ndof > 0) ? chi2/ndof : -1;
-    m_trk_chi2Prob_l   -> Fill(chi2Prob   , eventWeight );
-    m_trk_chi2Prob_s   -> Fill(chi2Prob   , eventWeight );
-    m_trk_chi2Prob_ss  -> Fill(chi2Prob   , eventWeight );
-    m_trk_chi2ndof     -> Fill(chi2NDoF   , eventWeight );
-    m_trk_chi2ndof_l   -> Fill(chi2NDoF   , eventWeight );
+    fill( m_trk_chi2Prob_l,    chi2Prob   , eventWeight );
+    fill( m_trk_chi2Prob_s,    chi2Prob   , eventWeight );
+    fill( m_trk_chi2Prob_ss,   chi2Prob   , eventWeight );
+    fill( m_trk_chi2ndof,      chi2NDoF   , eventWeight );
+    fill( m_trk_chi2ndof_l,    chi2NDoF   , eventWeight );
   }
 
   if(m_fillDebugging){
-    m_trk_eta_vl      -> Fill( trk->eta(), eventWeight );
-    m_trk_z0_vl       -> Fill( z0,         eventWeight );
-    m_trk_z0_m        -> Fill( z0,         eventWeight );
-    m_trk_z0_m_raw    -> Fill( trk->z0(),  eventWeight );
-    m_trk_d0_vl       -> Fill( d0,         eventWeight );
-    m_trk_pt_ss       -> Fill( trkPt,      eventWeight );
-    m_trk_phiManyBins -> Fill( trk->phi(), eventWeight );
+    fill( m_trk_eta_vl,        trk->eta(), eventWeight );
+    fill( m_trk_z0_vl,         z0,         eventWeight );
+    fill( m_trk_z0_m,          z0,         eventWeight );
+    fill( m_trk_z0_m_raw,      trk->z0(),  eventWeight );
+    fill( m_trk_d0_vl,         d0,         eventWeight );
+    fill( m_trk_pt_ss,         trkPt,      eventWeight );
+    fill( m_trk_phiManyBins,   trk->phi(), eventWeight );
   }
 
   return StatusCode::SUCCESS;
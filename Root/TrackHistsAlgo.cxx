@@ -18,10 +18,14 @@ ClassImp(TrackHistsAlgo)
 
 TrackHistsAlgo :: TrackHistsAlgo (std::string className) :
     Algorithm(className),
-    m_plots(nullptr)
+    m_plots(nullptr),
+    m_skim(nullptr)
 {
   m_inContainerName         = "";
   m_detailStr               = "";
+  m_eventWeightName         = "";
+  m_fillWeightSysts         = false;
+  m_skimPredicate           = "";
   m_debug                   = false;
 
 }
@@ -70,6 +74,9 @@ EL::StatusCode TrackHistsAlgo :: configure ()
     //
     m_inContainerName         = config->GetValue("InputContainer",  m_inContainerName.c_str());
     m_detailStr               = config->GetValue("DetailStr",       m_detailStr.c_str());
+    m_eventWeightName         = config->GetValue("EventWeightName", m_eventWeightName.c_str());
+    m_fillWeightSysts         = config->GetValue("FillWeightSysts", m_fillWeightSysts);
+    m_skimPredicate           = config->GetValue("SkimPredicate",   m_skimPredicate.c_str());
     m_debug                   = config->GetValue("Debug" ,          m_debug);
 
     Info("configure()", "Loaded in configuration values");
@@ -97,6 +104,7 @@ EL::StatusCode TrackHistsAlgo :: initialize ()
   Info("initialize()", "TrackHistsAlgo");
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
+  RETURN_CHECK("TrackHistsAlgo::initialize()", EventSkim::create( m_skimPredicate, m_skim ), "");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -105,10 +113,18 @@ EL::StatusCode TrackHistsAlgo :: execute ()
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("TrackHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
 
+  // skim first, so that the rejected events cost nothing else
+  bool passSkim(true);
+  RETURN_CHECK("TrackHistsAlgo::execute()", EventSkim::passes( m_skim, eventInfo, m_event, m_store, passSkim ), "");
+  if ( !passSkim ) { return EL::StatusCode::SUCCESS; }
 
+
+  // event weight, and the weight systematics if requested (see HistogramManager::readEventWeights)
   float eventWeight(1);
-  if( eventInfo->isAvailable< float >( "mcEventWeight" ) ) {
-    eventWeight = eventInfo->auxdecor< float >( "mcEventWeight" );
+  const std::vector<float>* eventWeights(nullptr);
+  RETURN_CHECK("TrackHistsAlgo::execute()", HistogramManager::readEventWeights( eventInfo, m_eventWeightName, m_fillWeightSysts, m_store, eventWeight, eventWeights, m_weightChannels ), "");
+  if( eventWeights ) {
+    m_plots->setEventWeights( m_weightChannels, *eventWeights, wk() );
   }
 
   const xAOD::TrackParticleContainer* tracks(nullptr);
@@ -125,7 +141,11 @@ EL::StatusCode TrackHistsAlgo :: execute ()
 }
 
 EL::StatusCode TrackHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode TrackHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode TrackHistsAlgo :: finalize ()
+{
+  EventSkim::release( m_skim );
+  return EL::StatusCode::SUCCESS;
+}
 EL::StatusCode TrackHistsAlgo :: histFinalize ()
 {
   // clean up memory
@@ -17,13 +17,19 @@
 
 #include "TEnv.h"
 #include "TSystem.h"
+#include "RVersion.h"
+
+#include <algorithm>
 
 // this is needed to distribute the algorithm to the workers
 ClassImp(TreeAlgo)
 
 TreeAlgo :: TreeAlgo (std::string className) :
     Algorithm(className),
-    m_helpTree(nullptr)
+    m_helpTree(nullptr),
+    m_skim(nullptr),
+    m_outTree(nullptr),
+    m_nFilled(0)
 {
   this->SetName("TreeAlgo"); // needed if you want to retrieve this algo with wk()->getAlg(ALG_NAME) downstream
 
@@ -50,10 +56,26 @@ TreeAlgo :: TreeAlgo (std::string className) :
   m_METContainerName        = "";
   m_photonContainerName     = "";
 
+  m_jetSystsVec             = "";
+  m_muSystsVec              = "";
+
+  m_eventWeightsName        = "EventWeights";
+  m_elSystsVec              = "";
+  m_photonSystsVec          = "";
+
   // DC14 switch for little things that need to happen to run
   // for those samples with the corresponding packages
   m_DC14                    = false;
 
+  m_asyncWrite              = false;
+
+  m_skimPredicate           = "";
+
+  m_ioProfile               = "";
+  m_ioWarmUpEvents          = 1000;
+  m_compressionSettings     = -1;
+  m_basketSize              = 0;
+
 }
 
 EL::StatusCode TreeAlgo :: setupJob (EL::Job& job)
@@ -73,7 +95,7 @@ EL::StatusCode TreeAlgo :: initialize ()
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
-  this->treeInitialize();
+  RETURN_CHECK("TreeAlgo::initialize()", this->treeInitialize(), "Failed to initialize the tree.");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -97,9 +119,37 @@ EL::StatusCode TreeAlgo :: treeInitialize ()
     Info("treeInitialize()", "Succesfully configured! ");
   }
 
+  RETURN_CHECK("TreeAlgo::treeInitialize()", EventSkim::create( m_skimPredicate, m_skim ), "");
+
   // get the file we created already
   TFile* treeFile = wk()->getOutputFile ("tree");
+
+  // the compression is set on the file before any branch is created, so that all of them inherit it
+  if ( !m_ioProfile.empty() ) {
+    if ( m_ioProfile != "fast-write" && m_ioProfile != "small-output" ) {
+      Error("treeInitialize()", "Unknown IOProfile %s. Use fast-write or small-output", m_ioProfile.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+    int compression = m_compressionSettings;
+    if ( compression < 0 ) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+      // ZSTD (algorithm 5) only exists from ROOT 6.20
+      compression = ( m_ioProfile == "fast-write" ) ? 404 : 505; // LZ4 level 4 : ZSTD level 5
+#elif ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+      compression = ( m_ioProfile == "fast-write" ) ? 404 : 208; // LZ4 level 4 : LZMA level 8
+#else
+      compression = ( m_ioProfile == "fast-write" ) ? 101 : 208; // ZLIB level 1 : LZMA level 8
+#endif
+    }
+    treeFile->SetCompressionSettings( compression );
+    Info("treeInitialize()", "Using I/O profile %s: compression settings %d", m_ioProfile.c_str(), compression);
+  }
+
+  m_outTree = outTree;
   m_helpTree = new HelpTreeBase( m_event, outTree, treeFile, 1e3, m_debug, m_DC14 );
+  m_helpTree->setEventInfoName( m_eventInfoContainerName );
+  m_helpTree->setEventWeightsName( m_eventWeightsName );
+  if ( m_asyncWrite ) { m_helpTree->EnableAsyncWrite(); }
 
   // tell the tree to go into the file
   outTree->SetDirectory( treeFile );
@@ -120,6 +170,10 @@ EL::StatusCode TreeAlgo :: treeInitialize ()
   if ( !m_METContainerName.empty() )    {   m_helpTree->AddMET        (m_METDetailStr);     }
   if ( !m_photonContainerName.empty() ) {   m_helpTree->AddPhotons    (m_photonDetailStr);  }
 
+  // large baskets for fast writing, from the start. For small output, they are optimised after the warm-up
+  int basketSize = ( m_basketSize > 0 ) ? m_basketSize : ( ( m_ioProfile == "fast-write" ) ? 256000 : 0 );
+  if ( basketSize > 0 ) { outTree->SetBasketSize( "*", basketSize ); }
+
   Info("treeInitialize()", "Successfully initialized output tree");
 
   return EL::StatusCode::SUCCESS;
@@ -154,10 +208,31 @@ EL::StatusCode TreeAlgo :: configure ()
     m_METContainerName        = config->GetValue("METContainerName",        m_METContainerName.c_str());
     m_photonContainerName     = config->GetValue("PhotonContainerName",     m_photonContainerName.c_str());
 
+    m_jetSystsVec             = config->GetValue("JetSystsVec",             m_jetSystsVec.c_str());
+    m_muSystsVec              = config->GetValue("MuonSystsVec",            m_muSystsVec.c_str());
+    m_elSystsVec              = config->GetValue("ElectronSystsVec",        m_elSystsVec.c_str());
+    m_photonSystsVec          = config->GetValue("PhotonSystsVec",          m_photonSystsVec.c_str());
+
+    m_eventWeightsName        = config->GetValue("EventWeightsName",        m_eventWeightsName.c_str());
+
     // DC14 switch for little things that need to happen to run
     // for those samples with the corresponding packages
     m_DC14                    = config->GetValue("DC14", m_DC14);
 
+    m_asyncWrite              = config->GetValue("AsyncWrite", m_asyncWrite);
+
+    m_skimPredicate           = config->GetValue("SkimPredicate",       m_skimPredicate.c_str());
+
+    m_ioProfile               = config->GetValue("IOProfile",           m_ioProfile.c_str());
+    m_ioWarmUpEvents          = config->GetValue("IOWarmUpEvents",      m_ioWarmUpEvents);
+    m_compressionSettings     = config->GetValue("CompressionSettings", m_compressionSettings);
+    m_basketSize              = config->GetValue("BasketSize",          m_basketSize);
+
+    if ( m_asyncWrite && ( !m_muSystsVec.empty() || !m_elSystsVec.empty() || !m_jetSystsVec.empty() || !m_photonSystsVec.empty() ) ) {
+      Warning("configure()", "AsyncWrite is turned off: the *SystsVec friend trees are filled right after the tree, which would wait for the writer every event");
+      m_asyncWrite = false;
+    }
+
     Info("configure()", "Loaded in configuration values");
 
     // everything seems preliminarily ok, let's print config and say we were successful
@@ -178,6 +253,12 @@ EL::StatusCode TreeAlgo :: execute ()
   // Get EventInfo and the PrimaryVertices
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, m_verbose) ,"");
+
+  // skim first, so that the rejected events cost nothing else
+  bool passSkim(true);
+  RETURN_CHECK("TreeAlgo::execute()", EventSkim::passes( m_skim, eventInfo, m_event, m_store, passSkim ), "");
+  if ( !passSkim ) { return EL::StatusCode::SUCCESS; }
+
   const xAOD::VertexContainer* vertices(nullptr);
   RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(vertices, "PrimaryVertices", m_event, m_store, m_verbose) ,"");
   // get the primaryVertex
@@ -236,17 +317,138 @@ EL::StatusCode TreeAlgo :: execute ()
   // fill the tree
   m_helpTree->Fill();
 
+  // the friend trees are in the same file as the tree: they are not filled (nor created) while the writer thread is writing to it.
+  // configure() turns AsyncWrite off in this case, this only matters if the members were set directly
+  if ( !m_muSystsVec.empty() || !m_elSystsVec.empty() || !m_jetSystsVec.empty() || !m_photonSystsVec.empty() ) {
+    m_helpTree->WaitForWrite();
+  }
+
+  // fill the friend trees of the variations present in this event: only the varied object is written
+  if ( !m_muSystsVec.empty() && !m_muContainerName.empty() ) {
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(systNames, m_muSystsVec, 0, m_store, m_verbose) ,"");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      const xAOD::MuonContainer* inMuon(nullptr);
+      RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inMuon, m_muContainerName + systName, m_event, m_store, m_verbose) ,"");
+      HelpTreeBase* friendTree = this->getFriendTree( systName, "muon" );
+      friendTree->FillEvent( eventInfo, m_event );
+      friendTree->FillMuons( inMuon, primaryVertex );
+      friendTree->Fill();
+    }
+  }
+  if ( !m_elSystsVec.empty() && !m_elContainerName.empty() ) {
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(systNames, m_elSystsVec, 0, m_store, m_verbose) ,"");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      const xAOD::ElectronContainer* inElec(nullptr);
+      RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inElec, m_elContainerName + systName, m_event, m_store, m_verbose) ,"");
+      HelpTreeBase* friendTree = this->getFriendTree( systName, "electron" );
+      friendTree->FillEvent( eventInfo, m_event );
+      friendTree->FillElectrons( inElec, primaryVertex );
+      friendTree->Fill();
+    }
+  }
+  if ( !m_jetSystsVec.empty() && !m_jetContainerName.empty() ) {
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(systNames, m_jetSystsVec, 0, m_store, m_verbose) ,"");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      const xAOD::JetContainer* inJets(nullptr);
+      RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inJets, m_jetContainerName + systName, m_event, m_store, m_verbose) ,"");
+      HelpTreeBase* friendTree = this->getFriendTree( systName, "jet" );
+      friendTree->FillEvent( eventInfo, m_event );
+      friendTree->FillJets( inJets, HelperFunctions::getPrimaryVertexLocation(vertices) );
+      friendTree->Fill();
+    }
+  }
+  if ( !m_photonSystsVec.empty() && !m_photonContainerName.empty() ) {
+    std::vector<std::string>* systNames(nullptr);
+    RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(systNames, m_photonSystsVec, 0, m_store, m_verbose) ,"");
+    for ( const auto& systName : *systNames ) {
+      if ( systName.empty() ) { continue; }
+      const xAOD::PhotonContainer* inPhotons(nullptr);
+      RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inPhotons, m_photonContainerName + systName, m_event, m_store, m_verbose) ,"");
+      HelpTreeBase* friendTree = this->getFriendTree( systName, "photon" );
+      friendTree->FillEvent( eventInfo, m_event );
+      friendTree->FillPhotons( inPhotons );
+      friendTree->Fill();
+    }
+  }
+
+  if ( !m_ioProfile.empty() && ++m_nFilled == m_ioWarmUpEvents ) { this->optimizeOutputTree(); }
+
   return EL::StatusCode::SUCCESS;
 
 }
 
+HelpTreeBase* TreeAlgo :: getFriendTree ( const std::string& systName, const std::string& objectName )
+{
+  const std::pair<std::string, std::string> key( objectName, systName );
+  auto friend_itr = m_friendHelpTrees.find( key );
+  if ( friend_itr != m_friendHelpTrees.end() ) { return friend_itr->second; }
+
+  // same file and same detail strings as the nominal tree, but only the event identifiers and the varied object
+  TFile* treeFile = wk()->getOutputFile ("tree");
+  const std::string treeName = m_name + "_" + objectName + "_" + systName;
+  TTree* friendTree = new TTree( treeName.c_str(), treeName.c_str() );
+  friendTree->SetDirectory( treeFile );
+
+  HelpTreeBase* friendHelpTree = new HelpTreeBase( m_event, friendTree, treeFile, 1e3, m_debug, m_DC14 );
+  friendHelpTree->setEventInfoName( m_eventInfoContainerName );
+  friendHelpTree->setEventWeightsName( m_eventWeightsName );
+  friendHelpTree->AddEvent( "" );
+  if      ( objectName == "muon" )     { friendHelpTree->AddMuons     (m_muDetailStr);     }
+  else if ( objectName == "electron" ) { friendHelpTree->AddElectrons (m_elDetailStr);     }
+  else if ( objectName == "jet" )      { friendHelpTree->AddJets      (m_jetDetailStr);    }
+  else if ( objectName == "photon" )   { friendHelpTree->AddPhotons   (m_photonDetailStr); }
+
+  Info("getFriendTree()", "Writing the %s variation %s to friend tree %s", objectName.c_str(), systName.c_str(), treeName.c_str());
+
+  m_friendHelpTrees[key] = friendHelpTree;
+  m_friendTrees[key]     = friendTree;
+  return friendHelpTree;
+}
+
+void TreeAlgo :: optimizeOutputTree ()
+{
+  // the tree may be filled in the background
+  m_helpTree->WaitForWrite();
+
+  const Long64_t entries  = m_outTree->GetEntries();
+  const Long64_t totBytes = m_outTree->GetTotBytes();
+  if ( entries <= 0 || totBytes <= 0 ) { return; }
+
+  // clusters of ~100 MB (fast-write) or ~30 MB (small-output) of uncompressed data, from the entry sizes seen so far
+  const Long64_t clusterBytes = ( m_ioProfile == "fast-write" ) ? 100000000 : 30000000;
+  const Long64_t autoFlush    = std::max<Long64_t>( 1, clusterBytes * entries / totBytes );
+
+  m_outTree->FlushBaskets();
+  if ( m_ioProfile == "small-output" ) { m_outTree->OptimizeBaskets( 10000000, 1.1, "" ); }
+  m_outTree->SetAutoFlush( autoFlush );
+
+  Info("optimizeOutputTree()", "%s: %lld bytes/entry after %lld entries, auto-flush every %lld entries", m_outTree->GetName(), totBytes / entries, entries, autoFlush);
+}
+
 EL::StatusCode TreeAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode TreeAlgo :: finalize () {
 
   Info("finalize()", "Deleting tree instances...");
 
-  if ( m_helpTree ) { delete m_helpTree;   m_helpTree = nullptr; }
+  // wait for the last event to be written, if the tree is filled in the background, before the tree (or a derived one) is deleted
+  if ( m_helpTree ) { m_helpTree->StopAsyncWrite(); delete m_helpTree; m_helpTree = nullptr; }
+  EventSkim::release( m_skim );
+
+  // the friend trees do not have an entry for every event, so readers overlay them with the index
+  for ( auto& friendHelpTree : m_friendHelpTrees ) {
+    delete friendHelpTree.second;
+    TTree* friendTree = m_friendTrees[friendHelpTree.first];
+    friendTree->BuildIndex( "runNumber", "eventNumber" );
+  }
+  m_friendHelpTrees.clear();
+  m_friendTrees.clear();
 
   return EL::StatusCode::SUCCESS;
 }
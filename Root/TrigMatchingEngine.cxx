@@ -0,0 +1,120 @@
+/******************************************
+ *
+ * Batched HLT trigger matching: fetch the
+ * features of each chain once per event,
+ * and match all the offline objects against
+ * all the chains in one pass.
+ *
+ ******************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <cmath>
+
+// EDM include(s):
+#include "xAODMuon/MuonContainer.h"
+#include "xAODEgamma/ElectronContainer.h"
+
+// package include(s):
+#include "xAODAnaHelpers/TrigMatchingEngine.h"
+#include "TrigDecisionTool/TrigDecisionTool.h"
+
+// ROOT include(s):
+#include "TVector2.h"
+#include "TError.h"
+
+TrigMatchingEngine::TrigMatchingEngine( Trig::TrigDecisionTool* trigDecTool, FeatureType type, const std::vector<std::string>& chains,
+                                        const std::string& decorName, float dRMax, bool debug ) :
+  m_trigDecTool(trigDecTool),
+  m_type(type),
+  m_chains(chains),
+  m_dRMax(dRMax),
+  m_debug(debug),
+  m_fetched(false),
+  m_runNumber(0),
+  m_eventNumber(0),
+  m_matchDecor(decorName),
+  m_chainsDecor(decorName + "Chains")
+{ }
+
+TrigMatchingEngine::~TrigMatchingEngine() {}
+
+StatusCode TrigMatchingEngine::fetchFeatures( const xAOD::EventInfo* eventInfo )
+{
+
+  // the same event can be seen several times (e.g., once per systematic): fetch only at the first call
+  //
+  if ( m_fetched && eventInfo->runNumber() == m_runNumber && eventInfo->eventNumber() == m_eventNumber ) {
+    return StatusCode::SUCCESS;
+  }
+
+  m_features.clear();
+
+  for ( unsigned int idx(0); idx < m_chains.size(); ++idx ) {
+
+    const std::string& chain = m_chains.at(idx);
+
+    // no features to match against if the chain did not fire
+    //
+    if ( !m_trigDecTool->isPassed( chain ) ) { continue; }
+
+    Trig::FeatureContainer fc = m_trigDecTool->features( chain );
+
+    if ( m_type == FeatureType::Muon ) {
+      for ( auto mucont : fc.containerFeature<xAOD::MuonContainer>() ) {
+        for ( const xAOD::Muon* hlt_mu : *mucont.cptr() ) {
+          m_features.push_back( { static_cast<float>(hlt_mu->eta()), static_cast<float>(hlt_mu->phi()), idx } );
+        }
+      }
+    } else {
+      for ( auto elcont : fc.containerFeature<xAOD::ElectronContainer>() ) {
+        for ( const xAOD::Electron* hlt_el : *elcont.cptr() ) {
+          m_features.push_back( { static_cast<float>(hlt_el->eta()), static_cast<float>(hlt_el->phi()), idx } );
+        }
+      }
+    }
+
+  }
+
+  std::sort( m_features.begin(), m_features.end(), [](const Feature& a, const Feature& b) { return a.eta < b.eta; } );
+
+  if ( m_debug ) { Info("TrigMatchingEngine::fetchFeatures()", "Fetched %lu HLT features for %lu chains", m_features.size(), m_chains.size() ); }
+
+  // store the list of chains once per event, so that the match decoration can be interpreted downstream
+  //
+  m_chainsDecor( *eventInfo ) = m_chains;
+
+  m_fetched     = true;
+  m_runNumber   = eventInfo->runNumber();
+  m_eventNumber = eventInfo->eventNumber();
+
+  return StatusCode::SUCCESS;
+}
+
+void TrigMatchingEngine::matchObject( const xAOD::IParticle* particle, std::vector<char>& matchRow ) const
+{
+
+  matchRow.assign( m_chains.size(), 0 );
+
+  const float eta = particle->eta();
+  const float phi = particle->phi();
+
+  // first feature inside the eta window
+  //
+  auto feature_itr = std::lower_bound( m_features.begin(), m_features.end(), eta - m_dRMax,
+                                       [](const Feature& f, float value) { return f.eta < value; } );
+
+  for ( ; feature_itr != m_features.end() && feature_itr->eta <= eta + m_dRMax; ++feature_itr ) {
+
+    if ( matchRow[feature_itr->chainIdx] ) { continue; }
+
+    const float dEta = eta - feature_itr->eta;
+    const float dPhi = TVector2::Phi_mpi_pi( phi - feature_itr->phi );
+
+    if ( dEta * dEta + dPhi * dPhi < m_dRMax * m_dRMax ) {
+      matchRow[feature_itr->chainIdx] = 1;
+      if ( m_debug ) { Info("TrigMatchingEngine::matchObject()", "\t object matched to chain %s", m_chains.at(feature_itr->chainIdx).c_str() ); }
+    }
+  }
+
+}
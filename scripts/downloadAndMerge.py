@@ -15,6 +15,7 @@
 #import
 import os, sys, subprocess, glob, shutil
 import argparse
+import xAH_merge
 parser = argparse.ArgumentParser(description="%prog [options]", formatter_class=argparse.ArgumentDefaultsHelpFormatter)
 parser.add_argument("--container", dest='container', default="None",
      help="Name of dataset to be downloaded, may include wildcards")
@@ -25,7 +26,9 @@ parser.add_argument("--types", dest='types', default="tree",
 parser.add_argument("--outPath", dest='outPath', default="./gridOutput/",
      help="Output path")
 parser.add_argument("--mergeRawDatasets", dest='mergeRawDatasets', default="True",
-     help="Merge raw datasets (hadd)")
+     help="Merge raw datasets (xAH_merge.py)")
+parser.add_argument("--nProcs", dest='nProcs', type=int, default=0,
+     help="Number of processes merging a dataset in parallel (0 = number of cores)")
 parser.add_argument("--doFax", dest='doFax', default=False, action="store_true", help="Use get-fax")
 parser.add_argument("--renameRawDatasets", dest='renameRawDatasets', default="False",
      help="Rename raw datasets")
@@ -43,14 +46,6 @@ def main():
   mergeRawDatasets = args.mergeRawDatasets
   renameRawDatasets = args.renameRawDatasets
 
-  ##******************************************
-  # check that hadd exists
-  devnull = open(os.devnull)
-  try :
-    subprocess.call(["hadd"], stdout=devnull, stderr=devnull)
-  except OSError as e:
-    print "Error, hadd not available"
-    exit(1)
   #------------------------------------------
   #get current directory
   currentDir = os.getcwd()
@@ -158,15 +153,15 @@ def main():
 
       print '   outputFileName: %s'%outputFileName
 
-      inputFilesName = glob.glob(inputFilesNameWildCard)
+      inputFilesName = sorted(glob.glob(inputFilesNameWildCard))
 
       if (mergeRawDatasets=="True") :
-        print '   hadding inputFilesName: %s'%inputFilesNameWildCard
+        print '   merging inputFilesName: %s'%inputFilesNameWildCard
         if outputFileName.endswith('.root'):
           outputFileName = outputFileName[:-5] #strip .root
 
         if args.maxSize <= 0:
-          os.system('hadd '+outputFileName+'.root '+inputFilesNameWildCard)
+          xAH_merge.merge(outputFileName+'.root', inputFilesName, args.nProcs)
         else:
           ## Get file sizes
           fileSizes = []
@@ -201,11 +196,11 @@ def main():
           ## Combine
           for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
             if len( filesToMerge) == 1: #Only one output file
-              os.system('hadd '+outputFileName+'.root '+' '.join(theseFilesToMerge) )
+              xAH_merge.merge(outputFileName+'.root', theseFilesToMerge, args.nProcs)
             elif len(theseFilesToMerge) == 1:
               os.system("mv "+theseFilesToMerge[0]+" "+outputFileName+"."+str(iMerge)+".root")
             else:
-              os.system('hadd '+outputFileName+'.'+str(iMerge)+'.root '+' '.join(theseFilesToMerge) )
+              xAH_merge.merge(outputFileName+'.'+str(iMerge)+'.root', theseFilesToMerge, args.nProcs)
 
 
       elif (renameRawDatasets=="True") :
@@ -0,0 +1,372 @@
+# @file:    xAH_local.py
+# @purpose: local multi-process driver for xAH_run.py
+#
+# The job, fully configured by xAH_run.py, is forked into N workers. Each worker
+# asks the parent for a unit of work (a whole input file or an event range of
+# one), runs it with the EventLoop DirectDriver in its own directory, and asks
+# for the next one. Units are handed out with guided self-scheduling: they
+# shrink as the work left shrinks, so that the large files are split at the
+# end and all the workers finish together. The outputs of the units are then
+# merged into the usual EventLoop layout of the submission directory.
+#
+# With a cache directory, the outputs of each input file are also kept there,
+# under the hash of the configuration of the job. On the next run with the same
+# configuration, the files which did not change are not processed again: their
+# outputs are taken from the cache and merged with those of the other files.
+#
+
+import bisect
+import collections
+import glob
+import hashlib
+import logging
+import math
+import multiprocessing
+import os
+import Queue
+import re
+import shutil
+import sys
+import time
+
+import ROOT
+
+import xAH_merge
+
+xAH_logger = logging.getLogger("xAH")
+
+# one unit of work: the entries [first, first+nEntries) of one file (nEntries = 0: the whole file).
+# Of the units of a file, only the one with its first entries to process counts its meta data
+WorkUnit = collections.namedtuple('WorkUnit', ['index', 'sample', 'fileIndex', 'url', 'first', 'nEntries', 'ownsMetaData'])
+
+class _Segment(object):
+  """ The part of an input file that has not been handed out yet """
+  def __init__(self, sample, fileIndex, url, first, last, clusters=None):
+    self.sample     = sample
+    self.fileIndex  = fileIndex
+    self.url        = url
+    self.first      = first
+    self.last       = last
+    # first entry of each cluster of baskets of the tree
+    self.clusters   = clusters or []
+    # the first unit of the segment counts the meta data of the file, whatever its first entry (see --skip)
+    self.start      = first
+
+  def size(self):
+    return self.last - self.first
+
+  def cut(self, nEntries):
+    """ The size of a unit of about nEntries from the start of the segment, ending on a cluster boundary if there is one after it """
+    i = bisect.bisect_left(self.clusters, self.first + nEntries)
+    if i < len(self.clusters) and self.clusters[i] < self.last:
+      return self.clusters[i] - self.first
+    return nEntries
+
+class Scheduler(object):
+  """ Hand out whole files while they fit in (work left)/(2*nWorkers) entries, and chunks of that size of the larger ones """
+  def __init__(self, segments, nWorkers, minEntries):
+    self._pending     = list(segments)
+    self._nWorkers    = nWorkers
+    self._minEntries  = max(1, minEntries)
+    self._remaining   = sum(seg.size() for seg in segments)
+    self._nUnits      = 0
+
+  def next(self):
+    if not self._pending: return None
+
+    chunk = max(self._minEntries, int(math.ceil(self._remaining/(2.0*self._nWorkers))))
+
+    # the largest segment that fits in a chunk, otherwise a chunk of the largest one
+    fitting = [seg for seg in self._pending if seg.size() < chunk + self._minEntries]
+    segment = max(fitting or self._pending, key=lambda seg: seg.size())
+
+    # a segment is taken whole unless what would be left of it is still worth a unit of its own
+    if fitting:
+      self._pending.remove(segment)
+      nEntries = segment.size()
+    else:
+      # ending on a cluster boundary, the units of a file never decompress the same baskets
+      nEntries = segment.cut(chunk)
+      if nEntries > segment.size() - self._minEntries:
+        self._pending.remove(segment)
+        nEntries = segment.size()
+
+    unit = WorkUnit(self._nUnits, segment.sample, segment.fileIndex, segment.url, segment.first, nEntries, segment.first == segment.start)
+    segment.first += nEntries
+    self._remaining -= nEntries
+    self._nUnits += 1
+
+    return unit
+
+def _scanFile(url, treeName):
+  """ The number of entries of the tree, and the first entry of each of its clusters """
+  f = ROOT.TFile.Open(url)
+  if not f or f.IsZombie():
+    raise IOError("Cannot open input file {0:s}".format(url))
+  tree = f.Get(treeName)
+  nEntries, clusters = 0, []
+  if tree:
+    nEntries = tree.GetEntries()
+    clusterIter = tree.GetClusterIterator(0)
+    start = clusterIter.Next()
+    while start < nEntries:
+      clusters.append(start)
+      start = clusterIter.Next()
+  f.Close()
+  return nEntries, clusters
+
+def _referencedFiles(data):
+  """ The local files named in a text file, e.g. the GRL, PRW or CDI files of a TEnv config, with their environment variables expanded """
+  # binary files (ROOT files, ...) name no other file
+  if '\0' in data[:1024]:
+    return []
+  files = []
+  for token in re.split(r'[\s,;"\'=]+', data):
+    path = os.path.expandvars(token.rstrip(':'))
+    if path and os.path.isfile(path):
+      files.append(path)
+  return files
+
+def configHash(items):
+  """ Hash of the configuration of a job: the items, the content of those naming a file (e.g. the TEnv configs of the algorithms)
+      and, recursively, the content of the files named in these (e.g. the GRL, PRW and CDI files named in the TEnv configs) """
+  sha = hashlib.sha1()
+  hashed = set()
+
+  def hashFile(path):
+    path = os.path.realpath(path)
+    if path in hashed: return
+    hashed.add(path)
+    # the configs are small text files, the large ones (e.g. the CDI files) are only hashed
+    scan = os.path.getsize(path) < (1 << 20)
+    data = ''
+    with open(path, 'rb') as f:
+      for chunk in iter(lambda: f.read(1 << 20), ''):
+        sha.update(chunk)
+        if scan: data += chunk
+    for reference in _referencedFiles(data):
+      hashFile(reference)
+
+  for item in items:
+    item = str(item)
+    sha.update(item + '\n')
+    path = os.path.expandvars(item)
+    if os.path.isfile(path):
+      hashFile(path)
+  return sha.hexdigest()
+
+def releaseItems():
+  """ What identifies the software a job runs with, for configHash: the release (the RootCore of the release and its series),
+      the version of ROOT and all the libraries of the RootCore packages, as the algorithms of any of them may be scheduled """
+  items = [os.environ.get(var, '') for var in ['ROOTCOREDIR', 'ROOTCORE_RELEASE_SERIES', 'ROOTCORECONFIG']]
+  items.append(ROOT.gROOT.GetVersion())
+  items += sorted(glob.glob(os.path.expandvars('$ROOTCOREBIN/lib/$ROOTCORECONFIG/*.so')))
+  return items
+
+def _runUnit(job, unit, unitDir):
+  """ Run one unit with the DirectDriver, on a copy of the job restricted to its file and entries """
+  original = job.sampleHandler().get(unit.sample)
+
+  sample = ROOT.SH.SampleLocal(unit.sample)
+  sample.add(unit.url)
+  sample.meta().fetch(original.meta())
+  # the meta data of a split file is counted by one of its units only: the others are flagged, see BasicEventSelection
+  sample.meta().setBool("xAH_eventRanges", not unit.ownsMetaData)
+  # a unit has no next file to prefetch
+  sample.meta().setString("xAH_inputFiles", unit.url)
+  sh = ROOT.SH.SampleHandler()
+  sh.add(sample)
+
+  unitJob = ROOT.EL.Job(job)
+  unitJob.sampleHandler(sh)
+  unitJob.options().setDouble(ROOT.EL.Job.optSkipEvents, unit.first)
+  if unit.nEntries > 0:
+    unitJob.options().setDouble(ROOT.EL.Job.optMaxEvents, unit.nEntries)
+
+  ROOT.EL.DirectDriver().submit(unitJob, unitDir)
+
+def _redirectOutput(logName):
+  """ Send stdout/stderr (of python and of ROOT) to a log file """
+  sys.stdout.flush()
+  sys.stderr.flush()
+  with open(logName, 'w') as log:
+    os.dup2(log.fileno(), sys.stdout.fileno())
+    os.dup2(log.fileno(), sys.stderr.fileno())
+
+def _timedUnit(job, unit, unitsDir):
+  start = time.time()
+  try:
+    _runUnit(job, unit, os.path.join(unitsDir, '{0:06d}'.format(unit.index)))
+    result = (unit, True, time.time() - start, "")
+  except Exception, e:
+    result = (unit, False, time.time() - start, str(e))
+  sys.stdout.flush()
+  return result
+
+def _work(workerId, job, unitsDir, requests, replies):
+  """ The loop of a worker: report the previous unit, get the next one, until there is none """
+  # keep the output of each worker apart
+  _redirectOutput(os.path.join(unitsDir, 'worker-{0:d}.log'.format(workerId)))
+
+  result = None
+  while True:
+    requests.put((workerId, result))
+    unit = replies.get()
+    if unit is None: break
+    result = _timedUnit(job, unit, unitsDir)
+
+class LocalDriver(object):
+  """ Same interface as the EventLoop drivers, as far as xAH_run.py is concerned """
+  def __init__(self, nWorkers=0, minEntries=1000, keepUnits=False, cacheDir=None, configHash=None):
+    self.nWorkers   = nWorkers if nWorkers > 0 else multiprocessing.cpu_count()
+    self.minEntries = minEntries
+    self.keepUnits  = keepUnits
+    # the outputs of each input file are cached in cacheDir/<configHash>
+    self.cacheDir   = os.path.join(cacheDir, configHash) if cacheDir and configHash else None
+
+  def segments(self, job):
+    """ The entries to process in each input file, after the --skip/--nevents of the job (counted per sample, as EventLoop does) """
+    skipEvents = int(job.options().castDouble(ROOT.EL.Job.optSkipEvents, 0))
+    maxEvents  = int(job.options().castDouble(ROOT.EL.Job.optMaxEvents, 0))
+
+    segments = []
+    for sample in job.sampleHandler():
+      treeName = sample.meta().castString("nc_tree", "CollectionTree")
+      toSkip, toProcess = skipEvents, maxEvents if maxEvents > 0 else float('inf')
+      for fileIndex in range(sample.numFiles()):
+        url = sample.fileName(fileIndex)
+        nEntries, clusters = _scanFile(url, treeName)
+        first = min(toSkip, nEntries)
+        last  = first + int(min(nEntries - first, toProcess))
+        toSkip -= first
+        toProcess -= last - first
+        # files without events are still run, for their meta data
+        if last > first or nEntries == 0:
+          segments.append(_Segment(sample.name(), fileIndex, url, first, last, clusters))
+        xAH_logger.debug("\t\t%s: entries %d to %d of %d", url, first, last, nEntries)
+    return segments
+
+  def cacheEntry(self, segment):
+    """ The directory of the cached outputs of a segment, None if its file is not local. The file is identified by its path, size and modification time """
+    path = segment.url[len('file://'):] if segment.url.startswith('file://') else segment.url
+    try:
+      stat = os.stat(path)
+    except OSError:
+      return None
+    key = hashlib.sha1('{0:s}\n{1:d}\n{2:f}\n{3:d}\n{4:d}'.format(os.path.realpath(path), stat.st_size, stat.st_mtime, segment.first, segment.last)).hexdigest()
+    return os.path.join(self.cacheDir, segment.sample, key)
+
+  def store(self, units, unitsDir, entry):
+    """ Merge the outputs of the units of one file into its cache entry """
+    unitDirs = [os.path.join(unitsDir, '{0:06d}'.format(unit.index)) for unit in sorted(units, key=lambda unit: unit.first)]
+    tmpEntry = entry + '.tmp'
+    shutil.rmtree(tmpEntry, True)
+    os.makedirs(tmpEntry)
+    self._mergeParts(units[0].sample, unitDirs, tmpEntry)
+    # the entry appears complete, or not at all
+    os.rename(tmpEntry, entry)
+
+  def submit(self, job, submitDir):
+    unitsDir = os.path.join(submitDir, 'units')
+    os.makedirs(unitsDir)
+
+    segments = self.segments(job)
+    # the files which did not change since they were cached are not processed again
+    entries = {}
+    if self.cacheDir:
+      for segment in segments:
+        entries[(segment.sample, segment.fileIndex)] = self.cacheEntry(segment)
+      cached = [segment for segment in segments if entries[(segment.sample, segment.fileIndex)] and os.path.isdir(entries[(segment.sample, segment.fileIndex)])]
+      segments = [segment for segment in segments if segment not in cached]
+      xAH_logger.info("\t%d of %d input files taken from the cache %s", len(cached), len(cached) + len(segments), self.cacheDir)
+    sizes = dict(((segment.sample, segment.fileIndex), segment.size()) for segment in segments)
+
+    scheduler = Scheduler(segments, self.nWorkers, self.minEntries)
+    done, failed = [], []
+
+    # fork once the job is configured: the workers inherit everything loaded so far
+    xAH_logger.info("\tforking %d workers", self.nWorkers)
+    requests = multiprocessing.Queue()
+    replies  = [multiprocessing.Queue() for i in range(self.nWorkers)]
+    workers  = [multiprocessing.Process(target=_work, args=(i, job, unitsDir, requests, replies[i])) for i in range(self.nWorkers)]
+    for worker in workers: worker.start()
+
+    inFlight = {}
+    active = set(range(self.nWorkers))
+    while active:
+      try:
+        workerId, result = requests.get(timeout=10)
+      except Queue.Empty:
+        # a worker that died (e.g. a crash in ROOT) never asks again
+        for workerId in [i for i in active if not workers[i].is_alive()]:
+          xAH_logger.error("\tworker %d died, see %s", workerId, os.path.join(unitsDir, 'worker-{0:d}.log'.format(workerId)))
+          if workerId in inFlight: failed.append((inFlight.pop(workerId), 0., "worker died"))
+          active.discard(workerId)
+        continue
+
+      if result is not None:
+        inFlight.pop(workerId, None)
+        unit, success, elapsed, message = result
+        if success:
+          done.append(unit)
+          xAH_logger.info("\tunit %d done in %.1f s: %s [%d, +%s]", unit.index, elapsed, os.path.basename(unit.url), unit.first, unit.nEntries or 'all')
+        else:
+          failed.append((unit, elapsed, message))
+          xAH_logger.error("\tunit %d failed: %s", unit.index, message)
+
+      # stop handing out work after a failure, the job cannot be complete anyway
+      unit = scheduler.next() if not failed else None
+      replies[workerId].put(unit)
+      if unit is None:
+        active.discard(workerId)
+      else:
+        inFlight[workerId] = unit
+
+    for worker in workers: worker.join()
+
+    if self.cacheDir:
+      # cache the files whose units all succeeded, even if others failed: they are not processed again on the next run
+      byFile = collections.defaultdict(list)
+      for unit in done: byFile[(unit.sample, unit.fileIndex)].append(unit)
+      for key, units in byFile.iteritems():
+        if entries[key] and sum(unit.nEntries for unit in units) == sizes[key]:
+          self.store(units, unitsDir, entries[key])
+
+    if failed:
+      raise RuntimeError("{0:d} unit(s) failed, see the logs in {1:s}".format(len(failed), unitsDir))
+
+    if self.cacheDir:
+      # the files which could not be cached (not local) are merged from their units
+      parts = []
+      for unit in done:
+        entry = entries[(unit.sample, unit.fileIndex)]
+        if entry: parts.append((entry, unit.sample, unit.fileIndex, 0))
+        else:     parts.append((os.path.join(unitsDir, '{0:06d}'.format(unit.index)), unit.sample, unit.fileIndex, unit.first))
+      parts += [(entries[(segment.sample, segment.fileIndex)], segment.sample, segment.fileIndex, 0) for segment in cached]
+      self._merge(sorted(set(parts), key=lambda part: part[1:]), submitDir)
+    else:
+      self.merge(done, unitsDir, submitDir)
+    if not self.keepUnits:
+      shutil.rmtree(unitsDir, True)
+
+  def merge(self, units, unitsDir, submitDir):
+    """ Merge the outputs of the units of each sample, in the order of the input, into the EventLoop layout """
+    self._merge([(os.path.join(unitsDir, '{0:06d}'.format(unit.index)), unit.sample, unit.fileIndex, unit.first) for unit in units], submitDir)
+
+  def _merge(self, parts, submitDir):
+    """ Merge the output directories (directory, sample, fileIndex, first entry) of each sample, in the order of the input """
+    parts = sorted(parts, key=lambda part: part[1:])
+    for sample in sorted(set(part[1] for part in parts)):
+      self._mergeParts(sample, [part[0] for part in parts if part[1] == sample], submitDir)
+
+  def _mergeParts(self, sample, partDirs, outputDir):
+    """ Merge the outputs of one sample found in partDirs, in this order, into outputDir """
+    # hist-<sample>.root, and data-<stream>/<sample>.root for each output stream
+    outputs = set(['hist-{0:s}.root'.format(sample)])
+    for partDir in partDirs:
+      outputs.update(os.path.join(d, '{0:s}.root'.format(sample)) for d in os.listdir(partDir) if d.startswith('data-'))
+
+    for output in sorted(outputs):
+      inputs = [os.path.join(partDir, output) for partDir in partDirs if os.path.exists(os.path.join(partDir, output))]
+      if inputs:
+        xAH_merge.merge(os.path.join(outputDir, output), inputs, self.nWorkers)
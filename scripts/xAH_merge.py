@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+
+# @file:    xAH_merge.py
+# @purpose: merge the outputs of xAH jobs (histograms, cutflows, MetaData_EventCount and trees) in parallel
+#
+# The inputs are merged by a tree reduction: they are cut, in order, into groups
+# of at most --fanIn files, the groups are merged in parallel into temporary
+# files, and so on until a single file is left. Each merge uses TFileMerger:
+# the histograms (including the cutflows and MetaData_EventCount) are summed,
+# and the trees are fast-cloned, i.e. their baskets are copied without being
+# decompressed. As with hadd -ff, the outputs take the compression settings of
+# the first input: the baskets are only copied as they are if the output file
+# is compressed like them. At most --fanIn files are opened by a merge, so that the memory
+# stays bounded whatever the number of inputs. The order of the entries of the
+# trees is the order of the inputs.
+#
+# @example:
+# @code
+# xAH_merge.py --output hist-sample.root --nProcs 8 gridOutput/rawDownload/*hist-output*/*.root*
+# @endcode
+#
+
+import argparse
+import glob
+import logging
+import multiprocessing
+import os
+import shutil
+import sys
+
+import ROOT
+
+xAH_logger = logging.getLogger("xAH")
+
+def _compressionSettings(fname):
+  """ The compression settings of a file, None if it cannot be opened """
+  f = ROOT.TFile.Open(fname)
+  if not f or f.IsZombie():
+    return None
+  compression = f.GetCompressionSettings()
+  f.Close()
+  return compression
+
+def _mergeGroup(task):
+  """ Merge one group of files, in a worker process. Returns an error message, empty if successful """
+  output, inputs, compression = task
+  merger = ROOT.TFileMerger(False, False)
+  merger.SetPrintLevel(0)
+  merger.SetFastMethod(True)
+  merger.SetMaxOpenedFiles(len(inputs) + 1)
+  if not merger.OutputFile(output, "RECREATE", compression):
+    return "cannot create {0:s}".format(output)
+  for fname in inputs:
+    if not merger.AddFile(fname, False):
+      return "cannot add {0:s} to {1:s}".format(fname, output)
+  if not merger.Merge():
+    return "failed to merge into {0:s}".format(output)
+  return ""
+
+def merge(output, inputs, nProcs=0, fanIn=20):
+  """ Merge the inputs into output, with nProcs processes (0: the number of cores) """
+  if not inputs:
+    raise ValueError("No input to merge into {0:s}".format(output))
+
+  nProcs = nProcs if nProcs > 0 else multiprocessing.cpu_count()
+  fanIn  = max(2, fanIn)
+
+  outputDir = os.path.dirname(os.path.abspath(output))
+  if not os.path.isdir(outputDir):
+    os.makedirs(outputDir)
+
+  if len(inputs) == 1:
+    shutil.copyfile(inputs[0], output)
+    return
+
+  compression = _compressionSettings(inputs[0])
+  if compression is None:
+    raise RuntimeError("cannot open {0:s}".format(inputs[0]))
+
+  tmpDir = "{0:s}.merging".format(output)
+  shutil.rmtree(tmpDir, True)
+  os.makedirs(tmpDir)
+
+  # the groups have at least two files each: there is no use for more processes than that
+  pool = multiprocessing.Pool(min(nProcs, len(inputs)//2))
+  try:
+    level = 0
+    while len(inputs) > fanIn:
+      # spread the files over at least nProcs groups, as long as they have two files each
+      groupSize = min(fanIn, max(2, (len(inputs) + nProcs - 1)//nProcs))
+      groups = [inputs[i:i+groupSize] for i in range(0, len(inputs), groupSize)]
+      tasks = [(os.path.join(tmpDir, "{0:d}-{1:d}.root".format(level, i)), group, compression) for i, group in enumerate(groups)]
+      xAH_logger.info("\tmerging %d files into %d, %d processes", len(inputs), len(tasks), nProcs)
+      errors = [error for error in pool.map(_mergeGroup, tasks) if error]
+      if errors:
+        raise RuntimeError("; ".join(errors))
+
+      # the files of the previous level are not needed anymore
+      if level > 0:
+        map(os.remove, inputs)
+      inputs = [task[0] for task in tasks]
+      level += 1
+
+    xAH_logger.info("\tmerging %d files into %s", len(inputs), output)
+    error = _mergeGroup((output, inputs, compression))
+    if error:
+      raise RuntimeError(error)
+  finally:
+    pool.close()
+    pool.join()
+    shutil.rmtree(tmpDir, True)
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(description='Merge the outputs of xAH jobs in parallel.', formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  parser.add_argument('inputs', metavar='file', type=str, nargs='+', help='input files (or wildcards). The entries of the trees keep this order.')
+  parser.add_argument('-o', '--output', dest='output', metavar='<file>', type=str, required=True, help='merged output file')
+  parser.add_argument('--nProcs', dest='nProcs', metavar='<n>', type=int, default=0, help='number of merging processes. (0 = number of cores)')
+  parser.add_argument('--fanIn', dest='fanIn', metavar='<n>', type=int, default=20, help='maximum number of files merged at once by a process')
+  parser.add_argument('-f', '--force', dest='force_overwrite', action='store_true', help='overwrite the output file if it exists')
+  args = parser.parse_args()
+
+  logging.getLogger().addHandler(logging.StreamHandler())
+  xAH_logger.setLevel(logging.INFO)
+
+  if os.path.exists(args.output) and not args.force_overwrite:
+    sys.exit("Output file {0:s} already exists. Re-run with -f/--force.".format(args.output))
+
+  inputs = []
+  for pattern in args.inputs:
+    inputs += sorted(glob.glob(pattern)) or [pattern]
+
+  merge(args.output, inputs, args.nProcs, args.fanIn)
@@ -111,6 +111,11 @@ prun = drivers_parser.add_parser('prun',
                                  usage=baseUsageStr.format('prun'),
                                  formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
 
+local = drivers_parser.add_parser('local',
+                                  help='Run your jobs locally, in parallel over files and event ranges',
+                                  usage=baseUsageStr.format('local'),
+                                  formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
+
 condor = drivers_parser.add_parser('condor', help='Flock your jobs to condor', usage=baseUsageStr.format('condor'), formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
 lsf = drivers_parser.add_parser('lsf', help='Flock your jobs to lsf', usage=baseUsageStr.format('lsf'), formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
 
@@ -163,6 +168,12 @@ prun.add_argument('--optCmtConfig',            metavar='', type=str, required=Fa
 prun.add_argument('--optGridDisableAutoRetry', metavar='', type=int, required=False, default=None)
 prun.add_argument('--optGridOutputSampleName', metavar='', type=str, required=False, help='Define output grid sample name', default='user.%nickname%.%in:name[4]%.%in:name[5]%.%in:name[6]%.%in:name[7]%_xAH')
 
+# define arguments for local driver
+local.add_argument('--nWorkers',         metavar='', type=int, required=False, default=0, help='Number of worker processes. (0 = number of cores)')
+local.add_argument('--minEventsPerUnit', metavar='', type=int, required=False, default=1000, help='Smallest event range a file is split into, at the end of the job.')
+local.add_argument('--keepUnits',        action='store_true', required=False, help='Keep the outputs of each unit of work (in <submitDir>/units) after merging them.')
+local.add_argument('--cacheDir',         metavar='<directory>', type=str, required=False, default=None, help='Keep the outputs of each input file in this directory, under a hash of the configuration. The unchanged files are not processed again by the next runs with the same configuration. The hash covers the files named in the configuration and in the TEnv configs (GRL, PRW, CDI, ...), but not those the tools find themselves (e.g. through the PathResolver, or a name relative to their data directory): clear the cache after changing these.')
+
 # define arguments for condor driver
 condor.add_argument('--optCondorConf', metavar='', type=str, required=False, default='stream_output = true')
 condor.add_argument('--optCondorWait', action='store_true' , required=False)
@@ -348,6 +359,14 @@ if __name__ == "__main__":
     xAH_logger.info("reading all metadata in $ROOTCOREBIN/data/xAODAnaHelpers/metadata")
     ROOT.SH.readSusyMetaDir(sh_all,"$ROOTCOREBIN/data/xAODAnaHelpers/metadata")
 
+    # the input files of each sample, in order, for the PrefetchNextFile option of BasicEventSelection
+    for sample in sh_all:
+      try:
+        sample.meta().setString("xAH_inputFiles", "\n".join(sample.fileName(i) for i in range(sample.numFiles())))
+      except Exception:
+        # the files of grid samples are only known on the grid
+        pass
+
     # this is the basic description of our job
     xAH_logger.info("creating new job")
     job = ROOT.EL.Job()
@@ -383,6 +402,8 @@ if __name__ == "__main__":
 
     # formatted string
     algorithmConfiguration_string = []
+    # the values set, for the hash of the configuration
+    algorithmConfiguration_values = []
     printStr = "\tsetting {0: >20}.{1:<30} = {2}"
 
     if load_json:
@@ -407,6 +428,7 @@ if __name__ == "__main__":
         for config_name, config_val in algorithm_configuration['configs'].iteritems():
           xAH_logger.info("\t%s", printStr.format(alg_name, config_name, config_val))
           algorithmConfiguration_string.append(printStr.format(alg_name, config_name, config_val))
+          algorithmConfiguration_values.append(config_val)
           alg_attr = getattr(alg, config_name, None)
           if alg_attr is None:
             raise ValueError("Algorithm %s does not have attribute %s" % (alg_name, config_name))
@@ -446,6 +468,7 @@ if __name__ == "__main__":
             elif len(configLog) == 3:
               xAH_logger.info("\t%s", printStr.format(*configLog))
               algorithmConfiguration_string.append(printStr.format(*configLog))
+              algorithmConfiguration_values.append(configLog[2])
             else:
               raise Exception("Something weird happened with the logging. Tell someone important")
 
@@ -460,6 +483,15 @@ if __name__ == "__main__":
       driver = ROOT.EL.DirectDriver()
     elif (args.driver == "prooflite"):
       driver = ROOT.EL.ProofDriver()
+    elif (args.driver == "local"):
+      import xAH_local
+      # everything that changes the outputs of an input file: the algorithms and their options (and the
+      # content of the files they name, e.g. their TEnv configs), the config file itself, the version,
+      # the release and the compiled libraries of all the packages, which change with local modifications of the code
+      configHash = xAH_local.configHash([__version__, args.config, args.treeName, args.access_mode, args.is_MC, args.is_AFII] + xAH_local.releaseItems() + algorithmConfiguration_string + algorithmConfiguration_values)
+      if args.cacheDir:
+        xAH_logger.info("\tcaching the outputs of each input file in %s", os.path.join(args.cacheDir, configHash))
+      driver = xAH_local.LocalDriver(args.nWorkers, args.minEventsPerUnit, args.keepUnits, args.cacheDir, configHash)
     elif (args.driver == "prun"):
       driver = ROOT.EL.PrunDriver()
 
@@ -15,6 +15,8 @@
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
+class ScaleFactorCache;
+
 class BJetEfficiencyCorrector : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -38,6 +40,16 @@ public:
   std::string m_decor;            // The decoration key written to passing objects
   std::string m_decorSF;          // The decoration key written to passing objects
 
+  bool        m_writeSFTable;     // store the SFs in a ScaleFactorTable in TStore (<decorSF>_Table), instead of decorating each jet
+
+  // SF memoization (see ScaleFactorCache). Only the efficiency SFs of the tagged jets are cached: the inefficiency SFs depend on the
+  // MC efficiency maps, which are not binned like the SFs. Do not use it with a smoothed CDI, whose SFs are not constant within a bin
+  bool        m_useSFCache;       // cache the SF of each (systematic, bin, flavour) of the tagged jets, instead of calling the tool for every jet
+  int         m_SFCacheSize;      // max number of cached SFs
+  int         m_SFCacheVerify;    // recompute one cached SF in every N and warn if the tool disagrees (i.e. the bins are wrong, or the CDI is smoothed). 0: off
+  std::string m_SFCachePtBins;    // comma-separated pT bin edges (GeV) - must include all the edges of the CDI calibration. Required
+  std::string m_SFCacheEtaBins;   // comma-separated eta bin edges - must include all the edges of the CDI calibration. Required
+
 private:
 
   bool m_isMC;        //!
@@ -46,6 +58,10 @@ private:
   BTaggingSelectionTool   *m_BJetSelectTool; //!
   BTaggingEfficiencyTool  *m_BJetEffSFTool; //!
 
+  ScaleFactorCache        *m_SFCache; //!
+  unsigned int             m_nSFCacheHits; //!
+  unsigned int             m_nSFCacheMismatches; //!
+
   // configuration variables
   bool m_getScaleFactors;  //!
 
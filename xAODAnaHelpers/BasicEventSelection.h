@@ -3,6 +3,7 @@
 
 // ROOT include(s):
 #include "TH1D.h"
+#include "TEntryList.h"
 
 // rootcore includes
 #include "GoodRunsLists/GoodRunsListSelectionTool.h"
@@ -10,6 +11,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/InputBranchFilter.h"
+#include "xAODAnaHelpers/InputPrefetcher.h"
 
 namespace TrigConf {
   class xAODConfigTool;
@@ -63,6 +66,17 @@ class BasicEventSelection : public xAH::Algorithm
     std::string m_derivationName;
     bool m_useMetaData;
 
+    // Input I/O: only read the branches used by the job (see InputBranchFilter)
+    int m_readLearnEntries;           // number of events to learn the branches from. 0: off
+    std::string m_readBranchesFile;   // static list of branches: no learning
+    std::string m_readBranchesOutput; // write the learnt list to this file
+    bool m_disableUnreadBranches;     // disable the other branches, on top of restricting the TTreeCache. Default: false. The job fails if one of them is read
+    int m_readCacheSizeMB;            // size of the TTreeCache. 0: keep the EventLoop one
+    bool m_preFilter;                 // scan each file (over the entries this job processes) for the entries passing the GRL, cleaning, NPV and trigger cuts, and only prefetch those
+    bool m_prefetchNextFile;          // read the start and the end of the next local input file in the background (see InputPrefetcher)
+    int m_prefetchHeadMB;             // MB read at the start of the next file (first baskets)
+    int m_prefetchTailMB;             // MB read at the end of the next file (keys and MetaData)
+
     /* Check for duplicated events in Data and MC */
     bool m_checkDuplicatesData;
     bool m_checkDuplicatesMC;
@@ -75,6 +89,18 @@ class BasicEventSelection : public xAH::Algorithm
     TrigConf::xAODConfigTool*    m_trigConfTool;  //!
     Trig::TrigDecisionTool*      m_trigDecTool;   //!
 
+    InputBranchFilter*           m_branchFilter;  //!
+    InputPrefetcher*             m_prefetcher;    //!
+
+    // entries of the current file passing the pre-filter
+    TEntryList*                  m_preFilterList;  //!
+    bool                         m_preFilterReady; //!
+
+    // cuts of execute() which only need EventInfo, the vertices and the trigger decision
+    bool passPreFilter( const xAOD::EventInfo* eventInfo );
+    // read the light branches of all the entries of the current file, and restrict the TTreeCache to the passing ones
+    EL::StatusCode preFilterFile ();
+
     bool m_isMC;      //!
 
     int m_eventCounter;     //!
@@ -88,6 +114,9 @@ class BasicEventSelection : public xAH::Algorithm
     double m_MD_initialSumWSquared;  //!
     double m_MD_finalSumWSquared;    //!
 
+    // fill MetaData_EventCount with the meta data of the current file
+    void countMetaData ();
+
     // cutflow
     TH1D* m_cutflowHist;    //!
     TH1D* m_cutflowHistW;   //!
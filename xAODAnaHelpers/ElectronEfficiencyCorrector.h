@@ -16,6 +16,8 @@
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
+class ScaleFactorCache;
+
 class ElectronEfficiencyCorrector : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -42,6 +44,15 @@ public:
   std::string m_corrFileNameReco;
   std::string m_corrFileNameTrig;
 
+  // write the per-object SFs in a single ScaleFactorTable per SF type in TStore ('<OutputSystNames>_Table'), instead of a vector<float> decoration per object
+  bool        m_writeSFTable;
+
+  // SF memoization (see ScaleFactorCache)
+  bool        m_useSFCache;       // cache the SF of each (systematic, bin) pair, instead of calling the tools for every electron
+  int         m_SFCacheSize;      // max number of cached SFs per tool
+  std::string m_SFCachePtBins;    // comma-separated Et bin edges (GeV) - must include all the edges of the SF maps. Required
+  std::string m_SFCacheEtaBins;   // comma-separated eta bin edges - must include all the edges of the SF maps. Required
+
 private:
   int m_numEvent;         //!
   int m_numObject;        //!
@@ -59,6 +70,10 @@ private:
   AsgElectronEfficiencyCorrectionTool  *m_asgElEffCorrTool_elSF_Reco; //!
   AsgElectronEfficiencyCorrectionTool  *m_asgElEffCorrTool_elSF_Trig; //!
 
+  ScaleFactorCache  *m_SFCachePID;   //!
+  ScaleFactorCache  *m_SFCacheReco;  //!
+  ScaleFactorCache  *m_SFCacheTrig;  //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -87,6 +102,12 @@ public:
   virtual EL::StatusCode configure ();
   virtual EL::StatusCode executeSF (  const xAOD::ElectronContainer* inputElectrons, const xAOD::EventInfo* eventInfo, unsigned int countSyst  );
 
+private:
+  CP::CorrectionCode getCachedSF ( AsgElectronEfficiencyCorrectionTool* tool, ScaleFactorCache* cache, const CP::SystematicSet& syst,
+                                   const xAOD::Electron* el, unsigned int runNumber, double& sf );
+
+public:
+
   /// @cond
   // this is needed to distribute the algorithm to the workers
   ClassDef(ElectronEfficiencyCorrector, 1);
@@ -23,6 +23,8 @@ namespace Trig {
   class TrigEgammaMatchingTool;
 }
 
+class TrigMatchingEngine;
+
 class ElectronSelector : public xAH::Algorithm
 {
   /*
@@ -64,6 +66,7 @@ public:
 
   bool           m_readIDFlagsFromDerivation;
   std::string    m_confDirPID;
+  bool           m_singlePassPID;            /* evaluate all the PID WPs of a given type in one pass, stopping at the first failing WP (see ParticlePIDManager::evaluateWPs()) */
 
   /* likelihood-based  */
   bool           m_doLHPIDcut;
@@ -83,12 +86,15 @@ public:
   std::string    m_TrackIsoEff;              /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
   std::string    m_CaloBasedIsoType;         /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
   std::string    m_TrackBasedIsoType;        /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
+  bool           m_singlePassIso;            /* decorate w/ the decisions of all the WPs packed in a single 'isIsolatedBits' word, instead of one 'isIsolated_*' flag per WP */
 
   /* trigger matching */
 
   std::string    m_ElTrigChains;   /* A comma-separated string w/ alll the HLT electron trigger chains for which you want to perform the matching.
   				      This is passed by the user as input in configuration
 				      If left empty (as it is by default), no trigger matching will be attempted at all */
+  float          m_minDeltaR;      /* max dR between offline and HLT electron - used only by TrigMatchingEngine */
+  bool           m_useTrigMatchingEngine; /* match w/ TrigMatchingEngine (features fetched once per event) instead of TrigEgammaMatchingTool */
 
 private:
 
@@ -124,6 +130,9 @@ private:
   int   m_el_cutflow_iso_cut;          //!
 
   std::vector<std::string> m_IsoKeys;  //!
+  std::vector<unsigned int> m_IsoCutPositions; //!  /* position of each WP in the TAccept returned by the isolation tool */
+  std::vector<int>          m_IsoBits;         //!  /* bit of each WP in the 'isIsolatedBits' decoration (-1: not packable) */
+  unsigned int              m_MinIsoCutPosition; //!
 
   /* tools */
 
@@ -132,9 +141,12 @@ private:
   /* PID manager(s) */
   ElectronLHPIDManager*            m_el_LH_PIDManager;       //!
   ElectronCutBasedPIDManager*      m_el_CutBased_PIDManager; //!
+  unsigned int                     m_LHPassBit;              //!  /* bit of the selected LH WP in the mask of evaluateWPs() */
+  unsigned int                     m_CutBasedPassBit;        //!  /* bit of the selected cut-based WP in the mask of evaluateWPs() */
 
   Trig::TrigDecisionTool*          m_trigDecTool;            //!
   Trig::TrigEgammaMatchingTool*    m_trigElMatchTool;        //!
+  TrigMatchingEngine*              m_trigElMatchEngine;      //!
 
   /* other private members */
 
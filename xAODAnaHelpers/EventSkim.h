@@ -0,0 +1,104 @@
+#ifndef xAODAnaHelpers_EventSkim_H
+#define xAODAnaHelpers_EventSkim_H
+
+/** @file EventSkim.h
+ *  @brief Cheap event-level skim predicate, evaluated before filling trees or histograms
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// EDM include(s):
+#include "xAODEventInfo/EventInfo.h"
+#include "xAODRootAccess/TEvent.h"
+#include "xAODRootAccess/TStore.h"
+
+// local include(s):
+#include "AsgTools/StatusCode.h"
+
+// C++ include(s)
+#include <string>
+#include <vector>
+
+/**
+    @brief Decide whether an event should be written/histogrammed, from a predicate string
+    @rst
+        The predicate is a list of alternatives separated by ``||``, each of them a list of terms separated by ``&&``.
+        The terms are
+
+        ================================== =====================================================================================
+        Term                               Passes if
+        ================================== =====================================================================================
+        ``count(<container>) <op> <N>``    the number of objects in the container (``TStore`` or ``TEvent``) satisfies the comparison
+        ``met(<container>[,<term>]) <op>`` the MET of the term (default ``FinalClus``), in GeV, satisfies the comparison
+        ``trigger(<chain>)``               the chain is in the ``passTriggers`` decoration of ``EventInfo`` (see :cpp:class:`BasicEventSelection`)
+        ================================== =====================================================================================
+
+        where ``<op>`` is one of ``>=``, ``>``, ``<=``, ``<``, ``==``, ``!=``. For example::
+
+            count(AntiKt4EMTopoJets_Signal) >= 2 && met(RefFinal) > 50 || trigger(HLT_xe70)
+
+        The evaluation is lazy: the terms are evaluated from left to right, and each alternative stops at its first failing term,
+        without retrieving the containers of the following ones. Put the cheapest and most selective terms first.
+
+    @endrst
+ */
+class EventSkim
+{
+
+  public:
+
+    /** @param predicate    The predicate string. Empty: all the events pass */
+    EventSkim( const std::string& predicate = "" );
+    ~EventSkim();
+
+    /** @brief False if the predicate could not be parsed */
+    bool isValid() const { return m_valid; }
+    /** @brief True if there is nothing to check */
+    bool empty() const { return m_alternatives.empty(); }
+
+    /** @brief Evaluate the predicate for this event. Fails only if a container used by an evaluated term is missing */
+    StatusCode evaluate( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass );
+
+    /** @brief Print the number of events evaluated and passed */
+    void printStats() const;
+
+    /**
+        @brief The skim of an algorithm with a ``SkimPredicate`` option: ``skim`` is set to ``nullptr`` if the predicate is empty
+        @rst
+            Used by :cpp:class:`TreeAlgo` and the ``*HistsAlgo``, together with :cpp:func:`EventSkim::passes` and :cpp:func:`EventSkim::release`. Fails if the predicate cannot be parsed.
+        @endrst
+    */
+    static StatusCode create( const std::string& predicate, EventSkim*& skim );
+    /** @brief Evaluate the skim of an algorithm for this event: all the events pass if there is none */
+    static StatusCode passes( EventSkim* skim, const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass );
+    /** @brief Print the statistics of the skim of an algorithm, and delete it */
+    static void release( EventSkim*& skim );
+
+  private:
+
+    enum TermType { COUNT, MET, TRIGGER };
+    enum Operator { GE, GT, LE, LT, EQ, NE };
+
+    struct Term {
+      TermType     m_type;
+      std::string  m_name;      // container or trigger chain
+      std::string  m_metTerm;   // MET only
+      Operator     m_op;
+      float        m_value;
+    };
+
+    bool parseTerm( const std::string& termStr, Term& term ) const;
+    StatusCode evaluateTerm( const Term& term, const xAOD::EventInfo* eventInfo, xAOD::TEvent* event, xAOD::TStore* store, bool& pass ) const;
+    bool compare( Operator op, float lhs, float rhs ) const;
+
+    std::string                       m_predicate;
+    bool                              m_valid;
+    /* OR of ANDs */
+    std::vector< std::vector<Term> >  m_alternatives;
+
+    unsigned long long                m_nEvaluated;
+    unsigned long long                m_nPassed;
+
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef xAODAnaHelpers_EventWeightBuilder_H
+#define xAODAnaHelpers_EventWeightBuilder_H
+
+// EDM include(s):
+#include "xAODEventInfo/EventInfo.h"
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+/**
+    @brief Combine the MC event weight, the pileup weight and all the SFs into one vector of event weights, indexed by systematic
+    @rst
+        Each of the efficiency correctors stores the product of the SFs of all the objects in the event, for each of its systematics.
+        This algorithm reads all of them (from the :cpp:class:`ScaleFactorTable` in ``TStore`` if any, or from the ``<name>_GLOBAL`` or ``<name>`` ``EventInfo`` decoration)
+        and decorates ``EventInfo`` with a single ``std::vector<float>`` (``OutputWeightName``), laid out as follows:
+
+        - index 0 is the nominal weight: ``mcEventWeight`` :math:`\times` ``PileupWeight`` :math:`\times` the nominal SF of every source
+        - then, for each source in the order given in ``InputSFNames``, one entry per systematic of that source (nominal excluded), where that source is varied and all the others are nominal
+
+        The names of the weights (``"nominal"``, then the systematic names read from ``TStore``) are recorded in ``TStore`` as a ``std::vector<std::string>`` named ``<OutputWeightName>_Names``, on data too (where the only weight is the nominal one).
+        The layout is fixed at the first event, from the vectors of systematic names recorded by the correctors, so a given index always refers to the same systematic.
+        The job fails if the systematic names of a source are not found in ``TStore``.
+
+        .. note:: The first SF of each source is taken as the nominal one, as the correctors always process the nominal first.
+
+    @endrst
+ */
+class EventWeightBuilder : public xAH::Algorithm
+{
+  // put your configuration variables here as public variables.
+  // that way they can be set directly from CINT and python.
+public:
+
+  // configuration variables
+  std::string m_inputSFNames;       // comma-separated list of SF sources: "<SF name>" or "<SF name>:<name of the vector of syst names in TStore>"
+  bool        m_usePileupWeight;    // multiply by the "PileupWeight" decoration
+  bool        m_useMCEventWeight;   // multiply by the "mcEventWeight" decoration (or EventInfo::mcEventWeight())
+  std::string m_outputWeightName;   // name of the output EventInfo decoration
+
+private:
+
+  struct SFSource {
+    std::string m_name;             // name of the SF decoration/table
+    std::string m_systNamesKey;     // name of the vector of systematic names in TStore
+    unsigned int m_offset;          // index of the first systematic of this source in the output vector
+    unsigned int m_nSysts;          // number of systematics, nominal included
+  };
+
+  // retrieve the per-systematic event SFs of a source. Returns nullptr if not available in this event
+  const std::vector<float>* getEventSFs( unsigned int iSource, const xAOD::EventInfo* eventInfo );
+  // fix the layout of the output vector, and the names of the weights, from the systematic names recorded in TStore by the correctors
+  EL::StatusCode buildLayout();
+  // record the names of the weights in TStore
+  EL::StatusCode recordWeightNames();
+
+  std::vector<SFSource>        m_sources;       //!
+  // "<name>_GLOBAL" (object SFs) and "<name>" (event-level SFs, e.g. trigger) decorations, one per source
+  std::vector< SG::AuxElement::ConstAccessor< std::vector<float> > > m_accGlobal; //!
+  std::vector< SG::AuxElement::ConstAccessor< std::vector<float> > > m_accEvent;  //!
+  bool                         m_layoutReady;   //!
+  std::vector<std::string>     m_weightNames;   //!
+
+  // per-event buffers
+  std::vector<float>           m_nominalSFs;    //!
+  std::vector<float>           m_exclusive;     //!
+  std::vector<const std::vector<float>* > m_eventSFs; //!
+
+  int m_numEvent;                               //!
+
+  // variables that don't get filled at submission time should be
+  // protected from being send from the submission node to the worker
+  // node (done by the //!)
+public:
+
+  // this is a standard constructor
+  EventWeightBuilder (std::string className = "EventWeightBuilder");
+
+  // these are the functions inherited from Algorithm
+  virtual EL::StatusCode setupJob (EL::Job& job);
+  virtual EL::StatusCode fileExecute ();
+  virtual EL::StatusCode histInitialize ();
+  virtual EL::StatusCode changeInput (bool firstFile);
+  virtual EL::StatusCode initialize ();
+  virtual EL::StatusCode execute ();
+  virtual EL::StatusCode postExecute ();
+  virtual EL::StatusCode finalize ();
+  virtual EL::StatusCode histFinalize ();
+
+  // these are the functions not inherited from Algorithm
+  virtual EL::StatusCode configure ();
+
+  /// @cond
+  // this is needed to distribute the algorithm to the workers
+  ClassDef(EventWeightBuilder, 1);
+  /// @endcond
+
+};
+
+#endif
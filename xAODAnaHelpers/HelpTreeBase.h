@@ -28,6 +28,7 @@
 #include "xAODMissingET/MissingETContainer.h"
 
 #include "xAODAnaHelpers/HelperClasses.h"
+#include "xAODAnaHelpers/ScaleFactorTable.h"
 #include "xAODRootAccess/TEvent.h"
 #include "xAODRootAccess/TStore.h"
 
@@ -37,6 +38,11 @@
 #include "TTree.h"
 #include "TFile.h"
 
+// c++ includes
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 namespace TrigConf {
   class xAODConfigTool;
 }
@@ -51,7 +57,7 @@ public:
 
   HelpTreeBase(xAOD::TEvent *event, TTree* tree, TFile* file, const float units = 1e3, bool debug = false, bool DC14 = false, xAOD::TStore* store = nullptr );
   HelpTreeBase(TTree* tree, TFile* file, xAOD::TEvent *event = nullptr, xAOD::TStore* store = nullptr, const float units = 1e3, bool debug = false, bool DC14 = false );
-  virtual ~HelpTreeBase() {;}
+  virtual ~HelpTreeBase();
 
   void AddEvent       (const std::string detailStr = "");
   void AddTrigger     (const std::string detailStr = "");
@@ -104,6 +110,25 @@ public:
   void FillMET( const xAOD::MissingETContainer* met );
 
   void Fill();
+
+  // write the tree in a background thread: Fill() hands the event over to the writer and returns, so that
+  // TTree::Fill overlaps with whatever the job does between Fill() and the next Fill*/Clear* call.
+  // There is a single set of branch variables, so that call waits for the writer to be done with them.
+  // Returns false if not supported by this ROOT version, or if another tree already has a writer for the same file
+  bool EnableAsyncWrite();
+  // block until the last event handed over by Fill() is in the tree.
+  // Call it before touching the branch variables outside of the Fill*/Clear* functions
+  void WaitForWrite();
+  // write the last event handed over by Fill() and stop the writer thread. Call it before deleting the tree:
+  // the destructor of a class deriving from HelpTreeBase must call it first if it adds branches of its own,
+  // as its members are destroyed before ~HelpTreeBase() could stop the writer
+  void StopAsyncWrite();
+
+  // name of the EventInfo container holding the event-level decorations read by the Fill* functions
+  // (trigger matching chains, b-tagging SFs). Default: "EventInfo"
+  void setEventInfoName( const std::string& name ) { m_eventInfoName = name; }
+  // name of the EventInfo decoration filled into weight_event (the OutputWeightName of EventWeightBuilder). Default: "EventWeights"
+  void setEventWeightsName( const std::string& name ) { m_eventWeightsName = name; }
   void ClearEvent();
   void ClearTrigger();
   void ClearJetTrigger();
@@ -191,6 +216,49 @@ public:
   template<typename T, typename U>
     void safeFill(const xAOD::Jet* jet, SG::AuxElement::ConstAccessor<T>& accessor, std::vector<U>& destination, U defaultValue, int m_units = 1);
 
+  // fill the SFs of an object (one per systematic), reading them from the ScaleFactorTable(s) in TStore if any, or from the decoration otherwise
+  void fillSF(const SG::AuxElement& obj, const SG::AuxElement::ConstAccessor< std::vector<float> >& accessor, std::vector< std::vector<float> >& destination);
+  // clear the SFs filled by fillSF(), keeping their rows for the next event
+  void clearSF(std::vector< std::vector<float> >& destination);
+  std::vector< std::vector<float> > m_sfRowPool;
+  // the ScaleFactorTable(s) written instead of a SF decoration (<decoration>_Table, <decoration>_Table_1, ...), cached for the current event (see FillEvent())
+  const std::vector<const ScaleFactorTable*>& getSFTables(const SG::AuxElement::ConstAccessor< std::vector<float> >& accessor);
+  std::map< SG::auxid_t, std::vector<const ScaleFactorTable*> > m_sfTables;
+
+  // reduced-precision storage of the float branches, requested with precision_<group>=<spec> in the detail strings (see HelperClasses::InfoSwitch::m_precision)
+  struct ReducedPrecision {
+    enum Mode { TRUNCATE, RANGE, FIXED };
+    Mode  m_mode;
+    int   m_bits;   // mantissa bits (TRUNCATE) or bits over the range (RANGE)
+    float m_min;    // RANGE
+    float m_max;    // RANGE
+    float m_step;   // RANGE and FIXED: the requested step, rounded down to a power of two
+    ReducedPrecision() : m_mode(TRUNCATE), m_bits(23), m_min(0), m_max(0), m_step(0) {}
+    bool  parse( const std::string& spec );
+    float apply( float value ) const;
+    static float powerOfTwoStep( float step );
+  };
+  // register the float branches created from branch number firstBranch on, with the precision requested in the detail string
+  void setPrecision( const HelperClasses::InfoSwitch* infoSwitch, int firstBranch );
+  // group of a branch for the precision requests: angles, kinematic, SF or other
+  std::string getPrecisionGroup( const std::string& branchName ) const;
+  // round the registered branch variables, just before they are written
+  void applyPrecision();
+  std::vector< std::pair< float*, ReducedPrecision > >                              m_reducedFloats;
+  std::vector< std::pair< std::vector<float>*, ReducedPrecision > >                 m_reducedVectors;
+  std::vector< std::pair< std::vector< std::vector<float> >*, ReducedPrecision > >  m_reducedVectorVectors;
+
+private:
+
+  // background writer
+  void writerLoop();
+  std::thread             m_writerThread;
+  std::mutex              m_writerMutex;
+  std::condition_variable m_writerCV;
+  bool                    m_writePending;
+  bool                    m_stopWriter;
+  TFile*                  m_asyncWriteFile;
+
 protected:
 
   TTree* m_tree;
@@ -201,6 +269,23 @@ protected:
   bool m_DC14;
   bool m_isMC;
 
+  std::string m_eventInfoName;
+  std::string m_eventWeightsName;
+  // retrieve m_eventInfoName, with an error if it is not there
+  const xAOD::EventInfo* retrieveEventInfo( const std::string& caller );
+
+  // an isolation WP branch, filled from the 'isIsolated_<WP>' flag of the object or else from its packed 'isIsolatedBits'
+  // word, at the bit of the WP (see HelperFunctions::getIsolationWPBit()) resolved once when the branches are added
+  struct IsolationWP {
+    IsolationWP( const std::string& WP, std::vector<int>* vec );
+    SG::AuxElement::ConstAccessor<char> flag;
+    int                                 bit;
+    std::vector<int>*                   branch;
+  };
+  std::vector<IsolationWP> m_muon_isoWPs;
+  std::vector<IsolationWP> m_el_isoWPs;
+  void FillIsolation( const SG::AuxElement& particle, std::vector<IsolationWP>& isoWPs );
+
   // event
   int m_runNumber;
   long int m_eventNumber;
@@ -260,6 +345,9 @@ protected:
   std::vector<float> m_weight_electron_PIDEff_SF_LHMedium;
   std::vector<float> m_weight_electron_PIDEff_SF_LHTight;
 
+  // combined event weights (see EventWeightBuilder)
+  std::vector<float> m_eventWeights;
+
   // trigger
   int m_passL1;
   int m_passHLT;
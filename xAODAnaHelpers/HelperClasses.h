@@ -70,6 +70,8 @@ namespace HelperClasses {
             Partial
                 If a variable is partially matched to a string, then there is some specific pattern we are extracting that will succeed the partial match that determines what the variable will be set to (usually not a bool).
 
+        The float branches of the tree can also be stored with a reduced precision, with tokens ``precision_<group>=<spec>`` (see :cpp:member:`~HelperClasses::InfoSwitch::m_precision`).
+
     @endrst
    */
   struct InfoSwitch {
@@ -81,6 +83,34 @@ namespace HelperClasses {
         The vector of tokens from which we search through for finding matches.
      */
     std::set<std::string> m_configDetails;
+    /**
+        @rst
+            The reduced precision requested for each group of float branches, from the ``precision_<group>=<spec>`` tokens.
+
+            ========= ====================================================
+            Group     Branches
+            ========= ====================================================
+            angles    eta, phi, theta
+            kinematic pt, m, E, px, py, pz, MET
+            SF        scale factors and weights
+            other     any other float
+            all       any group without its own request
+            ========= ====================================================
+
+            ======================== ==========================================================================================
+            Spec                     Storage
+            ======================== ==========================================================================================
+            trunc<N>                 float with N mantissa bits (e.g. ``trunc10``)
+            range<min>:<max>:<N>     Float16_t-like, at least N bits over [min, max] (e.g. ``range0:2:12``). Values outside are kept
+            fixed<step>              fixed point (e.g. ``fixed0.001`` for angles)
+            ======================== ==========================================================================================
+
+            The branches keep their type, and the ``-999`` sentinels are kept exactly, so that they all compress to almost nothing.
+            The ``range`` and ``fixed`` steps are rounded down to a power of two (``fixed0.001`` rounds to multiples of 2^-10):
+            only then are the low mantissa bits zero, which is what the compression gains from.
+        @endrst
+     */
+    std::map<std::string, std::string> m_precision;
     /**
         @brief Constructor. Take in input string, create vector of tokens.
         @param configStr        The configuration string to split up.
@@ -89,8 +119,13 @@ namespace HelperClasses {
         // parse and split by space
         std::string token;
         std::istringstream ss(m_configStr);
-        while ( std::getline(ss, token, ' ') )
+        while ( std::getline(ss, token, ' ') ) {
             m_configDetails.insert(token);
+            // reduced precision: precision_<group>=<spec>
+            std::size_t eq = token.find('=');
+            if ( token.compare(0, 10, "precision_") == 0 && eq != std::string::npos )
+                m_precision[ token.substr(10, eq - 10) ] = token.substr(eq + 1);
+        }
     };
     /**
         @rst
@@ -133,6 +168,7 @@ namespace HelperClasses {
         m_caloClus     caloClusters exact
         m_muonSF       muonSF       exact
         m_electronSF   electronSF   exact
+        m_eventWeights eventWeights exact
         ============== ============ =======
     @endrst
    */
@@ -144,6 +180,7 @@ namespace HelperClasses {
     bool m_caloClus;
     bool m_muonSF;
     bool m_electronSF;
+    bool m_eventWeights;
     void initialize();
     EventInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
   };
@@ -45,6 +45,11 @@ namespace HelperFunctions {
   std::string replaceString(std::string subjet, const std::string& search, const std::string& replace);
   std::vector<TString> SplitString(TString& orig, const char separator);
 
+  // isolation WP decisions packed in a single 'isIsolatedBits' decoration (see Electron/MuonSelector):
+  // bit N is set if the object passes the WP, bit N+16 if the WP has been evaluated at all
+  int getIsolationWPBit( const std::string& WP );                     // -1 if the WP cannot be packed
+  int getIsolationDecision( uint32_t isoBits, const std::string& WP ); // 1: pass, 0: fail, -1: not evaluated
+
   /*@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@*\
   |                                                                            |
   |   Author  : Marco Milesi                                                   |
@@ -8,12 +8,15 @@
  */
 
 #include <ctype.h>
+#include <map>
 #include <TH1.h>
 #include <TH1F.h>
 #include <TH2F.h>
 #include <TH3F.h>
 #include <EventLoop/Worker.h>
 #include <xAODRootAccess/TEvent.h>
+#include <xAODRootAccess/TStore.h>
+#include <xAODEventInfo/EventInfo.h>
 
 // for StatusCode::isSuccess
 #include "AsgTools/StatusCode.h"
@@ -51,6 +54,14 @@ class HistogramManager {
     std::string m_detailStr;
     /** @brief a container holding all generated histograms */
     std::vector< TH1* > m_allHists; //!
+    /** @brief the names of the weight channels (e.g. the SF systematics), nominal excluded */
+    std::vector< std::string > m_weightChannels; //!
+    /** @brief for each histogram, its copies filled with the weight of each channel */
+    std::map< TH1*, std::vector< TH1* > > m_channelHists; //!
+    /** @brief the nominal weight of the current event */
+    double m_nominalWeight; //!
+    /** @brief the weight of each channel for the current event */
+    std::vector< double > m_channelWeights; //!
 
   public:
     /**
@@ -179,7 +190,81 @@ class HistogramManager {
      */
     void record(EL::Worker* wk);
 
+    /**
+        @brief Book one copy of all the histograms per weight channel
+        @rst
+            Weight-only systematics (e.g., the SF variations built by :cpp:class:`EventWeightBuilder`) do not change the kinematics, so they can be
+            filled in the same pass as the nominal histograms: the bin is found once, and the weight of each channel is added to the copy of the histogram for that channel.
+            The copies of ``<name>/<hist>`` are named ``<name>/<channel>/<hist>``.
+
+            .. note:: Only the histograms filled with :cpp:func:`HistogramManager::fill` get the weight channels.
+
+        @endrst
+        @param channels The names of the weight channels, nominal excluded
+        @param wk       If the histograms were already recorded, the worker to record the copies to
+    */
+    void setWeightChannels(const std::vector<std::string>& channels, EL::Worker* wk = nullptr);
+
+    /**
+        @brief Set the weights of the channels for the current event
+        @param weights  The nominal weight first, then one weight per channel (as in the vector built by :cpp:class:`EventWeightBuilder`)
+    */
+    void setEventWeights(const std::vector<float>& weights);
+
+    /**
+        @brief Book the weight channels, if not done yet, and set their weights for the current event
+        @param channels The names of the weight channels, nominal excluded (see :cpp:func:`HistogramManager::readEventWeights`)
+        @param weights  The nominal weight first, then one weight per channel
+        @param wk       The worker to record the copies of the histograms to
+    */
+    void setEventWeights(const std::vector<std::string>& channels, const std::vector<float>& weights, EL::Worker* wk);
+
+    /**
+        @brief Read the weight of the event, and its weight systematics, for the algorithms filling histograms
+        @rst
+            The weight is the nominal one of the ``weightName`` vector of ``EventInfo`` (built by :cpp:class:`EventWeightBuilder`), or ``mcEventWeight`` if there is none.
+
+            If ``fillWeightSysts`` is set and the vector has systematics (never on data, where it only holds the nominal weight), ``weights`` points to it, and
+            ``channels`` holds the names of its systematics, read from ``<weightName>_Names`` in ``TStore`` at the first such event only. Otherwise ``weights`` is ``nullptr``.
+            Pass both to :cpp:func:`HistogramManager::setEventWeights` for each set of histograms.
+        @endrst
+    */
+    static StatusCode readEventWeights(const xAOD::EventInfo* eventInfo, const std::string& weightName, bool fillWeightSysts, xAOD::TStore* store,
+                                       float& eventWeight, const std::vector<float>*& weights, std::vector<std::string>& channels);
+
+    /** @brief Number of weight channels, nominal excluded */
+    unsigned int getNWeightChannels() const { return m_weightChannels.size(); }
+
+  protected:
+    /**
+        @brief Fill a histogram and all of its weight channels
+        @rst
+            This should be used instead of ``TH1::Fill()`` by the classes inheriting from :cpp:class:`HistogramManager`.
+            Each channel is filled with its weight given in :cpp:func:`HistogramManager::setEventWeights`, times the factor of ``w`` on top of the nominal weight
+            (``w`` divided by the nominal weight). If the nominal weight is 0, the factor is taken to be 1.
+
+        @endrst
+        @param hist     The histogram to fill
+        @param x        The value to fill
+        @param w        The (nominal) weight
+        @return         The bin which was filled
+    */
+    int fill(TH1F* hist, double x, double w = 1.0);
+    /**
+     * @overload
+     */
+    int fill(TH2F* hist, double x, double y, double w = 1.0);
+    /**
+     * @overload
+     */
+    int fill(TH3F* hist, double x, double y, double z, double w = 1.0);
+
   private:
+    /**
+     * @brief Add the weight of each channel to the given bin of the copies of a histogram
+     */
+    void fillChannels(TH1* hist, int bin, double w);
+
     /**
      * @brief Turn on Sumw2 for the histogram
      *
@@ -0,0 +1,98 @@
+#ifndef xAODAnaHelpers_InputBranchFilter_H
+#define xAODAnaHelpers_InputBranchFilter_H
+
+/** @file InputBranchFilter.h
+ *  @brief Restrict the reading of the input tree to the branches actually used by the job
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// local include(s):
+#include "AsgTools/StatusCode.h"
+
+// ROOT include(s):
+#include "TTree.h"
+
+// C++ include(s)
+#include <set>
+#include <string>
+
+/**
+    @brief Learn (or read from a file) the list of input branches used by the job, and only read those
+    @rst
+        During a learning phase over the first events, the branches of the input ``CollectionTree`` that have been read by any of the algorithms
+        (i.e., the containers and the aux variables retrieved through ``TEvent``) are recorded. At the end of the learning phase,
+        and then for every new input file:
+
+        - the ``TTreeCache`` is set to prefetch exactly the recorded branches, and its own learning phase is stopped
+        - if ``disableUnused`` is true, all the other branches are disabled (``SetBranchStatus``)
+
+        The list can be printed and written to a text file (one branch per line, ``#`` for comments), and that file can be given back
+        instead of learning, e.g. for grid jobs, so that the restriction applies from the first event.
+
+        A branch that is not read during the learning phase (e.g., a container only retrieved for rare events) is still read when it is needed,
+        only without the prefetching of the cache. With ``disableUnused``, it could not be read at all, and ``TEvent`` would silently
+        hand out stale values: check() then detects that such a branch has been connected, so that the job fails instead.
+
+        See :cpp:class:`BasicEventSelection`, which drives it.
+
+    @endrst
+ */
+class InputBranchFilter
+{
+
+  public:
+
+    /**
+        @param learnEntries    Number of events of the learning phase. 0: do not learn (use readList())
+        @param disableUnused   Disable the branches that are not in the list, on top of restricting the cache
+        @param cacheSize       Size of the ``TTreeCache`` in bytes. 0: keep the one set by EventLoop
+    */
+    InputBranchFilter( unsigned int learnEntries = 0, bool disableUnused = false, Long64_t cacheSize = 0 );
+    ~InputBranchFilter();
+
+    /** @brief Read a static list of branches, and skip the learning phase */
+    StatusCode readList( const std::string& fileName );
+    /** @brief Write the list of branches, in the format expected by readList() */
+    StatusCode writeList( const std::string& fileName ) const;
+
+    /** @brief True until the learning phase is over (or a list has been read) */
+    bool isLearning() const { return m_learning; }
+
+    /**
+        @brief Record the branches of the tree read so far. Call it at the start of each event while learning
+        @param tree         The input tree
+        @param countEvent   Count this call as the start of a new event (false: only record, e.g. at the end of a file)
+        @returns True if this call ended the learning phase (the restriction is then applied to the tree)
+    */
+    bool learn( TTree* tree, bool countEvent = true );
+
+    /** @brief Apply the restriction to a (new) input tree. Does nothing while learning */
+    void apply( TTree* tree ) const;
+
+    /**
+        @brief Fail if a disabled branch has been connected (i.e. something tried to read it) since apply(). Call it at the start of each event
+        @returns FAILURE naming the branch, SUCCESS if none or if the branches are not disabled
+    */
+    StatusCode check( TTree* tree ) const;
+
+    /** @brief Print the list of branches */
+    void print() const;
+
+    const std::set<std::string>& getBranches() const { return m_branches; }
+
+  private:
+
+    void collect( TObjArray* branches );
+
+    unsigned int           m_learnEntries;
+    bool                   m_disableUnused;
+    Long64_t               m_cacheSize;
+
+    bool                   m_learning;
+    unsigned int           m_nLearned;
+    std::set<std::string>  m_branches;
+
+};
+
+#endif
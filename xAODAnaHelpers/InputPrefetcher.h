@@ -0,0 +1,71 @@
+#ifndef xAODAnaHelpers_InputPrefetcher_H
+#define xAODAnaHelpers_InputPrefetcher_H
+
+/** @file InputPrefetcher.h
+ *  @brief Warm the next input file of the job in the background, while the current one is processed
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// ROOT include(s):
+#include "Rtypes.h"
+
+// C++ include(s)
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+    @brief Read the start and the end of the next input file in a background thread, so that opening it does not stall the job
+    @rst
+        When the job moves to a new input file, it opens it, reads its keys and the ``MetaData`` tree (the ``CutBookkeepers``
+        read by :cpp:class:`BasicEventSelection`), then the first baskets of the ``CollectionTree``. On a slow disk, or on a network
+        file system mounted locally (NFS, EOS or CVMFS through FUSE, ...), all of this is read on demand, while the job waits.
+
+        Given the list of input files of the job, ``prefetchNext()`` reads, in a background thread and with plain POSIX reads,
+        the first ``headBytes`` (the first cluster of baskets of the tree) and the last ``tailBytes`` (the keys, the streamer
+        infos and the ``MetaData`` tree, written when the file is closed) of the file after the current one. The file is
+        then opened by ROOT from the page cache of the system.
+
+        .. note:: ROOT itself is not used in the thread: the files opened through a ROOT protocol (e.g. ``root://``) are not prefetched.
+
+        See :cpp:class:`BasicEventSelection`, which drives it.
+
+    @endrst
+ */
+class InputPrefetcher
+{
+
+  public:
+
+    /**
+        @param files       The input files of the job, in the order in which they are processed
+        @param headBytes   Number of bytes read at the start of the file
+        @param tailBytes   Number of bytes read at the end of the file
+    */
+    InputPrefetcher( const std::vector<std::string>& files = std::vector<std::string>(), Long64_t headBytes = 0, Long64_t tailBytes = 0 );
+    /** @brief Waits for the background read to finish */
+    ~InputPrefetcher();
+
+    /** @brief Start reading the file that follows currentFile in the list, if any. Returns false if there is none (or it cannot be prefetched) */
+    bool prefetchNext( const std::string& currentFile );
+
+    /** @brief Wait for the background read to finish */
+    void wait();
+
+  private:
+
+    // local path of a file of the list. Empty if it is not on a POSIX file system
+    static std::string localPath( const std::string& file );
+    // the work of the background thread
+    static void warm( std::string path, Long64_t headBytes, Long64_t tailBytes );
+
+    std::vector<std::string>  m_files;
+    Long64_t                  m_headBytes;
+    Long64_t                  m_tailBytes;
+
+    std::thread               m_thread;   //!
+
+};
+
+#endif
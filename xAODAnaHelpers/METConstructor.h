@@ -8,6 +8,16 @@
 #include "xAODRootAccess/TEvent.h"
 #include "xAODRootAccess/TStore.h"
 
+// EDM include(s):
+#include "AthContainers/ConstDataVector.h"
+#include "xAODBase/IParticleContainer.h"
+#include "xAODBase/ObjectType.h"
+#include "xAODEgamma/Photon.h"
+#include "xAODTau/TauJet.h"
+#include "xAODJet/JetContainer.h"
+#include "xAODMissingET/MissingETContainer.h"
+#include "xAODMissingET/MissingETAssociationMap.h"
+
 
 
 using std::string;
@@ -48,12 +58,61 @@ public:
   bool    m_useCaloJetTerm;
   bool    m_useTrackJetTerm;
 
+  // systematics: names of the vectors of systematic names in TStore, as
+  // recorded by the calibrators/selectors (empty: nominal only). A name found
+  // in several of them (e.g. EG_* for electrons and photons) varies them together
+  TString m_inputAlgoJets;
+  TString m_inputAlgoElectrons;
+  TString m_inputAlgoPhotons;
+  TString m_inputAlgoTaus;
+  TString m_inputAlgoMuons;
+  // name of the vector of the MET systematics in TStore (default: <OutputContainer>_Syst)
+  TString m_outputAlgo;
+  // only rebuild the terms whose input objects changed, copying the others from nominal
+  bool    m_doIncrementalMET;
+
 private:
 
   // tools
   met::METMaker* m_metmaker; //!
   TauAnalysisTools::TauSelectionTool* m_tauSelTool; //!
 
+  // an electron/photon/tau/muon term, in the order they are rebuilt
+  struct ObjectTerm {
+    std::string               m_name;         // name of the MET term
+    xAOD::Type::ObjectType    m_type;
+    std::string               m_container;    // input container (+ systematic name)
+    std::string               m_inputAlgo;    // vector of systematic names in TStore
+    std::vector<size_t>       m_nomInputs;    // index() of the objects given to METMaker in nominal
+    std::vector<size_t>       m_nomSelected;  // index() of the objects kept by METMaker in nominal
+    ConstDataVector<xAOD::IParticleContainer>* m_nomObjects; // nominal objects passing the MET cuts, for this event
+  };
+  std::vector<ObjectTerm> m_objectTerms; //!
+  // a systematic name, with the inputs it varies: the jets, and the object terms (indices in m_objectTerms)
+  struct Variation {
+    std::string               m_name;
+    bool                      m_jets = false;
+    std::vector<unsigned int> m_terms;
+  };
+  std::vector<std::string> m_jetTermNames; //!
+
+  // resolved once per event, shared by all the systematic rebuilds
+  const xAOD::MissingETAssociationMap* m_metMap;  //!
+  const xAOD::MissingETContainer*      m_coreMet; //!
+  const xAOD::JetContainer*            m_nomJets; //!
+
+  // create and record an output container for a systematic
+  EL::StatusCode recordOutput( const std::string& systName, xAOD::MissingETContainer*& newMet );
+  // objects of a term passing the MET cuts
+  EL::StatusCode getMETObjects( const ObjectTerm& term, const std::string& systName, ConstDataVector<xAOD::IParticleContainer>& metObjects );
+  // rebuild all the object terms, with the terms in varied taken from systName
+  EL::StatusCode rebuildObjectTerms( xAOD::MissingETContainer* newMet, const std::vector<unsigned int>& varied, const std::string& systName, bool isNominal );
+  EL::StatusCode rebuildJetTerms( xAOD::MissingETContainer* newMet, const std::string& systName );
+  EL::StatusCode buildMETSums( xAOD::MissingETContainer* newMet );
+  EL::StatusCode copyTerm( const xAOD::MissingETContainer* from, xAOD::MissingETContainer* to, const std::string& name );
+  bool acceptPhoton( const xAOD::Photon* ph );
+  bool acceptTau( const xAOD::TauJet* tau );
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
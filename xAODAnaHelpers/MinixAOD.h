@@ -4,6 +4,10 @@
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
+// c++ include(s):
+#include <map>
+#include <set>
+
 //MetaData
 #include "xAODMetaDataCnv/FileMetaDataTool.h"
 #include "xAODTriggerCnv/TriggerMenuMetaDataTool.h"
@@ -34,6 +38,8 @@
 
     The trickiest case is with shallow copies because those could be our systematics -- and you might want to copy the original container, and only copy over systematics via true shallow copies to conserve memory and space.
 
+    .. note:: The keys are turned into an output plan at the first event: the type of each container is resolved once, and later events only execute the plan. The vectors of :cpp:member:`MinixAOD::m_vectorCopyKeys` are read every event, as their contents can change (e.g. only the systematics passing a selection), but the type of each of their containers is also resolved only the first time it is seen.
+
   @endrst
 
  */
@@ -122,10 +128,28 @@ public:
 
       Always specify your string in a space-delimited format where pairs are split up by ``input container name|output container name``.
 
+      .. note:: With :cpp:member:`MinixAOD::m_linkViews`, a view whose elements all belong to a container which is itself written to the output is not deep-copied.
+
     @endrst
    */
   std::string m_deepCopyKeys;
 
+  /**
+    @brief write the views of :cpp:member:`MinixAOD::m_deepCopyKeys` as links into their parent, when possible
+
+    @rst
+
+      At the first event, if all the elements of a view belong to one container which is written to the output (simple copy, TStore copy, shallow copy or systematic),
+      the view is written as a ``std::vector<ElementLink<xAOD::IParticleContainer>>`` (with the output container name) pointing into that parent, instead of a deep copy.
+      The decision is kept for the whole job. The elements of a later event which come from another container are deep-copied instead, into ``<output container name>Copy``
+      (written every event, empty when all the elements belong to the parent), and their links point there. Views of ``MissingET`` are always deep-copied.
+
+      Off by default: the output of a view is then a vector of links instead of a container.
+
+    @endrst
+   */
+  bool m_linkViews;
+
   /**
     @brief names of vectors that have container names for its contents
 
@@ -140,6 +164,40 @@ public:
    */
   std::string m_vectorCopyKeys;
 
+  /**
+    @brief aux variables to keep or drop, per output container
+
+    @rst
+
+      Given to :code:`TEvent::setAuxItemList()` for the aux container of each listed container. Variables are dot-separated, and a leading ``-`` drops a variable while keeping all the others::
+
+          "m_auxItemLists": "AntiKt4EMTopoJets|pt.eta.phi.m.JvtJvfcorr Muons|-ptcone20.-ptcone30"
+
+      Always specify your string in a space-delimited format where pairs are split up by ``container name|item list``.
+
+      .. note:: Only the dynamic aux variables can be slimmed. The static variables of deep-copied containers are always written.
+
+    @endrst
+   */
+  std::string m_auxItemLists;
+
+  /**
+    @brief write the shallow copies as deltas with respect to their parent
+
+    @rst
+
+      The aux store of each shallow-copied container (:cpp:member:`MinixAOD::m_shallowCopyKeys`, :cpp:member:`MinixAOD::m_vectorCopyKeys`) is switched to ``shallowIO``,
+      and only the variables of :cpp:member:`MinixAOD::m_shallowDeltaVars` are written for it (unless it has its own entry in :cpp:member:`MinixAOD::m_auxItemLists`).
+      All the other variables are read back from the parent container, which must be written as well: give it as the parent in the keys.
+      The size of the output then grows with the number of varied variables, instead of the full containers, for each systematic.
+
+    @endrst
+   */
+  bool m_shallowDelta;
+
+  /// variables written for each shallow copy in :cpp:member:`MinixAOD::m_shallowDelta` mode
+  std::string m_shallowDeltaVars;
+
 private:
   /// A vector of containers that are in TEvent that just need to be written to the output
   std::vector<std::string> m_simpleCopyKeys_vec; //!
@@ -149,10 +207,52 @@ private:
   std::vector<std::pair<std::string, std::string>> m_deepCopyKeys_vec; //!
   /// A vector of (name of vector of container names, parent name) pairs for shallow-copied objects (like systematics) -- if parent is empty, deep-copy it
   std::vector<std::pair<std::string, std::string>> m_vectorCopyKeys_vec; //!
+  /// A map of container name to aux item list
+  std::map<std::string, std::string> m_auxItemLists_map; //!
 
   /// A vector of containers (and aux-pairs) in TStore to record in TEvent
   std::vector<std::string> m_copyFromStoreToEventKeys_vec; //!
 
+  /// Types of containers which can be deep-copied and recorded
+  enum ContainerType { ELECTRONS, JETS, MET, MUONS, PHOTONS, TAUS };
+
+  /// One step of the output plan, with everything execute() needs already resolved
+  struct CopyItem {
+    std::string   m_inKey;     // container to deep-copy (deep copies only)
+    std::string   m_key;       // container to copy/record
+    std::string   m_auxKey;    // its aux container
+    ContainerType m_type;
+    bool          m_shallow;   // the aux container is a ShallowAuxContainer
+    std::string   m_linkParent;// deep copies only: if not empty, write links into this container instead
+  };
+
+  /// Output plan: copies from the input file, deep copies, then records from TStore to TEvent (duplicates removed)
+  std::vector<CopyItem> m_simpleCopyPlan; //!
+  std::vector<CopyItem> m_deepCopyPlan;   //!
+  std::vector<CopyItem> m_recordPlan;     //!
+  bool m_planReady;                       //!
+  /// The keys of m_recordPlan, which are not recorded again from the vectors of container names
+  std::set<std::string> m_recordPlanKeys; //!
+  /// The containers of the vectors of container names, resolved the first time they are seen
+  std::map<std::string, CopyItem> m_vectorCopyItems; //!
+  /// The containers of the vectors of container names to record in this event
+  std::vector<const CopyItem*> m_eventVectorItems;   //!
+
+  /// Build the output plan, at the first event: the container types are resolved once
+  EL::StatusCode buildPlan ();
+  /// Read the vectors of container names of this event, into m_eventVectorItems
+  EL::StatusCode collectVectorItems ();
+  /// Record a container from TStore to TEvent, with the type found when it was first seen
+  EL::StatusCode recordItem (const CopyItem& item);
+  /// Type of a container in TStore
+  EL::StatusCode getContainerType (const std::string& key, ContainerType& type);
+  /// Set the aux item list of an output container, if any
+  void setAuxItemList (const CopyItem& item);
+  /// Find the container written to the output which all the elements of a view belong to. Empty if none
+  std::string findViewParent (const CopyItem& item);
+  /// Write a view as links into its parent
+  EL::StatusCode recordViewLinks (const CopyItem& item);
+
   /// Pointer for the File MetaData Tool
   xAODMaker::FileMetaDataTool          *m_fileMetaDataTool;    //!
   /// Pointer for the TriggerMenu MetaData Tool
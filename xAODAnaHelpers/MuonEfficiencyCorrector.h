@@ -17,6 +17,8 @@
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
+class ScaleFactorCache;
+
 class MuonEfficiencyCorrector : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -54,6 +56,16 @@ public:
   std::string   m_outputSystNamesIso;
   std::string   m_outputSystNamesTrig;
 
+  // write the per-object SFs in a single ScaleFactorTable per SF type in TStore ('<OutputSystNames>_Table'), instead of a vector<float> decoration per object
+  bool          m_writeSFTable;
+
+  // SF memoization (see ScaleFactorCache) - reco and iso SFs only
+  bool          m_useSFCache;       // cache the SF of each (systematic, bin) pair, instead of calling the tools' getEfficiencyScaleFactor() for every muon
+  int           m_SFCacheSize;      // max number of cached SFs per tool
+  std::string   m_SFCachePtBins;    // comma-separated pT bin edges (GeV) - must include all the edges of the SF maps. Required
+  std::string   m_SFCacheEtaBins;   // comma-separated eta bin edges - must include all the edges of the SF maps. Required
+  std::string   m_SFCachePhiBins;   // comma-separated phi bin edges - must include all the edges of the SF maps. Required
+
 private:
 
   xAOD::TEvent *m_event;  //!
@@ -74,6 +86,9 @@ private:
   CP::MuonTriggerScaleFactors     *m_asgMuonEffCorrTool_muSF_Trig ;    //!
   CP::PileupReweightingTool       *m_pileuptool;                       //!
 
+  ScaleFactorCache                *m_SFCacheReco;                      //!
+  ScaleFactorCache                *m_SFCacheIso;                       //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -103,6 +118,12 @@ public:
 
   virtual EL::StatusCode executeSF (  const xAOD::MuonContainer* inputMuons, const xAOD::EventInfo* eventInfo, unsigned int countSyst  );
 
+private:
+  CP::CorrectionCode getCachedSF ( CP::MuonEfficiencyScaleFactors* tool, ScaleFactorCache* cache, const CP::SystematicSet& syst,
+                                   const xAOD::Muon* mu, unsigned int runNumber, float& sf );
+
+public:
+
   /// @cond
   // this is needed to distribute the algorithm to the workers
   ClassDef(MuonEfficiencyCorrector, 1);
@@ -20,6 +20,8 @@ namespace Trig {
   class TrigMuonMatching;
 }
 
+class TrigMatchingEngine;
+
 class MuonSelector : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -58,6 +60,7 @@ public:
   std::string    m_TrackIsoEff;              /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
   std::string    m_CaloBasedIsoType;         /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
   std::string    m_TrackBasedIsoType;        /* to define a custom WP - make sure "UserDefined" is added in the above input list! */
+  bool           m_singlePassIso;            /* decorate w/ the decisions of all the WPs packed in a single 'isIsolatedBits' word, instead of one 'isIsolated_*' flag per WP */
 
   /* trigger matching */
   std::string    m_singleMuTrigChains;       /* A comma-separated string w/ alll the HLT single muon trigger chains for which you want to perform the matching.
@@ -65,6 +68,7 @@ public:
   std::string    m_diMuTrigChains;           /* A comma-separated string w/ alll the HLT dimuon trigger chains for which you want to perform the matching.
   					     	If left empty (as it is by default), no trigger matching will be attempted at all */
   float          m_minDeltaR;
+  bool           m_useTrigMatchingEngine;    /* match single muon chains w/ TrigMatchingEngine (features fetched once per event) instead of TrigMuonMatching */
 
   std::string    m_passAuxDecorKeys;
   std::string    m_failAuxDecorKeys;
@@ -99,6 +103,9 @@ private:
   int   m_mu_cutflow_iso_cut;		    //!
 
   std::vector<std::string> m_IsoKeys;       //!
+  std::vector<unsigned int> m_IsoCutPositions; //!  /* position of each WP in the TAccept returned by the isolation tool */
+  std::vector<int>          m_IsoBits;         //!  /* bit of each WP in the 'isIsolatedBits' decoration (-1: not packable) */
+  unsigned int              m_MinIsoCutPosition; //!
 
   /* other private members */
 
@@ -112,6 +119,7 @@ private:
 
   Trig::TrigDecisionTool*        m_trigDecTool;	            //!
   Trig::TrigMuonMatching*        m_trigMuonMatchTool;       //!
+  TrigMatchingEngine*            m_trigMuonMatchEngine;     //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
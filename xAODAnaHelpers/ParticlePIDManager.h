@@ -23,6 +23,8 @@
 
 // C++ include(s)
 #include <string>
+#include <vector>
+#include <algorithm>
 
 class ElectronLHPIDManager
 {
@@ -99,8 +101,17 @@ class ElectronLHPIDManager
 
 	      /* copy map element into container of valid WPs for later usage */
 	      m_validWPTools.insert( it );
+	      m_orderedValidWPTools.push_back( it );
 
           }
+
+	  /* keep the valid tools sorted by tightness (0: loosest WP), as needed by evaluateWPs() */
+	  std::sort( m_orderedValidWPTools.begin(), m_orderedValidWPTools.end(),
+	             [](const std::pair<std::string, AsgElectronLikelihoodTool*>& a, const std::pair<std::string, AsgElectronLikelihoodTool*>& b) {
+	               HelperClasses::EnumParser<LikeEnum::Menu> parser;
+	               return static_cast<unsigned int>( parser.parseEnum(a.first) ) < static_cast<unsigned int>( parser.parseEnum(b.first) );
+	             } );
+
 	} else {
 
 	  for ( auto it : (m_allWPs) ) {
@@ -133,6 +144,45 @@ class ElectronLHPIDManager
        return StatusCode::SUCCESS;
      }
 
+     /*
+     / Single-pass evaluation of all the valid WPs: decorate the electron with the decision for each of them,
+     / and return a bitmask where bit i is set if the electron passes the i-th valid WP (0: loosest WP).
+     /
+     / The LH WPs are nested (each WP is a subset of the looser ones), so the tools are called from the loosest
+     / to the tightest WP, and the loop stops at the first failing WP: all the tighter WPs are set to fail w/o
+     / recomputing the likelihood. Electron candidates failing the loosest valid WP cost a single tool call.
+     /
+     / Call setDecorations() first, so that the WPs looser than the selected one get the default value.
+     */
+     unsigned int evaluateWPs( const xAOD::Electron* electron ) {
+
+       unsigned int passMask(0);
+       bool         passPrevious(true);
+
+       for ( unsigned int idx(0); idx < m_orderedValidWPTools.size(); ++idx ) {
+
+         const std::string decorWP =  "LH" + m_orderedValidWPTools.at(idx).first;
+
+         bool passThis = passPrevious && static_cast<bool>( m_orderedValidWPTools.at(idx).second->accept( *electron ) );
+         if ( passThis ) { passMask |= ( 1 << idx ); }
+         passPrevious = passThis;
+
+         if ( m_debug ) { Info("evaluateWPs()", "\t does electron pass %s ? %i ", decorWP.c_str(), static_cast<int>(passThis) ); }
+
+         electron->auxdecor<char>(decorWP) = static_cast<char>( passThis );
+       }
+
+       return passMask;
+     }
+
+     /* returns the position of a WP in the bitmask returned by evaluateWPs() (-1 if not a valid WP) */
+     int getValidWPIndex( const std::string& WP ) {
+       for ( unsigned int idx(0); idx < m_orderedValidWPTools.size(); ++idx ) {
+         if ( m_orderedValidWPTools.at(idx).first == WP ) { return static_cast<int>(idx); }
+       }
+       return -1;
+     }
+
      const std::string getSelectedWP ( ) { return m_selectedWP; }
 
      /* returns a map containing all the tools */
@@ -150,6 +200,7 @@ class ElectronLHPIDManager
      bool        m_debug;
      std::multimap<std::string, AsgElectronLikelihoodTool*> m_allWPTools;
      std::multimap<std::string, AsgElectronLikelihoodTool*> m_validWPTools;
+     std::vector< std::pair<std::string, AsgElectronLikelihoodTool*> > m_orderedValidWPTools; /* same as above, sorted by tightness */
      std::set<std::string> m_allWPs;
      std::set<std::string> m_validWPs;
 
@@ -248,9 +299,17 @@ class ElectronCutBasedPIDManager
 
 	      /* copy map element into container of valid tools for later usage */
 	      m_validWPTools.insert( it );
+	      m_orderedValidWPTools.push_back( it );
 
           }
 
+	  /* keep the valid tools sorted by tightness (0: loosest WP), as needed by evaluateWPs() */
+	  std::sort( m_orderedValidWPTools.begin(), m_orderedValidWPTools.end(),
+	             [](const std::pair<std::string, AsgElectronIsEMSelector*>& a, const std::pair<std::string, AsgElectronIsEMSelector*>& b) {
+	               HelperClasses::EnumParser<egammaPID::PID> parser;
+	               return static_cast<unsigned int>( parser.parseEnum(a.first) ) < static_cast<unsigned int>( parser.parseEnum(b.first) );
+	             } );
+
 	} else {
 
 	  for ( auto it : (m_allWPs) ) {
@@ -285,6 +344,46 @@ class ElectronCutBasedPIDManager
 
      }
 
+     /*
+     / Single-pass evaluation of all the valid WPs: decorate the electron with the decision for each of them,
+     / and return a bitmask where bit i is set if the electron passes the i-th valid WP (0: loosest WP).
+     /
+     / The isEM menus are nested (the tighter menus add cuts on top of the looser ones), so the isEM word is
+     / evaluated from the loosest to the tightest WP, and the loop stops at the first failing WP: all the tighter
+     / WPs are set to fail w/o re-running the selector.
+     /
+     / Call setDecorations() first, so that the WPs looser than the selected one get the default value.
+     */
+     unsigned int evaluateWPs( const xAOD::Electron* electron ) {
+
+       unsigned int passMask(0);
+       bool         passPrevious(true);
+
+       for ( unsigned int idx(0); idx < m_orderedValidWPTools.size(); ++idx ) {
+
+         std::string decorWP = m_orderedValidWPTools.at(idx).first;
+         decorWP.erase(0,4);
+
+         bool passThis = passPrevious && static_cast<bool>( m_orderedValidWPTools.at(idx).second->accept( *electron ) );
+         if ( passThis ) { passMask |= ( 1 << idx ); }
+         passPrevious = passThis;
+
+         if ( m_debug ) { Info("evaluateWPs()", "\t does electron pass %s ? %i ", decorWP.c_str(), static_cast<int>(passThis) ); }
+
+         electron->auxdecor<char>(decorWP) = static_cast<char>( passThis );
+       }
+
+       return passMask;
+     }
+
+     /* returns the position of a WP in the bitmask returned by evaluateWPs() (-1 if not a valid WP) */
+     int getValidWPIndex( const std::string& WP ) {
+       for ( unsigned int idx(0); idx < m_orderedValidWPTools.size(); ++idx ) {
+         if ( m_orderedValidWPTools.at(idx).first == WP ) { return static_cast<int>(idx); }
+       }
+       return -1;
+     }
+
      const std::string getSelectedWP ( ) { return m_selectedWP; }
 
      /* returns a map containing all the tools */
@@ -303,6 +402,7 @@ class ElectronCutBasedPIDManager
 
      std::multimap<std::string, AsgElectronIsEMSelector*> m_allWPTools;
      std::multimap<std::string, AsgElectronIsEMSelector*> m_validWPTools;
+     std::vector< std::pair<std::string, AsgElectronIsEMSelector*> > m_orderedValidWPTools; /* same as above, sorted by tightness */
      std::set<std::string> m_allWPs;
      std::set<std::string> m_validWPs;
 
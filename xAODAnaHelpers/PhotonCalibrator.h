@@ -49,6 +49,9 @@ public:
   std::string m_esModel;
   std::string m_decorrelationModel;
 
+  // evaluate the Loose/Medium/Tight photon ID from the loosest, stopping at the first failing menu
+  bool        m_singlePassPID;
+
 private:
   int m_numEvent;         //!
   int m_numObject;        //!
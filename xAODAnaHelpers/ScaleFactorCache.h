@@ -0,0 +1,97 @@
+#ifndef xAODAnaHelpers_ScaleFactorCache_H
+#define xAODAnaHelpers_ScaleFactorCache_H
+
+/** @file ScaleFactorCache.h
+ *  @brief Bounded LRU cache of binned scale factors, per systematic
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// C++ include(s)
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+    @brief Memoize the scale factors returned by a CP efficiency tool
+    @rst
+        Efficiency scale factors are read from binned maps, so the tools return the very same value for all the objects falling in the same bin.
+        This class caches the SF for each (systematic, bin) pair, so that the CP tool needs to be called only once per bin and systematic.
+
+        The bin of an object is defined by the edges given in the constructor for :math:`p_{T}` (in GeV), :math:`\eta` and :math:`\phi`, plus an optional integer label (e.g., the jet flavour) and the run number.
+        If no edges are given for a coordinate, the exact value is used in the key instead: the cache is then only hit by objects with identical kinematics, i.e. practically never.
+        The efficiency correctors therefore require the edges of all the coordinates their SF maps depend on.
+
+        .. warning:: The cache returns the same SF for all the objects in the same bin: the edges must be (a superset of) the edges of the SF map(s) used by the tool.
+
+        The cache is bounded: when it is full, the least recently used entry is dropped.
+
+    @endrst
+ */
+class ScaleFactorCache
+{
+
+  public:
+
+    /* (systematic hash, pT bin, eta bin, phi bin, label, run number) */
+    typedef std::tuple<std::size_t, int64_t, int64_t, int64_t, int, unsigned int> Key;
+
+    /**
+        @param name       Name used in the printout of the statistics
+        @param maxSize    Maximum number of entries in the cache
+        @param ptBins     Comma-separated list of the :math:`p_{T}` bin edges (GeV). Empty: use exact values
+        @param etaBins    Comma-separated list of the :math:`\eta` bin edges. Empty: use exact values
+        @param phiBins    Comma-separated list of the :math:`\phi` bin edges. Empty: use exact values
+    */
+    ScaleFactorCache( const std::string& name, unsigned int maxSize,
+                      const std::string& ptBins = "", const std::string& etaBins = "", const std::string& phiBins = "" );
+    ~ScaleFactorCache();
+
+    /** @brief Build the key for an object (:math:`p_{T}` in MeV, as in the EDM). Use ``CP::SystematicSet::hash()`` to identify the systematic */
+    Key makeKey( std::size_t systHash, float pt, float eta, float phi = 0.0, int label = 0, unsigned int runNumber = 0 ) const;
+
+    /** @brief Retrieve a cached SF. Returns false (and counts a miss) if the key is not in the cache */
+    bool get( const Key& key, float& sf );
+
+    /** @brief Store a SF in the cache, dropping the least recently used entry if needed */
+    void put( const Key& key, float sf );
+
+    /** @brief Remove all the entries (the statistics are kept) */
+    void clear();
+
+    unsigned long long getHits()   const { return m_hits; }
+    unsigned long long getMisses() const { return m_misses; }
+    /** @brief Fraction of the get() calls which found the key in the cache */
+    float getHitRate() const;
+
+    /** @brief Print the cache statistics */
+    void printStats() const;
+
+  private:
+
+    /* bin index if edges are defined, raw bits of the value otherwise */
+    int64_t getBin( const std::vector<float>& edges, float value ) const;
+    std::vector<float> parseEdges( const std::string& edges ) const;
+
+    std::string          m_name;
+    unsigned int         m_maxSize;
+
+    std::vector<float>   m_ptBins;
+    std::vector<float>   m_etaBins;
+    std::vector<float>   m_phiBins;
+
+    /* most recently used entries at the front */
+    std::list< std::pair<Key, float> >                                   m_entries;
+    std::map< Key, std::list< std::pair<Key, float> >::iterator >        m_index;
+
+    unsigned long long   m_hits;
+    unsigned long long   m_misses;
+
+};
+
+#endif
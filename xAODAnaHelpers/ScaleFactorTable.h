@@ -0,0 +1,74 @@
+#ifndef xAODAnaHelpers_ScaleFactorTable_H
+#define xAODAnaHelpers_ScaleFactorTable_H
+
+/** @file ScaleFactorTable.h
+ *  @brief Contiguous objects-by-systematics table of scale factors
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// EDM include(s):
+#include "xAODBase/IParticleContainer.h"
+#include "AthContainers/AuxElement.h"
+
+// C++ include(s)
+#include <vector>
+
+/**
+    @brief Store the SFs of all the objects of a container, for all the systematics, in a single block of memory
+    @rst
+        The efficiency correctors can record one of these tables per SF type in ``TStore`` (with the name ``<OutputSystNames>_Table``), instead of decorating each object with a ``std::vector<float>``.
+        The rows of the table are the objects, indexed by their position (``index()``) in the container they belong to, and the columns are the systematics,
+        in the same order as the ``std::vector<std::string>`` of systematic names recorded by the corrector.
+        The table also holds the event-level SF for each systematic (i.e., the product of the SFs of all the objects).
+
+        .. note:: For views (``SG::VIEW_ELEMENTS``), ``index()`` is the position in the original container, so the table can be read back from any view of the same objects.
+
+    @endrst
+ */
+class ScaleFactorTable
+{
+
+  public:
+
+    ScaleFactorTable();
+    /**
+        @param objects    The objects to be tabulated. They must all belong to the same container
+        @param nSysts     Number of systematics (columns)
+        @param defaultSF  Value of the SF for the objects which are not set explicitly
+    */
+    ScaleFactorTable( const xAOD::IParticleContainer* objects, unsigned int nSysts, float defaultSF = -999.0 );
+    ~ScaleFactorTable();
+
+    /** @brief Set the SF of an object for a given systematic. Returns false if the object does not belong to this table */
+    bool set( const SG::AuxElement& obj, unsigned int systIdx, float sf );
+    /** @brief Set the event-level SF for a given systematic */
+    void setGlobal( unsigned int systIdx, float sf );
+
+    /** @brief Pointer to the SFs of an object (one per systematic), or ``nullptr`` if the object is not in the table */
+    const float* getRow( const SG::AuxElement& obj ) const;
+    /** @brief SF of an object for a given systematic, or the default value if the object is not in the table */
+    float get( const SG::AuxElement& obj, unsigned int systIdx ) const;
+    /** @brief Event-level SFs, one per systematic */
+    const std::vector<float>& getGlobal() const { return m_global; }
+
+    unsigned int getNSysts() const { return m_nSysts; }
+    unsigned int getNRows()  const { return m_nRows; }
+
+  private:
+
+    /* the container the tabulated objects belong to */
+    const SG::AuxVectorData*  m_container;
+
+    unsigned int              m_nRows;
+    unsigned int              m_nSysts;
+    float                     m_defaultSF;
+
+    /* row-major: m_sfs[row * m_nSysts + systIdx] */
+    std::vector<float>        m_sfs;
+    std::vector<char>         m_filled;
+    std::vector<float>        m_global;
+
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_TrackHistsAlgo_H
 
 #include <xAODAnaHelpers/TrackHists.h>
+#include <xAODAnaHelpers/EventSkim.h>
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
@@ -15,9 +16,14 @@ public:
 
   // configuration variables
   std::string m_detailStr;
+  std::string m_eventWeightName;    // EventInfo vector of weights from EventWeightBuilder: the nominal one is used. Empty: use mcEventWeight
+  std::string m_skimPredicate;      // only fill the events passing this predicate (see EventSkim)
+  bool        m_fillWeightSysts;    // also fill one copy of the histograms per weight systematic in m_eventWeightName (see HistogramManager::setWeightChannels)
 
 private:
+  std::vector<std::string> m_weightChannels; //!
   TrackHists* m_plots; //!
+  EventSkim* m_skim; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
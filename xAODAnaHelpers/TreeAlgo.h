@@ -4,6 +4,7 @@
 #include "TTree.h"
 
 #include <xAODAnaHelpers/HelpTreeBase.h>
+#include <xAODAnaHelpers/EventSkim.h>
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
@@ -37,10 +38,50 @@ public:
   std::string m_METContainerName;
   std::string m_photonContainerName;
 
+  // systematics: names of the vectors of systematic names in TStore. Each variation of the
+  // <ContainerName><syst> containers is written to a friend tree <name>_<object>_<syst> (object: jet, muon,
+  // electron or photon), which only holds the branches of that object and the event identifiers (indexed by
+  // runNumber and eventNumber). A name shared by several objects (e.g. EG_* for electrons and photons) gives
+  // one friend tree per object
+  std::string m_jetSystsVec;
+  std::string m_muSystsVec;
+  std::string m_elSystsVec;
+  std::string m_photonSystsVec;
+
   bool m_DC14;
 
+  // name of the vector of event weights filled into weight_event (see EventWeightBuilder)
+  std::string m_eventWeightsName;
+
+  // fill the tree in a background thread (see HelpTreeBase::EnableAsyncWrite). Turned off if any *SystsVec is set:
+  // the friend trees are in the same file, so they would have to wait for the writer right after every Fill()
+  bool m_asyncWrite;
+
+  // only fill the events passing this predicate (see EventSkim)
+  std::string m_skimPredicate;
+
+  // I/O profile of the output: "" (ROOT defaults), "fast-write" (LZ4 from ROOT 6.10, ZLIB before, large baskets) or "small-output" (ZSTD from ROOT 6.20, LZMA before, optimised baskets)
+  std::string m_ioProfile;
+  // number of events after which the baskets and the auto-flush are tuned to the actual entry sizes
+  int m_ioWarmUpEvents;
+  // override the compression of the profile (100*algorithm + level, -1: profile default)
+  int m_compressionSettings;
+  // override the initial basket size of the profile, in bytes (0: profile default)
+  int m_basketSize;
+
 private:
   HelpTreeBase* m_helpTree;            //!
+  EventSkim*    m_skim;                //!
+  TTree*        m_outTree;             //!
+  int           m_nFilled;             //!
+
+  // tune the baskets and the auto-flush of the output tree according to the I/O profile
+  void optimizeOutputTree();
+
+  // friend trees of the systematic variations, by (object, systematic name), created when a variation is first seen
+  std::map< std::pair<std::string, std::string>, HelpTreeBase* > m_friendHelpTrees; //!
+  std::map< std::pair<std::string, std::string>, TTree* >        m_friendTrees;     //!
+  HelpTreeBase* getFriendTree( const std::string& systName, const std::string& objectName );
 
 public:
 
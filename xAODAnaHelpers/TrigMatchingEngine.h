@@ -0,0 +1,106 @@
+#ifndef xAODAnaHelpers_TrigMatchingEngine_H
+#define xAODAnaHelpers_TrigMatchingEngine_H
+
+/** @file TrigMatchingEngine.h
+ *  @brief Batched HLT trigger matching of offline objects against a list of chains
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+// EDM include(s):
+#include "xAODBase/IParticle.h"
+#include "xAODEventInfo/EventInfo.h"
+#include "AthContainers/AuxElement.h"
+
+#include "AsgTools/StatusCode.h"
+
+// C++ include(s)
+#include <string>
+#include <vector>
+
+namespace Trig {
+  class TrigDecisionTool;
+}
+
+/**
+    @brief Match all the offline objects of an event against all the chains of a list in one pass.
+    @rst
+        The CP matching tools (``TrigMuonMatching``, ``TrigEgammaMatchingTool``) re-fetch the HLT features from the TDT for every (object, chain) pair.
+        Here instead:
+
+          - the features of all the chains are fetched only once per event (:cpp:func:`TrigMatchingEngine::fetchFeatures`), skipping the chains which did not fire,
+          - they are kept in a single list sorted in :math:`\eta`, which is used as a spatial index,
+          - every offline object is matched against all the chains at once, looking only at the features in the :math:`\eta` window :math:`[\eta-\Delta R, \eta+\Delta R]`.
+
+        Each object is decorated with its row of the object-by-chain match matrix, a ``std::vector<char>`` with one entry per chain (same order as :cpp:func:`TrigMatchingEngine::getChains`).
+        The list of chains is decorated once per event on the ``EventInfo``, with the name ``<decorName>Chains``.
+
+    @endrst
+ */
+class TrigMatchingEngine
+{
+
+  public:
+
+    /** @brief Type of the HLT features to match against */
+    enum class FeatureType {
+      Muon,
+      Electron
+    };
+
+    /**
+        @param trigDecTool   The TrigDecisionTool (not owned)
+        @param type          Type of the HLT features to retrieve for each chain
+        @param chains        List of HLT chains to match against
+        @param decorName     Name of the ``std::vector<char>`` decoration with the match results
+        @param dRMax         Maximum :math:`\Delta R` between the offline object and the HLT feature
+        @param debug         Print out debug information
+    */
+    TrigMatchingEngine( Trig::TrigDecisionTool* trigDecTool, FeatureType type, const std::vector<std::string>& chains,
+                        const std::string& decorName, float dRMax, bool debug = false );
+    ~TrigMatchingEngine();
+
+    /** @brief Fetch the HLT features of all the chains. Does nothing if already done for this event. */
+    StatusCode fetchFeatures( const xAOD::EventInfo* eventInfo );
+
+    /** @brief Fill the match matrix row of a single object (one entry per chain) */
+    void matchObject( const xAOD::IParticle* particle, std::vector<char>& matchRow ) const;
+
+    /** @brief Match all the objects in a container, and decorate each of them with its match matrix row */
+    template< typename T >
+    void match( const T* objects ) {
+      for ( auto obj : *objects ) { this->matchObject( obj, m_matchDecor( *obj ) ); }
+    }
+
+    /** @brief The list of chains, in the same order as the entries of the match decoration */
+    const std::vector<std::string>& getChains() const { return m_chains; }
+
+  private:
+
+    /* an HLT feature, w/ the index of the chain it belongs to */
+    struct Feature {
+      float        eta;
+      float        phi;
+      unsigned int chainIdx;
+    };
+
+    Trig::TrigDecisionTool*   m_trigDecTool;
+    FeatureType               m_type;
+    std::vector<std::string>  m_chains;
+    float                     m_dRMax;
+    bool                      m_debug;
+
+    /* features of all the chains for the current event, sorted in eta */
+    std::vector<Feature>      m_features;
+
+    /* identify the event for which the features have been fetched */
+    bool                      m_fetched;
+    uint32_t                  m_runNumber;
+    unsigned long long        m_eventNumber;
+
+    SG::AuxElement::Decorator< std::vector<char> >         m_matchDecor;
+    SG::AuxElement::Decorator< std::vector<std::string> >  m_chainsDecor;
+
+};
+
+#endif